@@ -1,4 +1,4 @@
-#version 330 core
+#version 430 core
 
 layout (location = 0) in vec3 a_position;
 layout (location = 1) in vec3 a_normal;
@@ -9,13 +9,30 @@ out vec3 v_normal;
 out vec3 v_fragPos;
 out vec4 v_color;
 
-uniform mat4 u_model;
-uniform mat4 u_view;
-uniform mat4 u_projection;
+// Per-object data of the frame, written by the render device (see ObjectData)
+layout (location = 8) in uint a_objectIndex;
+
+struct ObjectData {
+    mat4 model;
+    mat4 normal;
+};
+layout(std430, binding = 0) readonly buffer Objects
+{
+    ObjectData u_objects[];
+};
+layout(std140) uniform FrameData
+{
+    mat4 u_view;
+    mat4 u_projection;
+    mat4 u_viewProjection;
+    vec4 u_time;    // x = seconds since start, y = delta time
+};
 
 void main() {
-    v_fragPos = vec3(u_model * vec4(a_position, 1.0));
-    v_normal = mat3(transpose(inverse(u_model))) * a_normal;
+    ObjectData object = u_objects[a_objectIndex];
+    
+    v_fragPos = vec3(object.model * vec4(a_position, 1.0));
+    v_normal = mat3(object.normal) * a_normal;
     v_color = a_color;
     
     gl_Position = u_projection * u_view * vec4(v_fragPos, 1.0);
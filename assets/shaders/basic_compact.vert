@@ -0,0 +1,53 @@
+#version 430 core
+
+// Pairs with VertexCompression::OctahedralNormals (and optionally QuantizedPositions)
+layout (location = 0) in vec3 a_position; // float, or unorm16 inside the mesh bounds
+layout (location = 1) in vec2 a_normal;   // octahedral, snorm16
+layout (location = 2) in vec2 a_uv;
+layout (location = 3) in vec4 a_color;
+
+out vec3 v_normal;
+out vec3 v_fragPos;
+out vec4 v_color;
+
+// Per-object data of the frame, written by the render device (see ObjectData)
+layout (location = 8) in uint a_objectIndex;
+
+struct ObjectData {
+    mat4 model;
+    mat4 normal;
+};
+layout(std430, binding = 0) readonly buffer Objects
+{
+    ObjectData u_objects[];
+};
+layout(std140) uniform FrameData
+{
+    mat4 u_view;
+    mat4 u_projection;
+    mat4 u_viewProjection;
+    vec4 u_time;    // x = seconds since start, y = delta time
+};
+
+// Set per mesh by the render device: bounds size and min (1 and 0 for float positions)
+uniform vec3 u_positionScale;
+uniform vec3 u_positionOffset;
+
+vec3 DecodeOctahedral(vec2 e) {
+    vec3 n = vec3(e, 1.0 - abs(e.x) - abs(e.y));
+    float t = max(-n.z, 0.0);
+    n.x += n.x >= 0.0 ? -t : t;
+    n.y += n.y >= 0.0 ? -t : t;
+    return normalize(n);
+}
+
+void main() {
+    ObjectData object = u_objects[a_objectIndex];
+    vec3 position = u_positionOffset + a_position * u_positionScale;
+    
+    v_fragPos = vec3(object.model * vec4(position, 1.0));
+    v_normal = mat3(object.normal) * DecodeOctahedral(a_normal);
+    v_color = a_color;
+    
+    gl_Position = u_projection * u_view * vec4(v_fragPos, 1.0);
+}
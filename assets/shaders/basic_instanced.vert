@@ -0,0 +1,27 @@
+#version 330 core
+
+layout (location = 0) in vec3 a_position;
+layout (location = 1) in vec3 a_normal;
+layout (location = 2) in vec2 a_uv;
+layout (location = 3) in vec4 a_color;
+layout (location = 4) in mat4 a_model; // per-instance, occupies locations 4-7
+
+out vec3 v_normal;
+out vec3 v_fragPos;
+out vec4 v_color;
+
+layout(std140) uniform FrameData
+{
+    mat4 u_view;
+    mat4 u_projection;
+    mat4 u_viewProjection;
+    vec4 u_time;    // x = seconds since start, y = delta time
+};
+
+void main() {
+    v_fragPos = vec3(a_model * vec4(a_position, 1.0));
+    v_normal = mat3(transpose(inverse(a_model))) * a_normal;
+    v_color = a_color;
+    
+    gl_Position = u_projection * u_view * vec4(v_fragPos, 1.0);
+}
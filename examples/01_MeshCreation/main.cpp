@@ -120,14 +120,15 @@ int main() {
     // Test 5: Transform system integration
     std::cout << "--- Test 5: Transform System ---" << std::endl;
     
-    TLETC::Transform transform;
-    transform.position = TLETC::Vec3(5.0f, 10.0f, 15.0f);
-    transform.scale = TLETC::Vec3(2.0f, 2.0f, 2.0f);
+    TLETC::TransformSystem transformSystem;
+    TLETC::Transform transform(transformSystem);
+    transform.SetPosition(TLETC::Vec3(5.0f, 10.0f, 15.0f));
+    transform.SetScale(TLETC::Vec3(2.0f, 2.0f, 2.0f));
     transform.Rotate(TLETC::Vec3(0.0f, 1.0f, 0.0f), 45.0f);
     
     std::cout << "Transform:" << std::endl;
-    std::cout << "  Position: (" << transform.position.x << ", " << transform.position.y << ", " << transform.position.z << ")" << std::endl;
-    std::cout << "  Scale: (" << transform.scale.x << ", " << transform.scale.y << ", " << transform.scale.z << ")" << std::endl;
+    std::cout << "  Position: (" << transform.GetPosition().x << ", " << transform.GetPosition().y << ", " << transform.GetPosition().z << ")" << std::endl;
+    std::cout << "  Scale: (" << transform.GetScale().x << ", " << transform.GetScale().y << ", " << transform.GetScale().z << ")" << std::endl;
     
     auto forward = transform.GetForward();
     std::cout << "  Forward: (" << forward.x << ", " << forward.y << ", " << forward.z << ")" << std::endl;
@@ -88,7 +88,8 @@ int main()
     TLETC::Mat4 projection = TLETC::perspective(TLETC::radians(45.0f), window.GetAspectRatio(), 0.1f, 100.0f);
 
     // Setup transform for the cube
-    TLETC::Transform cubeTransform;
+    TLETC::TransformSystem transformSystem;
+    TLETC::Transform cubeTransform(transformSystem);
 
     // Lighting
     TLETC::Vec3 lightPos(2.0f, 2.0f, 2.0f);
@@ -120,13 +121,14 @@ int main()
         cubeTransform.Rotate(TLETC::Vec3(0.0f, 1.0f, 0.0f), TLETC::Radians(50.0f));
         cubeTransform.Rotate(TLETC::Vec3(1.0f, 0.0f, 0.0f), TLETC::Radians(30.0f));
         
+        renderer.BeginFrame();
+        
         // Clear the screen
         renderer.Clear(TLETC::Vec4(0.1f, 0.1f, 0.15f, 1.0f));
         
         // Use shader and set uniforms
         renderer.UseShader(shaderProgram);
-        renderer.SetUniformMat4(shaderProgram, "u_view", view);
-        renderer.SetUniformMat4(shaderProgram, "u_projection", projection);
+        renderer.SetFrameData(view, projection, static_cast<float>(currentTime), static_cast<float>(deltaTime));
         renderer.SetUniformVec3(shaderProgram, "u_lightPos", lightPos);
         renderer.SetUniformVec3(shaderProgram, "u_viewPos", cameraPos);
         renderer.SetUniformVec3(shaderProgram, "u_color", objectColor);
@@ -135,6 +137,7 @@ int main()
         renderer.DrawMesh(cube, cubeTransform.GetModelMatrix());
         
         // Swap buffers and poll events
+        renderer.EndFrame();
         window.SwapBuffers();
         window.PollEvents();
     }
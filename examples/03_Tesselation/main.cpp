@@ -104,7 +104,8 @@ int main()
     TLETC::Mat4 view = TLETC::lookAt(cameraPos, TLETC::Vec3(0.0f, 0.0f, 0.0f), TLETC::Vec3(0.0f, 1.0f, 0.0f));
     TLETC::Mat4 projection = TLETC::perspective(TLETC::radians(45.0f), window.GetAspectRatio(), 0.1f, 100.0f);
     
-    TLETC::Transform planeTransform;
+    TLETC::TransformSystem transformSystem;
+    TLETC::Transform planeTransform(transformSystem);
     TLETC::Vec3 lightPos(5.0f, 5.0f, 5.0f);
 
     float tessLevel = 8.0f;
@@ -142,13 +143,14 @@ int main()
         // Rotate plane slowly
         planeTransform.Rotate(TLETC::Vec3(0,1,0), TLETC::Radians(10.0f));
         
+        renderer.BeginFrame();
+        
         // Clear
         renderer.Clear(TLETC::Vec4(0.05f, 0.05f, 0.1f, 1.0f));
         
         // Use tessellation shader and set uniforms
         renderer.UseShader(shaderProgram);
-        renderer.SetUniformMat4(shaderProgram,  "u_view", view);
-        renderer.SetUniformMat4(shaderProgram,  "u_projection", projection);
+        renderer.SetFrameData(view, projection, static_cast<float>(currentTime), static_cast<float>(deltaTime));
         renderer.SetUniformFloat(shaderProgram, "u_tessLevel", tessLevel);
         renderer.SetUniformVec3(shaderProgram,  "u_lightPos", lightPos);
         renderer.SetUniformVec3(shaderProgram,  "u_viewPos", cameraPos);
@@ -158,6 +160,7 @@ int main()
         // In a real implementation, you'd want a separate DrawTessellatedMesh method
         renderer.DrawMesh(plane, planeTransform.GetModelMatrix(), TLETC::PrimitiveType::Patches);
         
+        renderer.EndFrame();
         window.SwapBuffers();
         window.PollEvents();
     }
@@ -18,8 +18,13 @@ out vec3 v_normal;
 out vec3 v_color;
 
 uniform mat4 u_model;
-uniform mat4 u_view;
-uniform mat4 u_projection;
+layout(std140) uniform FrameData
+{
+    mat4 u_view;
+    mat4 u_projection;
+    mat4 u_viewProjection;
+    vec4 u_time;
+};
 uniform vec3 u_color;
 
 void main() {
@@ -99,11 +104,13 @@ int main() {
     );
     
     // Setup transforms for 4 objects
-    TLETC::Transform transforms[4];
-    transforms[0].position = TLETC::Vec3(-2.5f, 1.0f, 0.0f);  // Top left
-    transforms[1].position = TLETC::Vec3( 2.5f, 1.0f, 0.0f);  // Top right
-    transforms[2].position = TLETC::Vec3(-2.5f, -1.0f, 0.0f); // Bottom left
-    transforms[3].position = TLETC::Vec3( 2.5f, -1.0f, 0.0f); // Bottom right
+    TLETC::TransformSystem transformSystem;
+    TLETC::Transform transforms[4] = { TLETC::Transform(transformSystem), TLETC::Transform(transformSystem),
+                                       TLETC::Transform(transformSystem), TLETC::Transform(transformSystem) };
+    transforms[0].SetPosition(TLETC::Vec3(-2.5f, 1.0f, 0.0f));  // Top left
+    transforms[1].SetPosition(TLETC::Vec3( 2.5f, 1.0f, 0.0f));  // Top right
+    transforms[2].SetPosition(TLETC::Vec3(-2.5f, -1.0f, 0.0f)); // Bottom left
+    transforms[3].SetPosition(TLETC::Vec3( 2.5f, -1.0f, 0.0f)); // Bottom right
     
     TLETC::Vec3 colors[4] = {
         TLETC::Vec3(1.0f, 0.3f, 0.3f), // Red
@@ -161,13 +168,14 @@ int main() {
             case 2: currentMesh = &torus; break;
         }
         
+        renderer.BeginFrame();
+        
         // Clear
         renderer.Clear(TLETC::Vec4(0.1f, 0.1f, 0.15f, 1.0f));
         
         // Setup shader
         renderer.UseShader(program);
-        renderer.SetUniformMat4(program, "u_view", view);
-        renderer.SetUniformMat4(program, "u_projection", projection);
+        renderer.SetFrameData(view, projection, static_cast<float>(currentTime), static_cast<float>(deltaTime));
         
         // Draw 4 objects with different primitive types
         
@@ -190,6 +198,7 @@ int main() {
         renderer.SetUniformVec3(program, "u_color", colors[3]);
         renderer.DrawMesh(*currentMesh, transforms[3].GetModelMatrix(), TLETC::PrimitiveType::Lines);
         
+        renderer.EndFrame();
         window.SwapBuffers();
         window.PollEvents();
     }
@@ -149,20 +149,21 @@ int main()
     }
     
     // Setup scene - grid of objects
+    TLETC::TransformSystem transformSystem;
     std::vector<TLETC::Transform> transforms;
     for (int x = -5; x <= 5; x += 2) 
     {
         for (int z = -5; z <= 5; z += 2) 
         {
-            TLETC::Transform t;
-            t.position = TLETC::Vec3(static_cast<float>(x), 0.5f, static_cast<float>(z));
+            TLETC::Transform t(transformSystem);
+            t.SetPosition(TLETC::Vec3(static_cast<float>(x), 0.5f, static_cast<float>(z)));
             transforms.push_back(t);
         }
     }
 
     // Ground plane
-    TLETC::Transform groundTransform;
-    groundTransform.position = TLETC::Vec3(0.0f, 0.0f, 0.0f);
+    TLETC::Transform groundTransform(transformSystem);
+    groundTransform.SetPosition(TLETC::Vec3(0.0f, 0.0f, 0.0f));
     
     // Setup camera
     FPSCamera camera;
@@ -236,6 +237,8 @@ int main()
         for (auto& transform : transforms)
             transform.Rotate(TLETC::Vec3(0.0f, 1.0f, 0.0f), 30.0f * deltaTime);
 
+        renderer.BeginFrame();
+        
         // Render
         renderer.Clear(TLETC::Vec4(0.2f, 0.3f, 0.4f, 1.0f));
         renderer.SetWireframeMode(wireframe);
@@ -243,8 +246,7 @@ int main()
         TLETC::Mat4 view = camera.GetViewMatrix();
         
         renderer.UseShader(program);
-        renderer.SetUniformMat4(program, "u_view", view);
-        renderer.SetUniformMat4(program, "u_projection", projection);
+        renderer.SetFrameData(view, projection, static_cast<float>(currentTime), deltaTime);
         renderer.SetUniformVec3(program, "u_lightPos", lightPos);
         renderer.SetUniformVec3(program, "u_viewPos", camera.position);
 
@@ -267,6 +269,7 @@ int main()
         
         renderer.SetWireframeMode(false);
         
+        renderer.EndFrame();
         window.SwapBuffers();
         window.PollEvents();
     }
@@ -70,7 +70,7 @@ public:
         // Apply physics AFTER input is read
         auto* inputHandler = GetEntity()->GetBehaviour<InputHandler>();
         if (inputHandler)
-            GetEntity()->transform.position += inputHandler->velocity * deltaTime;
+            GetEntity()->transform.Translate(inputHandler->velocity * deltaTime);
     }
     
     const char* GetName() const override { return "PhysicsMover"; }
@@ -92,12 +92,12 @@ public:
         // Update camera AFTER all movement is finalized
         if (target) 
         {
-            TLETC::Vec3 desiredPos = target->transform.position + offset;
-            GetEntity()->transform.position = TLETC::mix(
-                GetEntity()->transform.position,
+            TLETC::Vec3 desiredPos = target->transform.GetPosition() + offset;
+            GetEntity()->transform.SetPosition(TLETC::mix(
+                GetEntity()->transform.GetPosition(),
                 desiredPos,
                 smoothSpeed * deltaTime
-            );
+            ));
         }
     }
     
@@ -106,6 +106,8 @@ public:
 
 /**
  * Rotator - Simple rotation
+ * Only touches its own entity's transform, so it says so and rotators update in parallel.
+ * PhysicsMover (reads another behaviour) and CameraFollow (reads another entity) stay serial.
  */
 class Rotator : public TLETC::Behaviour 
 {
@@ -113,7 +115,11 @@ public:
     TLETC::Vec3 axis;
     float speed;
     
-    Rotator(const TLETC::Vec3& a = TLETC::Vec3(0, 1, 0), float s = 45.0f) : axis(a), speed(s) { SetActiveEvents(EventFlag::Update); }
+    Rotator(const TLETC::Vec3& a = TLETC::Vec3(0, 1, 0), float s = 45.0f) : axis(a), speed(s) 
+    { 
+        SetActiveEvents(EventFlag::Update); 
+        DeclareAccess(DataFlag::TransformData, DataFlag::TransformData);
+    }
     
     void OnUpdate(float deltaTime) override
     {
@@ -195,14 +201,14 @@ public:
         // Create player
         player = CreateEntity("Player");
         player->mesh = &cubeMesh;
-        player->transform.position = TLETC::Vec3(0, 0, 0);
+        player->transform.SetPosition(TLETC::Vec3(0, 0, 0));
         player->AddBehaviour<InputHandler>();    // Reads input in EarlyUpdate
         player->AddBehaviour<PhysicsMover>();    // Applies movement in Update
         playerLogger = player->AddBehaviour<PhaseLogger>();
         
         // Create camera entity
         camera = CreateEntity("Camera");
-        camera->transform.position = TLETC::Vec3(0, 5, 10);
+        camera->transform.SetPosition(TLETC::Vec3(0, 5, 10));
         auto* follow = camera->AddBehaviour<CameraFollow>();
         follow->target = player;
         cameraLogger = camera->AddBehaviour<PhaseLogger>();
@@ -212,7 +218,7 @@ public:
         {
             auto* entity = CreateEntity("Spinner" + std::to_string(i));
             entity->mesh = &sphereMesh;
-            entity->transform.position = TLETC::Vec3(std::cos(i * 1.2f) * 5.0f, 0, std::sin(i * 1.2f) * 5.0f);
+            entity->transform.SetPosition(TLETC::Vec3(std::cos(i * 1.2f) * 5.0f, 0, std::sin(i * 1.2f) * 5.0f));
             entity->AddBehaviour<Rotator>(TLETC::Vec3(0, 1, 0), 90.0f);
         }
         
@@ -240,22 +246,19 @@ public:
         // Setup shader
         renderer->UseShader(shaderProgram);
         
-        TLETC::Mat4 view = TLETC::lookAt(camera->transform.position, player->transform.position, TLETC::Vec3(0, 1, 0));
+        TLETC::Mat4 view = TLETC::lookAt(camera->transform.GetPosition(), player->transform.GetPosition(), TLETC::Vec3(0, 1, 0));
         
-        renderer->SetUniformMat4(shaderProgram, "u_view", view);
-        renderer->SetUniformMat4(shaderProgram, "u_projection", projection);
+        renderer->SetFrameData(view, projection, GetTime(), GetDeltaTime());
         renderer->SetUniformVec3(shaderProgram, "u_lightPos", TLETC::Vec3(5, 5, 5));
-        renderer->SetUniformVec3(shaderProgram, "u_viewPos", camera->transform.position);
+        renderer->SetUniformVec3(shaderProgram, "u_viewPos", camera->transform.GetPosition());
         
-        // Draw all entities
-        for (const auto& entity : GetEntities()) 
+        // Draw the entities in view
+        SetCullingCamera(projection * view);
+        for (TLETC::Entity* entity : GetVisibleEntities()) 
         {
-            if (entity->mesh) 
-            {
-                TLETC::Vec3 color = (entity.get() == player) ? TLETC::Vec3(0.3f, 0.5f, 1.0f) : TLETC::Vec3(1.0f, 0.3f, 0.3f);
-                renderer->SetUniformVec3(shaderProgram, "u_color", color);
-                renderer->DrawMesh(*entity->mesh, entity->transform.GetModelMatrix());
-            }
+            TLETC::Vec3 color = (entity == player) ? TLETC::Vec3(0.3f, 0.5f, 1.0f) : TLETC::Vec3(1.0f, 0.3f, 0.3f);
+            renderer->SetUniformVec3(shaderProgram, "u_color", color);
+            renderer->DrawMesh(*entity->mesh, entity->transform.GetModelMatrix());
         }
     }
     
@@ -37,12 +37,14 @@ public:
         pathProgress += speed * deltaTime;
         
         float radius = 5.0f;
-        GetEntity()->transform.position.x = std::cos(pathProgress) * radius;
-        GetEntity()->transform.position.z = std::sin(pathProgress) * radius;
+        TLETC::Vec3 position = GetEntity()->transform.GetPosition();
+        position.x = std::cos(pathProgress) * radius;
+        position.z = std::sin(pathProgress) * radius;
+        GetEntity()->transform.SetPosition(position);
         
         // Face forward along the track
         float angle = pathProgress + TLETC::HALF_PI;
-        GetEntity()->transform.rotation = TLETC::angleAxis(angle, TLETC::Vec3(0, 1, 0));
+        GetEntity()->transform.SetRotation(TLETC::angleAxis(angle, TLETC::Vec3(0, 1, 0)));
     }
     
     void OnKeyPressed(TLETC::KeyCode key) override 
@@ -73,7 +75,9 @@ public:
     {
         time += deltaTime * 3.0f;
         // Bob up and down like smoke puffing
-        GetEntity()->transform.position.y = 0.5f + std::sin(time) * 0.2f;
+        TLETC::Vec3 position = GetEntity()->transform.GetPosition();
+        position.y = 0.5f + std::sin(time) * 0.2f;
+        GetEntity()->transform.SetPosition(position);
     }
     
     const char* GetName() const override { return "Smokestack"; }
@@ -121,20 +125,20 @@ public:
             
             auto* marker = CreateEntity("Track" + std::to_string(i));
             marker->mesh = &cubeMesh;
-            marker->transform.position = TLETC::Vec3(std::cos(angle) * radius, -0.5f, std::sin(angle) * radius);
-            marker->transform.scale = TLETC::Vec3(0.5f, 0.1f, 0.5f);
+            marker->transform.SetPosition(TLETC::Vec3(std::cos(angle) * radius, -0.5f, std::sin(angle) * radius));
+            marker->transform.SetScale(TLETC::Vec3(0.5f, 0.1f, 0.5f));
         }
         
         // Create the little locomotive (engine)
         engine = CreateEntity("Locomotive");
         engine->mesh = &cubeMesh;
-        engine->transform.scale = TLETC::Vec3(0.8f, 0.6f, 1.2f);
+        engine->transform.SetScale(TLETC::Vec3(0.8f, 0.6f, 1.2f));
         engine->AddBehaviour<TrainCar>();
         
         // Add smokestack
         smokestack = CreateEntity("Smokestack");
         smokestack->mesh = &cylinderMesh;
-        smokestack->transform.scale = TLETC::Vec3(0.5f, 1.0f, 0.5f);
+        smokestack->transform.SetScale(TLETC::Vec3(0.5f, 1.0f, 0.5f));
         smokestack->AddBehaviour<Smokestack>();
         
         // Add some train cars following
@@ -142,7 +146,7 @@ public:
         {
             auto* car = CreateEntity("Car" + std::to_string(i + 1));
             car->mesh = &cubeMesh;
-            car->transform.scale = TLETC::Vec3(0.7f, 0.5f, 1.0f);
+            car->transform.SetScale(TLETC::Vec3(0.7f, 0.5f, 1.0f));
             auto* carBehaviour = car->AddBehaviour<TrainCar>();
             carBehaviour->pathProgress = -(i + 1) * 1.0f; // Stagger behind
         }
@@ -174,8 +178,10 @@ public:
         // Update smokestack position to follow engine
         if (engine && smokestack) 
         {
-            smokestack->transform.position.x = engine->transform.position.x;
-            smokestack->transform.position.z = engine->transform.position.z;
+            TLETC::Vec3 position = smokestack->transform.GetPosition();
+            position.x = engine->transform.GetPosition().x;
+            position.z = engine->transform.GetPosition().z;
+            smokestack->transform.SetPosition(position);
         }
     }
     
@@ -195,14 +201,12 @@ public:
         );
         
         renderer->UseShader(shaderProgram);
-        renderer->SetUniformMat4(shaderProgram, "u_view", view);
-        renderer->SetUniformMat4(shaderProgram, "u_projection", projection);
+        renderer->SetFrameData(view, projection, GetTime(), GetDeltaTime());
         renderer->SetUniformVec3(shaderProgram, "u_lightPos", TLETC::Vec3(10, 10, 10));
         
-        // Draw all entities with colors
-        for (const auto& entity : GetEntities()) {
-            if (!entity->mesh) continue;
-            
+        // Draw the entities in view with colors
+        SetCullingCamera(projection * view);
+        for (TLETC::Entity* entity : GetVisibleEntities()) {
             TLETC::Vec3 color;
             
             if (entity->name == "Locomotive") {
@@ -44,12 +44,14 @@ public:
         auto* throttle = GetInput();
         if (!throttle) return;
         
-        TLETC::Vec3& pos = GetEntity()->transform.position;
+        TLETC::Vec3 pos = GetEntity()->transform.GetPosition();
         
         if (throttle->IsKeyPressed(TLETC::KeyCode::W)) pos.z -= moveSpeed * deltaTime;
         if (throttle->IsKeyPressed(TLETC::KeyCode::S)) pos.z += moveSpeed * deltaTime;
         if (throttle->IsKeyPressed(TLETC::KeyCode::A)) pos.x -= moveSpeed * deltaTime;
         if (throttle->IsKeyPressed(TLETC::KeyCode::D)) pos.x += moveSpeed * deltaTime;
+        
+        GetEntity()->transform.SetPosition(pos);
     }
     
     const char* GetName() const override { return "PlayerCargo"; }
@@ -163,7 +165,7 @@ public:
         // Create the player car (entity) with cargo (behaviours)!
         TLETC::Wagon* playerCar = CreateEntity("PlayerCar");  // Using Car alias!
         playerCar->mesh = &cubeMesh;
-        playerCar->transform.position = TLETC::Vec3(0, 0, 0);
+        playerCar->transform.SetPosition(TLETC::Vec3(0, 0, 0));
         playerCar->AddBehaviour<PlayerCargo>();  // Could use AddCargo()!
         playerColorCargo = playerCar->AddBehaviour<ColorChangeCargo>();
         playerColorCargo->color = TLETC::Vec3(0.2f, 0.4f, 1.0f); // Blue
@@ -179,11 +181,11 @@ public:
             spinningCar->mesh = &sphereMesh;
             
             float angle = (i / 5.0f) * TLETC::TWO_PI;
-            spinningCar->transform.position = TLETC::Vec3(
+            spinningCar->transform.SetPosition(TLETC::Vec3(
                 std::cos(angle) * 5.0f,
                 0,
                 std::sin(angle) * 5.0f
-            );
+            ));
             
             spinningCar->AddBehaviour<RotatingCargo>(TLETC::Vec3(0, 1, 0), 90.0f);  // Cargo alias!
             auto* colorCargo = spinningCar->AddBehaviour<ColorChangeCargo>();  // Cargo alias!
@@ -232,14 +234,12 @@ public:
         );
         
         firebox->UseShader(shaderProgram);
-        firebox->SetUniformMat4(shaderProgram, "u_view", view);
-        firebox->SetUniformMat4(shaderProgram, "u_projection", projection);
+        firebox->SetFrameData(view, projection, GetTime(), GetDeltaTime());
         firebox->SetUniformVec3(shaderProgram, "u_lightPos", TLETC::Vec3(10, 10, 10));
 
-        // Draw all cars (entities)
-        for (const auto& car : GetEntities()) {  // Cars!
-            if (!car->mesh) continue;
-            
+        // Draw the cars (entities) in view
+        SetCullingCamera(projection * view);
+        for (TLETC::Entity* car : GetVisibleEntities()) {  // Cars!
             TLETC::Vec3 color;
             
             if (car->name == "PlayerCar") {
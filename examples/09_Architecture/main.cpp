@@ -191,7 +191,7 @@ public:
         // Create entity with execution-ordered behaviours
         auto* orderedEntity = CreateEntity("OrderedEntity");
         orderedEntity->mesh = &cubeMesh;
-        orderedEntity->transform.position = TLETC::Vec3(-3, 0, 0);
+        orderedEntity->transform.SetPosition(TLETC::Vec3(-3, 0, 0));
         
         // Add in WRONG order - they'll be sorted by executionOrder!
         //orderedEntity->AddBehaviour<LateBehaviour>();    // Order: 100
@@ -206,7 +206,7 @@ public:
         // Create entity that only responds to events
         eventTestEntity = CreateEntity("EventTestEntity");
         eventTestEntity->mesh = &sphereMesh;
-        eventTestEntity->transform.position = TLETC::Vec3(0, 0, 0);
+        eventTestEntity->transform.SetPosition(TLETC::Vec3(0, 0, 0));
         eventTestEntity->AddBehaviour<KeyHandler>();
         eventTestEntity->AddBehaviour<MouseHandler>();
         eventTestEntity->AddBehaviour<Rotator>();
@@ -223,12 +223,12 @@ public:
             auto* spinner = CreateEntity("Spinner" + std::to_string(i));
             spinner->mesh = &cubeMesh;
             float angle = (i / 5.0f) * TLETC::TWO_PI;
-            spinner->transform.position = TLETC::Vec3(
+            spinner->transform.SetPosition(TLETC::Vec3(
                 std::cos(angle) * 5.0f,
                 0,
                 std::sin(angle) * 5.0f
-            );
-            spinner->transform.scale = TLETC::Vec3(0.5f);
+            ));
+            spinner->transform.SetScale(TLETC::Vec3(0.5f));
             spinner->AddBehaviour<Rotator>(TLETC::Vec3(0, 1, 0), 90.0f);
         }
         
@@ -273,8 +273,7 @@ public:
         TLETC::Mat4 view = TLETC::lookAt(cameraPos, TLETC::Vec3(0, 0, 0), TLETC::Vec3(0, 1, 0));
         
         renderer->UseShader(shaderProgram);
-        renderer->SetUniformMat4(shaderProgram, "u_view", view);
-        renderer->SetUniformMat4(shaderProgram, "u_projection", projection);
+        renderer->SetFrameData(view, projection, GetTime(), GetDeltaTime());
         renderer->SetUniformVec3(shaderProgram, "u_lightPos", TLETC::Vec3(10, 10, 10));
         
         for (const auto& entity : GetEntities()) {
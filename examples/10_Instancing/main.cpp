@@ -0,0 +1,212 @@
+#include "TLETC/Core/Window.h"
+#include "TLETC/Core/Input.h"
+#include "TLETC/Core/Math.h"
+#include "TLETC/Resources/Mesh.h"
+#include "TLETC/Resources/GeometryFactory.h"
+#include "TLETC/Scene/Transform.h"
+
+#include "../../src/Platform/OpenGL/GLRenderDevice.h"
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <filesystem>
+
+std::string LoadFileAsString(const std::string& path)
+{
+    std::ifstream file(path);
+    if (!file.is_open())
+    {
+        std::cerr << "Failed to open file: " + path << std::endl;
+        return "";
+    }
+
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    return buffer.str();
+}
+
+TLETC::ShaderHandle LoadProgram(TLETC::GLRenderDevice& renderer, const std::filesystem::path& vertPath, const std::filesystem::path& fragPath)
+{
+    auto vertShader = renderer.CreateShader(TLETC::ShaderType::Vertex,   LoadFileAsString(vertPath.string()));
+    auto fragShader = renderer.CreateShader(TLETC::ShaderType::Fragment, LoadFileAsString(fragPath.string()));
+    return renderer.CreateShaderProgram(vertShader, fragShader);
+}
+
+int main() 
+{
+    std::cout << "========================================" << std::endl;
+    std::cout << "  The Little Engine That Could" << std::endl;
+    std::cout << "  Example: Instancing" << std::endl;
+    std::cout << "========================================" << std::endl;
+    std::cout << std::endl;
+
+    // Create window
+    TLETC::Window window;
+    if (!window.Create(1280, 720, "TLETC - Instancing"))
+    {
+        std::cerr << "Failed to create window!" << std::endl;
+        return -1;
+    }
+
+    // Create renderer
+    TLETC::GLRenderDevice renderer;
+    if (!renderer.Initialize()) 
+    {
+        std::cerr << "Failed to initialize renderer!" << std::endl;
+        return -1;
+    }
+
+    // Initialize input
+    TLETC::Input input;
+    input.Initialize(window.GetNativeWindow());
+
+    std::cout << "Renderer: " << renderer.GetRendererName() << std::endl;
+    std::cout << std::endl;
+
+    // One mesh, many copies - uploaded once per vertex layout for comparison
+    TLETC::Mesh cube = TLETC::GeometryFactory::CreateCube(0.5f);
+    TLETC::Mesh cubeSeparate = cube;
+    cubeSeparate.SetVertexLayout(TLETC::VertexLayout::Separate);
+
+    const std::filesystem::path ProjectRoot = PROJECT_ROOT_DIR;
+    auto instancedProgram = LoadProgram(renderer, ProjectRoot / "assets/shaders/basic_instanced.vert", ProjectRoot / "assets/shaders/basic.frag");
+    auto basicProgram     = LoadProgram(renderer, ProjectRoot / "assets/shaders/basic.vert",           ProjectRoot / "assets/shaders/basic.frag");
+
+    if (!instancedProgram.IsValid() || !basicProgram.IsValid()) 
+    {
+        std::cerr << "Failed to create shader programs!" << std::endl;
+        return -1;
+    }
+
+    // Setup scene - 100x100 field of cubes
+    const int gridSize = 100;
+    TLETC::TransformSystem transformSystem;
+    std::vector<TLETC::Transform> transforms;
+    transforms.reserve(gridSize * gridSize);
+    for (int x = 0; x < gridSize; ++x) 
+    {
+        for (int z = 0; z < gridSize; ++z) 
+        {
+            TLETC::Transform t(transformSystem);
+            t.SetPosition(TLETC::Vec3(static_cast<float>(x - gridSize / 2), 0.0f, static_cast<float>(z - gridSize / 2)));
+            transforms.push_back(t);
+        }
+    }
+    std::vector<TLETC::Mat4> modelMatrices(transforms.size());
+
+    TLETC::Mat4 projection = TLETC::perspective(TLETC::radians(60.0f), window.GetAspectRatio(), 0.1f, 200.0f);
+    TLETC::Vec3 lightPos(50.0f, 50.0f, 50.0f);
+    TLETC::Vec3 objectColor(0.9f, 0.5f, 0.2f);
+
+    bool instanced   = true;
+    bool interleaved = true;
+    bool gpuCulling  = false;
+
+    std::cout << "Controls:" << std::endl;
+    std::cout << "  Space - Toggle instanced / one draw per cube" << std::endl;
+    std::cout << "  L     - Toggle interleaved / separate vertex buffers" << std::endl;
+    std::cout << "  C     - Toggle GPU frustum culling (instanced, interleaved)" << std::endl;
+    std::cout << "  ESC   - Exit" << std::endl;
+    std::cout << std::endl;
+    std::cout << "Drawing " << transforms.size() << " cubes" << std::endl;
+
+    double lastTime  = window.GetTime();
+    double lastPrint = lastTime;
+    int frameCount = 0;
+
+    // Main loop
+    while (!window.ShouldClose()) 
+    {
+        double currentTime = window.GetTime();
+        float deltaTime = static_cast<float>(currentTime - lastTime);
+        lastTime = currentTime;
+        frameCount++;
+
+        if (currentTime - lastPrint >= 1.0) 
+        {
+            const TLETC::RenderStats& stats = renderer.GetStats();
+            std::cout << "FPS: " << frameCount 
+                      << " | Draw calls: " << stats.drawCalls
+                      << " | State changes: " << stats.stateChangesIssued << " issued, " << stats.stateChangesSkipped << " skipped"
+                      << " | Meshes: " << stats.meshesResident << " resident, " << stats.meshBytesResident / 1024 << " KB" << std::endl;
+            frameCount = 0;
+            lastPrint = currentTime;
+        }
+
+        input.Update();
+
+        if (input.IsKeyJustPressed(TLETC::KeyCode::Escape))
+            break;
+
+        if (input.IsKeyJustPressed(TLETC::KeyCode::Space))
+            instanced = !instanced;
+
+        if (input.IsKeyJustPressed(TLETC::KeyCode::L))
+        {
+            interleaved = !interleaved;
+            std::cout << "Vertex layout: " << (interleaved ? "interleaved" : "separate") << std::endl;
+        }
+
+        if (input.IsKeyJustPressed(TLETC::KeyCode::C))
+        {
+            gpuCulling = !gpuCulling;
+            renderer.EnableGpuCulling(gpuCulling);
+            std::cout << "GPU culling: " << (gpuCulling ? "on" : "off") << std::endl;
+        }
+
+        // Spin every cube
+        for (size_t i = 0; i < transforms.size(); ++i)
+        {
+            transforms[i].Rotate(TLETC::Vec3(0.0f, 1.0f, 0.0f), 45.0f * deltaTime);
+            modelMatrices[i] = transforms[i].GetModelMatrix();
+        }
+
+        // Orbit camera
+        float camAngle = static_cast<float>(currentTime * 0.1f);
+        TLETC::Vec3 cameraPos(std::sin(camAngle) * 60.0f, 30.0f, std::cos(camAngle) * 60.0f);
+        TLETC::Mat4 view = TLETC::lookAt(cameraPos, TLETC::Vec3(0.0f), TLETC::Vec3(0.0f, 1.0f, 0.0f));
+
+        // Render
+        renderer.BeginFrame();
+        renderer.Clear(TLETC::Vec4(0.1f, 0.1f, 0.15f, 1.0f));
+
+        TLETC::ShaderHandle program = instanced ? instancedProgram : basicProgram;
+        renderer.UseShader(program);
+        renderer.SetFrameData(view, projection, static_cast<float>(currentTime), deltaTime);
+        renderer.SetUniformVec3(program, "u_lightPos", lightPos);
+        renderer.SetUniformVec3(program, "u_viewPos", cameraPos);
+        renderer.SetUniformVec3(program, "u_color", objectColor);
+
+        const TLETC::Mesh& mesh = interleaved ? cube : cubeSeparate;
+        if (instanced)
+        {
+            // A batch of one mesh is an instanced draw that GPU culling can trim
+            const TLETC::MeshBatch batch = { &mesh, modelMatrices };
+            renderer.DrawMeshBatch(std::span<const TLETC::MeshBatch>(&batch, 1));
+        }
+        else
+        {
+            for (const TLETC::Mat4& model : modelMatrices)
+                renderer.DrawMesh(mesh, model);
+        }
+
+        renderer.EndFrame();
+        window.SwapBuffers();
+        window.PollEvents();
+    }
+
+    std::cout << std::endl;
+    std::cout << "Cleaning up..." << std::endl;
+
+    input.Shutdown();
+    renderer.DestroyShader(instancedProgram);
+    renderer.DestroyShader(basicProgram);
+    renderer.Shutdown();
+
+    std::cout << "Done!" << std::endl;
+
+    return 0;
+}
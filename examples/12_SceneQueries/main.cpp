@@ -0,0 +1,152 @@
+#include <TLETC/Core/Math.h>
+#include <TLETC/Scene/Entity.h>
+#include <TLETC/Scene/SceneBVH.h>
+#include <TLETC/Resources/GeometryFactory.h>
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <vector>
+
+/**
+ * Scene query benchmark
+ *
+ * Fills a scene with cubes and compares SceneBVH against what a caller does today:
+ * walk the entity list (as Application::GetEntities() hands it out) and test every
+ * entity's world bounds. Bounds for the linear scan are taken from the transforms up
+ * front, so only the tests themselves are timed on both sides.
+ *
+ * Also times the per-frame upkeep: refitting after 1% of the entities moved, and a
+ * full rebuild.
+ */
+
+using namespace TLETC;
+using Clock = std::chrono::high_resolution_clock;
+
+template<typename Fn>
+static double TimeMs(Fn&& fn)
+{
+    const auto start = Clock::now();
+    fn();
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+static void RunBenchmark(size_t count, const Mesh& cube)
+{
+    std::mt19937 rng(42);
+    const float extent = std::cbrt(static_cast<float>(count)) * 4.0f;  // Keeps the density constant
+    std::uniform_real_distribution<float> position(-extent, extent);
+    std::uniform_real_distribution<float> scale(0.5f, 2.0f);
+
+    TransformSystem transforms;
+    std::vector<UniquePtr<Entity>> entities;
+    std::vector<BoundingBox>       worldBounds;
+    SceneBVH bvh;
+    entities.reserve(count);
+    worldBounds.reserve(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        auto entity = MakeUnique<Entity>(transforms, "Cube");
+        entity->mesh = &cube;
+        entity->transform.SetPosition(Vec3(position(rng), position(rng), position(rng)));
+        entity->transform.SetScale(Vec3(scale(rng)));
+        worldBounds.push_back(cube.GetBoundingBox().Transformed(entity->transform.GetWorldMatrix()));
+        bvh.Insert(entity.get(), worldBounds.back());
+        entities.push_back(std::move(entity));
+    }
+    const double buildMs = TimeMs([&]() { bvh.Rebuild(); });
+
+    // Queries: rays from the edge through the scene, a camera frustum and small overlap boxes
+    const int queryCount = 1000;
+    std::vector<Ray> rays;
+    std::vector<BoundingBox> boxes;
+    for (int i = 0; i < queryCount; ++i)
+    {
+        const Vec3 origin(position(rng), position(rng), -extent * 1.5f);
+        const Vec3 target(position(rng) * 0.5f, position(rng) * 0.5f, 0.0f);
+        rays.emplace_back(origin, normalize(target - origin));
+        const Vec3 center(position(rng), position(rng), position(rng));
+        boxes.emplace_back(center - Vec3(5.0f), center + Vec3(5.0f));
+    }
+    const Frustum frustum = Frustum::FromMatrix(perspective(Radians(60.0f), 16.0f / 9.0f, 0.1f, extent)
+                                              * lookAt(Vec3(0.0f, 0.0f, extent), Vec3(0.0f), Vec3(0.0f, 1.0f, 0.0f)));
+
+    size_t linearHits = 0, bvhHits = 0;
+    const double linearRayMs = TimeMs([&]() {
+        for (const Ray& ray : rays)
+        {
+            float nearest = 1e30f;
+            Entity* hit = nullptr;
+            for (size_t i = 0; i < entities.size(); ++i)
+            {
+                float t = 0.0f;
+                if (ray.Intersects(worldBounds[i], nearest, t) && t < nearest) { nearest = t; hit = entities[i].get(); }
+            }
+            linearHits += hit != nullptr;
+        }
+    });
+    const double bvhRayMs = TimeMs([&]() {
+        SceneRaycastHit hit;
+        for (const Ray& ray : rays)
+            bvhHits += bvh.Raycast(ray, 1e30f, hit);
+    });
+
+    std::vector<Entity*> found;
+    size_t linearOverlaps = 0, bvhOverlaps = 0;
+    const double linearBoxMs = TimeMs([&]() {
+        for (const BoundingBox& box : boxes)
+        {
+            for (size_t i = 0; i < entities.size(); ++i)
+            {
+                const BoundingBox& b = worldBounds[i];
+                linearOverlaps += b.min.x <= box.max.x && b.max.x >= box.min.x &&
+                                  b.min.y <= box.max.y && b.max.y >= box.min.y &&
+                                  b.min.z <= box.max.z && b.max.z >= box.min.z;
+            }
+        }
+    });
+    const double bvhBoxMs = TimeMs([&]() {
+        for (const BoundingBox& box : boxes)
+        {
+            found.clear();
+            bvh.QueryOverlap(box, found);
+            bvhOverlaps += found.size();
+        }
+    });
+
+    size_t linearVisible = 0;
+    const double linearFrustumMs = TimeMs([&]() {
+        for (const BoundingBox& b : worldBounds)
+            linearVisible += frustum.Intersects(b);
+    });
+    found.clear();
+    const double bvhFrustumMs = TimeMs([&]() { bvh.QueryFrustum(frustum, found); });
+
+    // Upkeep: 1% of the scene moves a little
+    for (size_t i = 0; i < count; i += 100)
+    {
+        entities[i]->transform.Translate(Vec3(0.25f));
+        bvh.SetBounds(entities[i].get(), cube.GetBoundingBox().Transformed(entities[i]->transform.GetWorldMatrix()));
+    }
+    const double refitMs = TimeMs([&]() { bvh.Update(); });
+
+    const bool agree = linearHits == bvhHits && linearOverlaps == bvhOverlaps && linearVisible == found.size();
+    std::cout << std::setw(7) << count << " entities" << (agree ? "" : "  MISMATCH") << std::endl;
+    std::cout << "  " << queryCount << " raycasts:   linear " << std::setw(9) << linearRayMs     << " ms | BVH " << std::setw(8) << bvhRayMs     << " ms" << std::endl;
+    std::cout << "  " << queryCount << " overlaps:   linear " << std::setw(9) << linearBoxMs     << " ms | BVH " << std::setw(8) << bvhBoxMs     << " ms" << std::endl;
+    std::cout << "  1 frustum:       linear " << std::setw(9) << linearFrustumMs << " ms | BVH " << std::setw(8) << bvhFrustumMs << " ms"
+              << " (" << found.size() << " visible)" << std::endl;
+    std::cout << "  upkeep:          build  " << std::setw(9) << buildMs << " ms | refit 1% " << refitMs << " ms" << std::endl;
+}
+
+int main()
+{
+    std::cout << "=== Scene Query Benchmark ===" << std::endl;
+    std::cout << std::fixed << std::setprecision(3);
+
+    const Mesh cube = GeometryFactory::CreateCube(1.0f);
+    for (size_t count : { size_t(1000), size_t(10000), size_t(100000) })
+        RunBenchmark(count, cube);
+
+    return 0;
+}
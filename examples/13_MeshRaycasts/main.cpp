@@ -0,0 +1,115 @@
+#include <TLETC/Core/Math.h>
+#include <TLETC/Resources/Mesh.h>
+#include <TLETC/Resources/MeshBVH.h>
+#include <TLETC/Resources/GeometryFactory.h>
+#include <TLETC/Core/JobSystem.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <vector>
+
+/**
+ * Triangle-exact raycasts against a million-triangle mesh
+ *
+ * Builds a MeshBVH over a finely tessellated torus and fires random rays at it:
+ * a handful through a brute-force loop over every triangle for scale, then the
+ * whole batch through the BVH on one thread and across a JobSystem, for closest hits
+ * and for occlusion (any hit).
+ */
+
+using namespace TLETC;
+using Clock = std::chrono::high_resolution_clock;
+
+template<typename Fn>
+static double TimeMs(Fn&& fn)
+{
+    const auto start = Clock::now();
+    fn();
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+static bool BruteForce(const Mesh& mesh, const Ray& ray, float& best)
+{
+    const auto& positions = mesh.GetVertexPositions();
+    const auto& indices   = mesh.GetIndices();
+    bool hit = false;
+    for (size_t t = 0; t + 2 < indices.size(); t += 3)
+    {
+        const Vec3& v0 = positions[indices[t]];
+        const Vec3  e1 = positions[indices[t + 1]] - v0;
+        const Vec3  e2 = positions[indices[t + 2]] - v0;
+        const Vec3  p  = cross(ray.direction, e2);
+        const float det = dot(e1, p);
+        if (det == 0.0f) continue;
+        const Vec3  s = ray.origin - v0;
+        const float u = dot(s, p) / det;
+        const Vec3  q = cross(s, e1);
+        const float v = dot(ray.direction, q) / det;
+        const float d = dot(e2, q) / det;
+        if (u < 0.0f || v < 0.0f || u + v > 1.0f || d < 0.0f || d > best) continue;
+        best = d;
+        hit  = true;
+    }
+    return hit;
+}
+
+int main()
+{
+    std::cout << "=== Mesh Raycast Benchmark ===" << std::endl;
+    std::cout << std::fixed << std::setprecision(3);
+
+    const Mesh mesh = GeometryFactory::CreateTorus(1.0f, 0.35f, 1024, 512);
+    std::cout << "Triangles: " << mesh.GetTriangleCount() << std::endl;
+
+    MeshBVH bvh;
+    const double buildMs = TimeMs([&]() { bvh.Build(mesh); });
+    std::cout << "Build:     " << buildMs << " ms, " << bvh.GetNodeCount() << " nodes, "
+              << bvh.GetMemoryUsage() / (1024.0 * 1024.0) << " MB" << std::endl;
+
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<float> spread(-1.5f, 1.5f);
+    std::vector<Ray> rays;
+    for (int i = 0; i < 200000; ++i)
+    {
+        const Vec3 origin(spread(rng), spread(rng), 3.0f);
+        const Vec3 target(spread(rng), spread(rng), spread(rng) * 0.3f);
+        rays.emplace_back(origin, normalize(target - origin));
+    }
+
+    // Brute force on a few rays only, it would take minutes otherwise
+    const int bruteCount = 20;
+    int agree = 0;
+    const double bruteMs = TimeMs([&]() {
+        for (int i = 0; i < bruteCount; ++i)
+        {
+            float best = 100.0f;
+            MeshRaycastHit hit;
+            const bool expected = BruteForce(mesh, rays[i], best);
+            agree += bvh.Raycast(rays[i], 100.0f, hit) == expected && (!expected || std::abs(hit.distance - best) < 1e-4f);
+        }
+    });
+    std::cout << "Brute force: " << std::setw(10) << bruteMs / bruteCount << " ms per ray (" << agree << "/" << bruteCount << " agree with the BVH)" << std::endl;
+
+    std::vector<MeshRaycastHit> hits(rays.size());
+    std::vector<uint8>          occluded(rays.size());
+    JobSystem jobSystem;
+    jobSystem.Initialize();
+    for (JobSystem* jobs : { static_cast<JobSystem*>(nullptr), &jobSystem })
+    {
+        const uint32 threadCount = jobs ? jobs->GetThreadCount() : 1;
+        const double closestMs   = TimeMs([&]() { bvh.Raycast(rays, 100.0f, hits, jobs); });
+        const double anyMs       = TimeMs([&]() { bvh.Occluded(rays, 100.0f, occluded, jobs); });
+
+        size_t hitCount = 0;
+        for (const MeshRaycastHit& hit : hits)
+            hitCount += hit.IsHit();
+        std::cout << std::setw(2) << threadCount << " thread(s): " << rays.size() << " rays, " << hitCount << " hits | closest "
+                  << std::setw(8) << closestMs << " ms (" << rays.size() / closestMs / 1000.0 << " Mrays/s) | occluded "
+                  << std::setw(8) << anyMs << " ms" << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,185 @@
+#include <TLETC/Core/Math.h>
+#include <TLETC/Scene/Transform.h>
+#include <TLETC/Scene/TransformSystem.h>
+#include <TLETC/Core/JobSystem.h>
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <thread>
+#include <vector>
+
+/**
+ * Transform hierarchy benchmark
+ *
+ * 100k nodes as 10k little trains, six levels deep: an engine pulling three coupled cars,
+ * each car with a bogie and each bogie with a wheel. World matrices are computed two ways:
+ *   - the old way, one heap object per node asking its parent for its world matrix,
+ *     recursively, for every node (what Transform::GetWorldMatrix used to do)
+ *   - TransformSystem::Update, one front-to-back sweep over flat arrays
+ * The sweep is timed with every train moving, 1% of them moving, and nothing moving,
+ * then with everything moving on JobSystems of 1 to N threads (each depth split across them).
+ *
+ * Build in Release, the numbers mean nothing otherwise.
+ */
+
+using namespace TLETC;
+using Clock = std::chrono::high_resolution_clock;
+
+static constexpr int TrainCount    = 10000;
+static constexpr int NodesPerTrain = 10;
+
+// Best of a few runs, in milliseconds
+template<typename Fn>
+static double Time(Fn&& fn, int runs = 10)
+{
+    double best = 1e30;
+    for (int i = 0; i < runs; ++i)
+    {
+        const auto start = Clock::now();
+        fn();
+        const std::chrono::duration<double, std::milli> elapsed = Clock::now() - start;
+        best = std::min(best, elapsed.count());
+    }
+    return best;
+}
+
+// The pre-TransformSystem layout: scattered nodes, raw parent pointers, nothing cached
+struct PointerNode
+{
+    Vec3         position = Vec3(0.0f);
+    Quat         rotation = Quat(1.0f, 0.0f, 0.0f, 0.0f);
+    Vec3         scale    = Vec3(1.0f);
+    PointerNode* parent   = nullptr;
+
+    Mat4 GetWorldMatrix() const
+    {
+        const Mat4 local = glm::translate(Mat4(1.0f), position) * glm::mat4_cast(rotation) * glm::scale(Mat4(1.0f), scale);
+        return parent ? parent->GetWorldMatrix() * local : local;
+    }
+};
+
+// Parent of each of a train's nodes, by index within the train (-1 for the engine)
+static constexpr int s_trainParents[NodesPerTrain] = { -1, 0, 1, 2, 1, 2, 3, 4, 5, 6 };
+static const Vec3    s_trainOffsets[NodesPerTrain] = {
+    Vec3(0.0f), Vec3(0, 0, 2), Vec3(0, 0, 2), Vec3(0, 0, 2),
+    Vec3(0, -0.5f, 0), Vec3(0, -0.5f, 0), Vec3(0, -0.5f, 0),
+    Vec3(0.4f, -0.2f, 0), Vec3(0.4f, -0.2f, 0), Vec3(0.4f, -0.2f, 0)
+};
+
+int main()
+{
+    std::cout << "=== Transform Hierarchy Benchmark ===" << std::endl;
+    std::cout << std::fixed << std::setprecision(3);
+
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> spread(-500.0f, 500.0f);
+
+    // Old layout, allocated in shuffled order like entities created over a session
+    std::vector<PointerNode*> pointerNodes(TrainCount * NodesPerTrain);
+    std::vector<size_t> allocationOrder(pointerNodes.size());
+    for (size_t i = 0; i < allocationOrder.size(); ++i)
+        allocationOrder[i] = i;
+    std::shuffle(allocationOrder.begin(), allocationOrder.end(), rng);
+    for (size_t i : allocationOrder)
+        pointerNodes[i] = new PointerNode();
+
+    // New layout, through the same Transform interface entities use
+    TransformSystem system;
+    system.Reserve(pointerNodes.size());
+    std::vector<Transform> transforms;
+    transforms.reserve(pointerNodes.size());
+
+    for (int train = 0; train < TrainCount; ++train)
+    {
+        const Vec3 start(spread(rng), 0.0f, spread(rng));
+        for (int node = 0; node < NodesPerTrain; ++node)
+        {
+            const size_t index  = static_cast<size_t>(train) * NodesPerTrain + node;
+            const Vec3   offset = node == 0 ? start : s_trainOffsets[node];
+            const int    parent = s_trainParents[node];
+
+            pointerNodes[index]->position = offset;
+            if (parent >= 0)
+                pointerNodes[index]->parent = pointerNodes[index - node + parent];
+
+            transforms.emplace_back(system);
+            transforms.back().SetPosition(offset);
+            if (parent >= 0)
+                transforms.back().SetParent(&transforms[index - node + parent]);
+        }
+    }
+    system.Update();
+    std::cout << "Nodes: " << system.GetCount() << " in " << system.GetDepthCount() << " levels" << std::endl;
+
+    std::vector<Mat4> pointerWorlds(pointerNodes.size());
+    auto moveTrains = [&](int every, float step) {
+        for (int train = 0; train < TrainCount; train += every)
+        {
+            const size_t engine = static_cast<size_t>(train) * NodesPerTrain;
+            pointerNodes[engine]->position.x += step;
+            transforms[engine].Translate(Vec3(step, 0.0f, 0.0f));
+            transforms[engine + 9].Rotate(Vec3(1, 0, 0), step);  // Last wheel spins
+            pointerNodes[engine + 9]->rotation = transforms[engine + 9].GetRotation();
+        }
+    };
+
+    const double pointerMs = Time([&]() {
+        moveTrains(1, 0.01f);
+        for (size_t i = 0; i < pointerNodes.size(); ++i)
+            pointerWorlds[i] = pointerNodes[i]->GetWorldMatrix();
+    });
+    const double allMs = Time([&]() {
+        moveTrains(1, 0.01f);
+        system.Update();
+    });
+    const double someMs = Time([&]() {
+        moveTrains(100, 0.01f);
+        system.Update();
+    });
+    const double noneMs = Time([&]() { system.Update(); });
+
+    // Both layouts went through the same moves, so they should agree
+    size_t mismatches = 0;
+    for (size_t i = 0; i < pointerNodes.size(); ++i)
+    {
+        const Vec3 a(pointerNodes[i]->GetWorldMatrix()[3]);
+        const Vec3 b = transforms[i].GetWorldPosition();
+        mismatches += length(a - b) > 1e-3f;
+    }
+
+    std::cout << "Pointer chasing, all moving:  " << std::setw(9) << pointerMs << " ms" << std::endl;
+    std::cout << "Flat sweep, all moving:       " << std::setw(9) << allMs << " ms  (" << pointerMs / allMs << "x)" << std::endl;
+    std::cout << "Flat sweep, 1% moving:        " << std::setw(9) << someMs << " ms" << std::endl;
+    std::cout << "Flat sweep, nothing moving:   " << std::setw(9) << noneMs << " ms" << std::endl;
+    std::cout << "Mismatching world positions:  " << mismatches << std::endl;
+
+    // Moving the trains is serial, so only the sweep is timed here
+    std::cout << std::endl << "Threads (all moving):" << std::endl;
+    const uint32 maxThreads = std::max(1u, std::thread::hardware_concurrency());
+    double singleMs = 0.0;
+    for (uint32 threads = 1; threads <= maxThreads; threads *= 2)
+    {
+        JobSystem jobs;
+        if (threads > 1)
+            jobs.Initialize(threads - 1);  // The main thread makes up the rest
+
+        double best = 1e30;
+        for (int run = 0; run < 10; ++run)
+        {
+            moveTrains(1, 0.01f);
+            best = std::min(best, Time([&]() { system.Update(&jobs); }, 1));
+        }
+        if (threads == 1)
+            singleMs = best;
+        std::cout << "  " << std::setw(2) << threads << ": " << std::setw(9) << best << " ms  (" << singleMs / best << "x)" << std::endl;
+        if (threads < maxThreads && threads * 2 > maxThreads)
+            threads = maxThreads / 2;  // Finish on the exact hardware thread count
+    }
+
+    transforms.clear();
+    for (PointerNode* node : pointerNodes)
+        delete node;
+    return 0;
+}
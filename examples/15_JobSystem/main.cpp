@@ -0,0 +1,125 @@
+#include <TLETC/Core/Types.h>
+#include <TLETC/Core/JobSystem.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <iomanip>
+#include <thread>
+#include <vector>
+
+/**
+ * Job system benchmark
+ *
+ * What the work-stealing JobSystem costs and what it buys:
+ *   - spawn overhead: 100k empty jobs started and waited for, per job
+ *   - ParallelFor scaling: a few million square roots on JobSystems of 1 to N threads
+ *   - a dependency chain: stages of jobs, each stage held back until the one before drains
+ *
+ * Build in Release, the numbers mean nothing otherwise.
+ */
+
+using namespace TLETC;
+using Clock = std::chrono::high_resolution_clock;
+
+// Best of a few runs, in milliseconds
+template<typename Fn>
+static double Time(Fn&& fn, int runs = 5)
+{
+    double best = 1e30;
+    for (int i = 0; i < runs; ++i)
+    {
+        const auto start = Clock::now();
+        fn();
+        const std::chrono::duration<double, std::milli> elapsed = Clock::now() - start;
+        best = std::min(best, elapsed.count());
+    }
+    return best;
+}
+
+int main()
+{
+    std::cout << "=== Job System Benchmark ===" << std::endl;
+    std::cout << std::fixed << std::setprecision(3);
+
+    const uint32 maxThreads = std::max(1u, std::thread::hardware_concurrency());
+
+    // Spawn overhead
+    {
+        JobSystem jobs;
+        jobs.Initialize();
+
+        constexpr int JobCount = 100000;
+        std::atomic<int> ran(0);
+        const double ms = Time([&]() {
+            JobCounter done;
+            for (int i = 0; i < JobCount; ++i)
+                jobs.Run([&ran]() { ran.fetch_add(1, std::memory_order_relaxed); }, &done);
+            jobs.Wait(done);
+        });
+        std::cout << "Empty jobs on " << jobs.GetThreadCount() << " thread(s): " << std::setw(8) << ms * 1e6 / JobCount
+                  << " ns per job (" << ran.load() << " run)" << std::endl;
+    }
+
+    // ParallelFor scaling
+    std::cout << std::endl << "ParallelFor, 4M square roots:" << std::endl;
+    std::vector<float> values(4 * 1024 * 1024);
+    for (size_t i = 0; i < values.size(); ++i)
+        values[i] = static_cast<float>(i);
+
+    double singleMs = 0.0;
+    for (uint32 threads = 1; threads <= maxThreads; threads *= 2)
+    {
+        JobSystem jobs;
+        if (threads > 1)
+            jobs.Initialize(threads - 1);  // The main thread makes up the rest
+
+        std::vector<float> roots(values.size());
+        const double ms = Time([&]() {
+            jobs.ParallelFor(values.size(), 4096, [&](size_t begin, size_t end) {
+                for (size_t i = begin; i < end; ++i)
+                    roots[i] = std::sqrt(values[i]) * 0.5f + 1.0f;
+            });
+        });
+        if (threads == 1)
+            singleMs = ms;
+        std::cout << "  " << std::setw(2) << threads << ": " << std::setw(9) << ms << " ms  (" << singleMs / ms << "x)" << std::endl;
+        if (threads < maxThreads && threads * 2 > maxThreads)
+            threads = maxThreads / 2;  // Finish on the exact hardware thread count
+    }
+
+    // Dependency chain: every stage adds one to each slot, and only after the previous stage
+    {
+        JobSystem jobs;
+        jobs.Initialize();
+
+        constexpr int StageCount = 64;
+        constexpr int JobsPerStage = 64;
+        std::vector<std::atomic<int>> slots(JobsPerStage);
+        std::atomic<bool> ordered(true);
+
+        const double ms = Time([&]() {
+            for (auto& slot : slots)
+                slot.store(0);
+
+            std::vector<JobCounter> stages(StageCount);
+            for (int stage = 0; stage < StageCount; ++stage)
+            {
+                JobCounter* previous = stage > 0 ? &stages[stage - 1] : nullptr;
+                for (int job = 0; job < JobsPerStage; ++job)
+                {
+                    jobs.Run([&slots, &ordered, stage, job]() {
+                        if (slots[job].fetch_add(1) != stage)
+                            ordered.store(false);
+                    }, &stages[stage], previous);
+                }
+            }
+            jobs.Wait(stages.back());
+        });
+        std::cout << std::endl << "Dependency chain, " << StageCount << " stages of " << JobsPerStage << " jobs: " << std::setw(8) << ms
+                  << " ms (" << (ordered.load() ? "in order" : "OUT OF ORDER") << ")" << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,149 @@
+#include <TLETC/Scene/Entity.h>
+#include <TLETC/Scene/Behaviour.h>
+#include <TLETC/Scene/World.h>
+#include <TLETC/Scene/Components.h>
+#include <TLETC/Core/JobSystem.h>
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <memory>
+#include <thread>
+#include <vector>
+
+/**
+ * ECS benchmark
+ *
+ * 100k things that drift along a velocity, stored three ways:
+ *   - the Entity/Behaviour way: a heap Entity each, with a Mover behaviour holding the
+ *     velocity, updated through a list of behaviour pointers like Application does
+ *   - World::Each<Transform, Velocity>: the same Transforms and velocities as components,
+ *     walked chunk by chunk, then the same query through ParallelEach
+ *   - a pure-data pass: Bounds moved by Velocity, nothing but the two arrays touched
+ * The Transform passes still write into the TransformSystem, so they show what the layout
+ * of the per-entity data buys; the Bounds pass is what a system that lives entirely in
+ * the World costs.
+ *
+ * Build in Release, the numbers mean nothing otherwise.
+ */
+
+using namespace TLETC;
+using Clock = std::chrono::high_resolution_clock;
+
+static constexpr int EntityCount = 100000;
+
+// Best of a few runs, in milliseconds
+template<typename Fn>
+static double Time(Fn&& fn, int runs = 10)
+{
+    double best = 1e30;
+    for (int i = 0; i < runs; ++i)
+    {
+        const auto start = Clock::now();
+        fn();
+        const std::chrono::duration<double, std::milli> elapsed = Clock::now() - start;
+        best = std::min(best, elapsed.count());
+    }
+    return best;
+}
+
+class Mover : public Behaviour
+{
+public:
+    explicit Mover(const Vec3& velocity) : velocity_(velocity) { SetActiveEvents(EventFlag::Update); }
+
+    void OnUpdate(float deltaTime) override { GetEntity()->transform.Translate(velocity_ * deltaTime); }
+
+private:
+    Vec3 velocity_;
+};
+
+static Vec3 VelocityOf(int i)
+{
+    return Vec3(static_cast<float>(i % 7) - 3.0f, static_cast<float>(i % 5) - 2.0f, static_cast<float>(i % 3) - 1.0f);
+}
+
+int main()
+{
+    std::cout << "=== ECS Benchmark ===" << std::endl;
+    std::cout << std::fixed << std::setprecision(3);
+
+    const float deltaTime = 1.0f / 60.0f;
+
+    // Entity/Behaviour
+    TransformSystem entityTransforms;
+    std::vector<std::unique_ptr<Entity>> entities;
+    std::vector<Behaviour*> updates;
+    entities.reserve(EntityCount);
+    updates.reserve(EntityCount);
+    for (int i = 0; i < EntityCount; ++i)
+    {
+        entities.push_back(std::make_unique<Entity>(entityTransforms));
+        updates.push_back(entities.back()->AddBehaviour<Mover>(VelocityOf(i)));
+    }
+
+    // World, its Transforms in a system of their own so both start from the same state
+    TransformSystem worldTransforms;
+    World world;
+    for (int i = 0; i < EntityCount; ++i)
+    {
+        const Vec3 position(static_cast<float>(i % 100), 0.0f, static_cast<float>(i / 100));
+        world.Create(Transform(worldTransforms), Velocity{ VelocityOf(i) },
+                     Bounds{ BoundingBox(position - Vec3(0.5f), position + Vec3(0.5f)) });
+    }
+    std::cout << EntityCount << " entities in " << world.GetArchetypeCount() << " archetypes, "
+              << world.GetChunkCount() << " chunks of " << World::ChunkSize / 1024 << " KiB" << std::endl << std::endl;
+
+    const double behaviourMs = Time([&]() {
+        for (size_t i = 0, count = updates.size(); i < count; ++i)
+        {
+            if (updates[i]->IsEnabled())
+                updates[i]->OnUpdate(deltaTime);
+        }
+    });
+    const double eachMs = Time([&]() {
+        world.Each<Transform, const Velocity>([deltaTime](Transform& t, const Velocity& v) { t.Translate(v.linear * deltaTime); });
+    });
+    const double boundsMs = Time([&]() {
+        world.Each<Bounds, const Velocity>([deltaTime](Bounds& b, const Velocity& v) {
+            const Vec3 step = v.linear * deltaTime;
+            b.world.min += step;
+            b.world.max += step;
+        });
+    });
+
+    std::cout << "Behaviours, one heap Entity each:  " << std::setw(8) << behaviourMs << " ms" << std::endl;
+    std::cout << "World::Each<Transform, Velocity>:  " << std::setw(8) << eachMs << " ms  (" << behaviourMs / eachMs << "x)" << std::endl;
+    std::cout << "World::Each<Bounds, Velocity>:     " << std::setw(8) << boundsMs << " ms  (" << behaviourMs / boundsMs << "x)" << std::endl;
+
+    // The same queries spread over threads
+    const uint32 threads = std::max(1u, std::thread::hardware_concurrency());
+    if (threads > 1)
+    {
+        JobSystem jobs;
+        jobs.Initialize(threads);
+
+        const double parallelEachMs = Time([&]() {
+            world.ParallelEach<Transform, const Velocity>(&jobs, [deltaTime](Transform& t, const Velocity& v) { t.Translate(v.linear * deltaTime); });
+        });
+        const double parallelBoundsMs = Time([&]() {
+            world.ParallelEach<Bounds, const Velocity>(&jobs, [deltaTime](Bounds& b, const Velocity& v) {
+                const Vec3 step = v.linear * deltaTime;
+                b.world.min += step;
+                b.world.max += step;
+            });
+        });
+
+        std::cout << std::endl << "On " << threads << " threads:" << std::endl;
+        std::cout << "World::ParallelEach<Transform, Velocity>: " << std::setw(8) << parallelEachMs << " ms  (" << eachMs / parallelEachMs << "x over Each)" << std::endl;
+        std::cout << "World::ParallelEach<Bounds, Velocity>:    " << std::setw(8) << parallelBoundsMs << " ms  (" << boundsMs / parallelBoundsMs << "x over Each)" << std::endl;
+    }
+
+    // Keep the passes from being optimised away
+    float checksum = 0.0f;
+    for (const auto& entity : entities)
+        checksum += entity->transform.GetPosition().x;
+    world.Each<const Transform, const Bounds>([&checksum](const Transform& t, const Bounds& b) { checksum += t.GetPosition().x + b.world.min.x; });
+    std::cout << "(checksum " << checksum << ")" << std::endl;
+    return 0;
+}
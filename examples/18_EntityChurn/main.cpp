@@ -0,0 +1,130 @@
+#include <TLETC/Core/Application.h>
+#include <TLETC/Scene/Entity.h>
+#include <TLETC/Scene/Behaviour.h>
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <memory>
+#include <vector>
+
+/**
+ * Entity destruction benchmark
+ *
+ * Half the entities of a scene destroyed in one frame, each with two behaviours on the
+ * update and render lists:
+ *   - the old way: per entity a std::find_if over all entities, an erase from the middle,
+ *     then every behaviour erased from every event list, each a full scan
+ *   - the way Application does it now: the handle's slot says where the entity is, the last
+ *     entity fills its place, each behaviour leaves a hole at the slots it knows it has, and
+ *     the next run of each list closes them all in one pass
+ * The old way grows with destroyed x alive, the new one with destroyed + alive (the pass).
+ *
+ * No window is opened, the frame's phases are called directly. Build in Release, the
+ * numbers mean nothing otherwise.
+ */
+
+using namespace TLETC;
+using Clock = std::chrono::high_resolution_clock;
+
+class Spinner : public Behaviour
+{
+public:
+    Spinner() { SetActiveEvents(EventFlag::Update | EventFlag::Render); }
+};
+
+// Exposes the end-of-frame cleanup and one update run (where the lists are compacted)
+class ChurnApp : public Application
+{
+public:
+    ChurnApp() { SetParallelUpdatesEnabled(false); }
+
+    using Application::ProcessDestroyQueue;
+    using Application::Update;
+};
+
+// The pre-handle destruction, as Application::ProcessDestroyQueue used to do it
+struct OldScene
+{
+    TransformSystem                      transforms;
+    std::vector<std::unique_ptr<Entity>> entities;
+    std::vector<Behaviour*>              lists[Behaviour::MaxEventFlags];
+    std::vector<Entity*>                 toDestroy;
+
+    void ProcessDestroyQueue()
+    {
+        for (Entity* entity : toDestroy)
+        {
+            auto it = std::find_if(entities.begin(), entities.end(), [entity](const std::unique_ptr<Entity>& ptr) { return ptr.get() == entity; });
+            if (it == entities.end())
+                continue;
+
+            for (Behaviour* behaviour : (*it)->GetBehaviours<Behaviour>())
+            {
+                for (auto& list : lists)
+                    list.erase(std::remove(list.begin(), list.end(), behaviour), list.end());
+            }
+            entities.erase(it);
+        }
+        toDestroy.clear();
+    }
+};
+
+static double Milliseconds(Clock::time_point start)
+{
+    const std::chrono::duration<double, std::milli> elapsed = Clock::now() - start;
+    return elapsed.count();
+}
+
+int main()
+{
+    std::cout << "=== Entity Destruction Benchmark ===" << std::endl;
+    std::cout << std::fixed << std::setprecision(3);
+
+    for (int destroyed : { 1000, 10000 })
+    {
+        const int total = destroyed * 2;
+
+        OldScene old;
+        for (int i = 0; i < total; ++i)
+        {
+            old.entities.push_back(std::make_unique<Entity>(old.transforms));
+            for (int b = 0; b < 2; ++b)
+            {
+                Behaviour* behaviour = old.entities.back()->AddBehaviour<Spinner>();
+                old.lists[1].push_back(behaviour);
+                old.lists[4].push_back(behaviour);
+            }
+        }
+        for (int i = 0; i < total; i += 2)
+            old.toDestroy.push_back(old.entities[i].get());
+
+        ChurnApp app;
+        std::vector<EntityHandle> handles;
+        for (int i = 0; i < total; ++i)
+        {
+            Entity* entity = app.CreateEntity();
+            entity->AddBehaviour<Spinner>();
+            entity->AddBehaviour<Spinner>();
+            handles.push_back(entity->GetHandle());
+        }
+        app.Update();  // Sorted once, like any frame would have
+        for (int i = 0; i < total; i += 2)
+            app.DestroyEntity(handles[i]);
+
+        auto start = Clock::now();
+        old.ProcessDestroyQueue();
+        const double oldMs = Milliseconds(start);
+
+        start = Clock::now();
+        app.ProcessDestroyQueue();
+        app.Update();
+        const double newMs = Milliseconds(start);
+
+        std::cout << std::endl << destroyed << " of " << total << " entities destroyed in one frame:" << std::endl;
+        std::cout << "  find_if + erase + list scans: " << std::setw(10) << oldMs << " ms" << std::endl;
+        std::cout << "  Handles + swap + list holes:  " << std::setw(10) << newMs << " ms  (" << oldMs / newMs << "x)" << std::endl;
+        std::cout << "  (" << old.entities.size() << " and " << app.GetEntities().size() << " left)" << std::endl;
+    }
+    return 0;
+}
@@ -5,9 +5,16 @@
 #include "TLETC/Core/Input.h"
 #include "TLETC/Core/Event.h"
 #include "TLETC/Core/EventDispatcher.h"
+#include "TLETC/Core/JobSystem.h"
 #include "TLETC/Scene/Entity.h"
+#include "TLETC/Scene/BehaviourSchedule.h"
+#include "TLETC/Scene/World.h"
+#include "TLETC/Scene/CullingSystem.h"
+#include "TLETC/Scene/SceneBVH.h"
 #include "TLETC/Rendering/RenderDevice.h"
+#include "TLETC/Rendering/RenderQueue.h"
 
+#include <bit>
 #include <vector>
 #include <memory>
 
@@ -22,7 +29,7 @@ namespace TLETC
  * 3. Update (main game logic)
  * 4. Late Update (post-logic, camera follow, etc.)
  * 5. Pre Render (prepare rendering)
- * 6. Render (draw)
+ * 6. Render (draw - queued draws are sorted, batched and flushed at the end)
  * 7. Post Render (cleanup, UI overlays)
  */
 class Application 
@@ -44,15 +51,36 @@ public:
     virtual void OnRender() {}
 
     // Access to core systems
-    Window& GetWindow()             { return *window_; }
-    Input& GetInput()               { return *input_; }
-    RenderDevice* GetRenderDevice() { return renderDevice_.get(); }
+    Window& GetWindow()                   { return *window_; }
+    Input& GetInput()                     { return *input_; }
+    RenderDevice* GetRenderDevice()       { return renderDevice_.get(); }
+    RenderQueue& GetRenderQueue()         { return *renderQueue_; }
+    JobSystem& GetJobSystem()             { return jobSystem_; }
+    World& GetWorld()                     { return world_; }
+    TransformSystem& GetTransformSystem() { return transformSystem_; }  // Entity transforms, updated after LateUpdate
 
-    // Entity management
+    // Entity management. Destruction is deferred to the end of the frame, after which handles to
+    // the entity stay invalid even once its slot is reused
     Entity* CreateEntity(const std::string& name = "Entity");
     void    DestroyEntity(Entity* entity);
+    void    DestroyEntity(EntityHandle handle);  // No-op for dead handles
+    Entity* GetEntity(EntityHandle handle) const; // Null once destroyed
+    bool    IsAlive(EntityHandle handle) const { return GetEntity(handle) != nullptr; }
+    // In no particular order: a destroyed entity's place is taken by the last one
     const std::vector<UniquePtr<Entity>>& GetEntities() const { return entities_; }
 
+    // Frustum culling - enabled entities with a mesh, tested against the culling camera.
+    // The list is rebuilt on first use in each Render phase, or after the camera changes,
+    // so the camera can be set from OnRender right before iterating. Without a camera
+    // every renderable is visible
+    void SetCullingCamera(const Mat4& viewProjection);
+    void ClearCullingCamera();
+    const std::vector<Entity*>& GetVisibleEntities();
+
+    // Ray, frustum and overlap queries over enabled entities with a mesh, by world bounds.
+    // Brought up to date with the entities' transforms on first use each frame
+    SceneBVH& GetSceneBVH();
+
     // Control
     void Close()           { running_ = false; }
     bool IsRunning() const { return running_; }
@@ -65,6 +93,11 @@ public:
     void SetEventsEnabled(bool enabled) { eventsEnabled_ = enabled; }
     bool AreEventsEnabled() const { return eventsEnabled_; }
 
+    // Behaviours that opted in (Behaviour::DeclareAccess, SetThreadSafe) update across the job system.
+    // Off runs every update on the main thread, handy when hunting a race
+    void SetParallelUpdatesEnabled(bool enabled) { parallelUpdates_ = enabled; }
+    bool AreParallelUpdatesEnabled() const       { return parallelUpdates_; }
+
     // Optional: Hook into input events at Application level (before behaviours)
     // Most code should use Behaviours, but this is available for special cases
     std::function<void(KeyCode, bool)>     OnKeyEvent;         // key, pressed
@@ -82,31 +115,63 @@ protected:
     void Render();
     void PostRender();
     void ProcessDestroyQueue();  // Clean up deferred destructions
+    void CullRenderables();
+    void SyncSceneBVH();
 
     // Behaviour event management
     void RegisterBehaviourForEvents(Behaviour* behaviour);
     void UnregisterBehaviourFromEvents(Behaviour* behaviour);
-    void RunBehaviourEvent(uint32 eventId, std::function<void(Behaviour*)> callback);
+    void QueueBehaviourDestruction(UniquePtr<Behaviour> behaviour);  // Unregisters now, frees in ProcessDestroyQueue
+    bool PrepareBehaviourEventList(uint32 eventId);  // Closes holes and re-sorts, true if the list changed
+    // callback(behaviour) for every enabled behaviour handling the event, in execution order.
+    // Templates so each phase is one loop of direct virtual calls, nothing type-erased
+    template<Behaviour::EventFlag Event, typename Fn> void RunBehaviourEvent(Fn&& callback);
+    template<Behaviour::EventFlag Event, typename Fn> void RunBehaviourUpdate(Fn&& callback);
 
 private:
     // Core systems
     UniquePtr<Window>       window_;
     UniquePtr<Input>        input_;
     UniquePtr<RenderDevice> renderDevice_;
+    UniquePtr<RenderQueue>  renderQueue_;
     
-    // Entities
-    std::vector<UniquePtr<Entity>> entities_;
-    std::vector<Entity*>           entitiesToDestroy_; // deferred destruction
+    // Entities, packed. Handles go through a slot per index, which knows where its entity is
+    struct EntitySlot
+    {
+        uint32 position;    // In entities_, while alive
+        uint32 generation;  // Moves on when the entity is destroyed
+
+        // What the entity's scene BVH bounds were taken from, so ones that didn't move are skipped
+        const Mesh* bvhMesh;              // Null while not in the tree
+        uint32      bvhMeshGeneration;    // Position stream generation
+        uint32      bvhTransformVersion;
+    };
+    // Every entity's transform is a node in here, so it goes before (and outlives) the entities
+    TransformSystem transformSystem_;
+
+    std::vector<UniquePtr<Entity>>    entities_;
+    std::vector<EntitySlot>           entitySlots_;
+    std::vector<uint32>               freeEntitySlots_;
+    std::vector<EntityHandle>         entitiesToDestroy_;    // deferred destruction
+    std::vector<UniquePtr<Behaviour>> behavioursToDestroy_;  // Removed this frame, a running schedule may still hold them
     
     // Event-specific behaviour lists (much faster than iterating all entities!)
-    // Maps event type -> list of behaviours that handle that event
-    std::unordered_map<uint32, std::vector<Behaviour*>> behaviourEventLists_;
-    std::unordered_map<uint32, bool>                    behaviourEventListsDirty_;  // Needs re-sorting
+    // Indexed by event bit -> list of behaviours that handle that event. Unregistering leaves
+    // a null hole (behaviours know their slots), the next run closes them all in one pass
+    std::vector<Behaviour*> behaviourEventLists_[Behaviour::MaxEventFlags];
+    bool                    behaviourEventListsDirty_[Behaviour::MaxEventFlags];  // Needs re-sorting
+    uint32                  behaviourEventListHoles_[Behaviour::MaxEventFlags];
+
+    // EarlyUpdate, Update and LateUpdate lists (the first three bits) split into serial and parallel work
+    static constexpr uint32 UpdateEventCount = 3;
+    BehaviourSchedule updateSchedules_[UpdateEventCount];
+    bool              updateSchedulesDirty_[UpdateEventCount];
     
     // State
     bool running_;
     bool initialized_;
     bool eventsEnabled_;
+    bool parallelUpdates_;
     
     // Time
     float  time_;
@@ -117,8 +182,72 @@ private:
     std::string title_;
     uint32      width_;
     uint32      height_;
+    
+    // Culling
+    CullingSystem        culling_;
+    Frustum              cullingFrustum_;
+    bool                 cullingEnabled_;
+    bool                 visibleDirty_;
+    std::vector<Entity*> renderables_;     // Slot -> entity of the last cull
+    std::vector<uint32>  visibleSlots_;
+    std::vector<Entity*> visibleEntities_;
+    
+    // Scene queries
+    SceneBVH sceneBVH_;
+    bool     sceneBVHDirty_;
+
+    // Worker threads, shared by the engine's systems and behaviours
+    JobSystem jobSystem_;
+
+    // Component store for systems moved off per-entity behaviours
+    World world_;
 };
 
+template<Behaviour::EventFlag Event, typename Fn>
+void Application::RunBehaviourEvent(Fn&& callback)
+{
+    static_assert(std::has_single_bit(static_cast<uint32>(Event)), "RunBehaviourEvent takes a single event");
+    constexpr uint32 eventId = std::countr_zero(static_cast<uint32>(Event));
+
+    // Updates and input can be disabled (useful for pausing), rendering always runs
+    constexpr bool pausable = (Event & (Behaviour::AllUpdate | Behaviour::AllInput)) != 0;
+    if (pausable && !eventsEnabled_)
+        return;
+
+    PrepareBehaviourEventList(eventId);
+
+    // By index: a callback adding behaviours may grow the list, those join next time.
+    // One removing behaviours leaves holes
+    auto& list = behaviourEventLists_[eventId];
+    for (size_t i = 0, count = list.size(); i < count; ++i)
+    {
+        Behaviour* behaviour = list[i];
+        if (behaviour && behaviour->IsEnabled())
+            callback(behaviour);
+    }
+}
+
+template<Behaviour::EventFlag Event, typename Fn>
+void Application::RunBehaviourUpdate(Fn&& callback)
+{
+    constexpr uint32 eventId = std::countr_zero(static_cast<uint32>(Event));
+    static_assert(eventId < UpdateEventCount, "RunBehaviourUpdate takes an update event");
+
+    // Updates pause with the other events
+    if (!eventsEnabled_)
+        return;
+
+    // Re-sort and re-split if behaviours came or went
+    if (PrepareBehaviourEventList(eventId) || updateSchedulesDirty_[eventId])
+    {
+        updateSchedules_[eventId].Build(behaviourEventLists_[eventId]);
+        updateSchedulesDirty_[eventId] = false;
+    }
+
+    // Serial behaviours of each execution order on this thread, then the parallel ones across the jobs
+    updateSchedules_[eventId].Run(parallelUpdates_ ? &jobSystem_ : nullptr, callback);
+}
+
 // Railroad-themed aliases for Application
 // Use whichever name fits your style!
 
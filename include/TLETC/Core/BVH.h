@@ -0,0 +1,48 @@
+#pragma once
+
+#include "TLETC/Core/Types.h"
+#include "TLETC/Core/Math.h"
+
+#include <span>
+#include <vector>
+
+namespace TLETC
+{
+
+/**
+ * BVHNode - One node of a flat bounding volume hierarchy, 32 bytes
+ *
+ * Nodes live in one array with the root at 0 and siblings next to each other, so an
+ * internal node only stores where its pair of children starts. Leaves point at a run
+ * of the primitive order array instead.
+ */
+struct BVHNode
+{
+    Vec3   min;
+    uint32 leftFirst;  // Internal: left child, the right one follows it. Leaf: first entry in the order array
+    Vec3   max;
+    uint32 count;      // Primitives in a leaf, 0 for internal nodes
+
+    bool        IsLeaf() const    { return count > 0; }
+    BoundingBox GetBounds() const { return BoundingBox(min, max); }
+};
+
+static_assert(sizeof(BVHNode) == 32, "BVHNode is meant to be two to a 64-byte cache line");
+
+/**
+ * Binned SAH build over primitive bounds
+ *
+ * Replaces nodes and fills order with primitive indices, leaves refer to runs of it.
+ * Splits are picked by the surface area heuristic over a few bins per axis, and a node
+ * becomes a leaf once splitting costs more than testing what it holds, or at
+ * maxLeafSize primitives or fewer when that is cheaper anyway.
+ */
+void BuildBVH(std::span<const BoundingBox> bounds, uint32 maxLeafSize, std::vector<BVHNode>& nodes, std::vector<uint32>& order);
+
+// Recomputes every node from the primitive bounds, bottom-up. Keeps the topology
+void RefitBVH(std::span<const BoundingBox> bounds, std::span<const uint32> order, std::vector<BVHNode>& nodes);
+
+// SAH cost of the tree, relative to its root - grows as refits stretch nodes over moved primitives
+float GetBVHCost(std::span<const BVHNode> nodes);
+
+} // namespace TLETC
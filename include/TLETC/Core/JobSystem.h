@@ -0,0 +1,194 @@
+#pragma once
+
+#include "TLETC/Core/Types.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace TLETC
+{
+
+class JobCounter;
+
+/**
+ * JobSystem - Worker threads that run small jobs, stealing from each other when idle
+ *
+ * Every worker, and the thread that called Initialize, owns a Chase-Lev deque: the
+ * owner pushes and pops at one end without locking, idle threads steal from the other.
+ * Jobs started from any other thread go through a shared, locked queue.
+ *
+ * Completion is tracked with JobCounters: every job started with a counter adds one,
+ * and takes it off again when done. A job can also be held back until a counter
+ * drains, which is how dependencies are expressed: start the jobs it depends on first,
+ * a counter with nothing pending holds nothing back. Wait runs other jobs while the
+ * counter drains, so the waiting thread is never idle.
+ *
+ * Without Initialize (or with zero workers) jobs run right away on the caller, so
+ * code written against the system works unchanged on a single thread.
+ *
+ * usage : JobCounter done;
+ *         jobs.Run([&]() { LoadA(); }, &done);
+ *         jobs.Run([&]() { LoadB(); }, &done);
+ *         jobs.Run([&]() { Link(); }, nullptr, &done);  // After both loads
+ *         jobs.ParallelFor(count, 256, [&](size_t begin, size_t end) { ... });
+ *         jobs.Wait(done);
+ */
+class JobSystem
+{
+public:
+    JobSystem();
+    ~JobSystem();
+
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    // workerCount 0 starts one worker per hardware thread, minus the calling thread
+    bool Initialize(uint32 workerCount = 0);
+    void Shutdown();  // Runs whatever is still queued, then joins the workers
+
+    bool   IsInitialized() const  { return !workers_.empty(); }
+    uint32 GetWorkerCount() const { return static_cast<uint32>(workers_.size()); }
+    uint32 GetThreadCount() const { return GetWorkerCount() + 1; }  // Workers and the caller of Initialize
+
+    // Starts fn() on some thread. The counter (optional) tracks it, the dependency (optional)
+    // has to drain before it starts
+    template<typename Fn>
+    void Run(Fn&& fn, JobCounter* counter = nullptr, JobCounter* dependency = nullptr);
+
+    // Runs queued jobs on the calling thread until the counter drains
+    void Wait(JobCounter& counter);
+
+    // fn(begin, end) over [0, count) in chunks of at least minGrain, about four per thread.
+    // The caller takes the first chunk and returns once all are done
+    template<typename Fn>
+    void ParallelFor(size_t count, size_t minGrain, Fn&& fn);
+
+private:
+    // Any callable up to StorageSize bytes is stored in place, bigger ones on the heap
+    struct Job
+    {
+        static constexpr size_t StorageSize = 64;
+
+        void      (*run)(Job& job);  // Calls and destroys the stored callable
+        JobCounter* counter;
+        alignas(std::max_align_t) unsigned char storage[StorageSize];
+    };
+
+    class Deque;
+    friend class JobCounter;
+
+    static Job* AllocateJob();
+    static void FreeJob(Job* job);
+
+    void Submit(Job* job, JobCounter* dependency);
+    void Push(Job* job);
+    Job* FindJob(uint32 queueIndex);
+    void Execute(Job* job);
+    void Finish(JobCounter& counter);
+    void WorkerLoop(uint32 queueIndex);
+
+private:
+    std::vector<UniquePtr<Deque>> queues_;   // 0 belongs to the thread that called Initialize
+    std::vector<std::thread>      workers_;
+
+    // Jobs from threads without a deque
+    std::mutex        externalMutex_;
+    std::vector<Job*> externalJobs_;
+
+    // Sleeping workers, woken when jobs are queued
+    std::mutex              sleepMutex_;
+    std::condition_variable wake_;
+    std::atomic<uint32>     queuedJobs_;
+    std::atomic<uint32>     sleepingWorkers_;
+    std::atomic<bool>       running_;
+};
+
+/**
+ * JobCounter - How many jobs started with it are still running
+ *
+ * Jobs that depend on a counter wait on it, parked, and are queued when it drains.
+ * Wait for it (or check IsDone) before it goes out of scope.
+ */
+class JobCounter
+{
+public:
+    JobCounter() : pending_(0) {}
+    ~JobCounter();
+
+    JobCounter(const JobCounter&) = delete;
+    JobCounter& operator=(const JobCounter&) = delete;
+
+    bool   IsDone() const     { return pending_.load(std::memory_order_acquire) == 0; }
+    uint32 GetPending() const { return pending_.load(std::memory_order_acquire); }
+
+private:
+    friend class JobSystem;
+
+    std::atomic<uint32>          pending_;
+    std::mutex                   mutex_;    // Guards the waiters and the final decrement
+    std::vector<JobSystem::Job*> waiters_;  // Jobs held back until the count reaches zero
+};
+
+template<typename Fn>
+void JobSystem::Run(Fn&& fn, JobCounter* counter, JobCounter* dependency)
+{
+    using Callable = std::decay_t<Fn>;
+
+    Job* job = AllocateJob();
+    if constexpr (sizeof(Callable) <= Job::StorageSize && alignof(Callable) <= alignof(std::max_align_t))
+    {
+        new (job->storage) Callable(std::forward<Fn>(fn));
+        job->run = [](Job& self) {
+            Callable* callable = std::launder(reinterpret_cast<Callable*>(self.storage));
+            (*callable)();
+            callable->~Callable();
+        };
+    }
+    else
+    {
+        new (job->storage) Callable*(new Callable(std::forward<Fn>(fn)));
+        job->run = [](Job& self) {
+            Callable* callable = *std::launder(reinterpret_cast<Callable**>(self.storage));
+            (*callable)();
+            delete callable;
+        };
+    }
+
+    job->counter = counter;
+    if (counter)
+        counter->pending_.fetch_add(1, std::memory_order_relaxed);
+    Submit(job, dependency);
+}
+
+template<typename Fn>
+void JobSystem::ParallelFor(size_t count, size_t minGrain, Fn&& fn)
+{
+    if (count == 0)
+        return;
+
+    const size_t grain = std::max<size_t>(std::max<size_t>(minGrain, 1), (count + GetThreadCount() * 4 - 1) / (GetThreadCount() * 4));
+    if (grain >= count || !IsInitialized())
+    {
+        fn(size_t(0), count);
+        return;
+    }
+
+    JobCounter done;
+    for (size_t begin = grain; begin < count; begin += grain)
+    {
+        const size_t end = std::min(count, begin + grain);
+        Run([&fn, begin, end]() { fn(begin, end); }, &done);
+    }
+    fn(size_t(0), grain);
+    Wait(done);
+}
+
+} // namespace TLETC
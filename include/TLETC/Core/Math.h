@@ -6,6 +6,8 @@
 #include <glm/gtc/quaternion.hpp>
 #include <glm/gtx/quaternion.hpp>
 
+#include <algorithm>
+
 namespace TLETC
 {
 
@@ -105,6 +107,111 @@ struct BoundingBox {
                point.y >= min.y && point.y <= max.y &&
                point.z >= min.z && point.z <= max.z;
     }
+    
+    // Box around this one after an affine transform (Arvo: centre moves, extents take |M|)
+    BoundingBox Transformed(const Mat4& m) const {
+        const Vec3 center  = Vec3(m * Vec4(GetCenter(), 1.0f));
+        const Vec3 extents = GetSize() * 0.5f;
+        const Vec3 worldExtents = glm::abs(Vec3(m[0])) * extents.x
+                                + glm::abs(Vec3(m[1])) * extents.y
+                                + glm::abs(Vec3(m[2])) * extents.z;
+        return BoundingBox(center - worldExtents, center + worldExtents);
+    }
+};
+
+// View frustum as six inward-facing planes (xyz normal, w distance), normalized
+struct Frustum {
+    enum Plane { Left, Right, Bottom, Top, Near, Far, Count };
+    
+    Vec4 planes[Count];
+    
+    Frustum() {
+        for (Vec4& plane : planes)
+            plane = Vec4(0.0f, 0.0f, 0.0f, 1.0f);  // Accepts everything
+    }
+    
+    // Gribb-Hartmann: the planes are sums and differences of the matrix rows (GL clip space, z in [-w, w])
+    static Frustum FromMatrix(const Mat4& viewProjection) {
+        const Mat4 m = glm::transpose(viewProjection);
+        Frustum frustum;
+        frustum.planes[Left]   = m[3] + m[0];
+        frustum.planes[Right]  = m[3] - m[0];
+        frustum.planes[Bottom] = m[3] + m[1];
+        frustum.planes[Top]    = m[3] - m[1];
+        frustum.planes[Near]   = m[3] + m[2];
+        frustum.planes[Far]    = m[3] - m[2];
+        for (Vec4& plane : frustum.planes)
+            plane /= glm::length(Vec3(plane));
+        return frustum;
+    }
+    
+    // Conservative: false only if the box is fully behind one plane
+    bool Intersects(const BoundingBox& box) const {
+        const Vec3 center  = box.GetCenter();
+        const Vec3 extents = box.GetSize() * 0.5f;
+        for (const Vec4& plane : planes) {
+            const Vec3 normal = Vec3(plane);
+            if (glm::dot(normal, center) + glm::dot(glm::abs(normal), extents) + plane.w < 0.0f)
+                return false;
+        }
+        return true;
+    }
+    
+    // True only if the box is entirely in front of every plane
+    bool Contains(const BoundingBox& box) const {
+        const Vec3 center  = box.GetCenter();
+        const Vec3 extents = box.GetSize() * 0.5f;
+        for (const Vec4& plane : planes) {
+            const Vec3 normal = Vec3(plane);
+            if (glm::dot(normal, center) - glm::dot(glm::abs(normal), extents) + plane.w < 0.0f)
+                return false;
+        }
+        return true;
+    }
+};
+
+// Half-line from origin along direction (not necessarily unit length, distances are in multiples of it)
+struct Ray {
+    Vec3 origin;
+    Vec3 direction;
+    
+    Ray()
+        : origin(0.0f), direction(0.0f, 0.0f, -1.0f) {}
+    
+    Ray(const Vec3& origin, const Vec3& direction)
+        : origin(origin), direction(direction) {}
+    
+    Vec3 GetPoint(float distance) const {
+        return origin + direction * distance;
+    }
+    
+    // Direction is not renormalized, so distances along the moved ray match the original's
+    Ray Transformed(const Mat4& m) const {
+        return Ray(Vec3(m * Vec4(origin, 1.0f)), Vec3(m * Vec4(direction, 0.0f)));
+    }
+    
+    // Through a point in normalized device coordinates ([-1, 1], y up), for picking under the mouse
+    static Ray FromScreenPoint(const Vec2& ndc, const Mat4& viewProjection) {
+        const Mat4 inverse = glm::inverse(viewProjection);
+        Vec4 nearPoint = inverse * Vec4(ndc.x, ndc.y, -1.0f, 1.0f);
+        Vec4 farPoint  = inverse * Vec4(ndc.x, ndc.y,  1.0f, 1.0f);
+        nearPoint /= nearPoint.w;
+        farPoint  /= farPoint.w;
+        return Ray(Vec3(nearPoint), glm::normalize(Vec3(farPoint - nearPoint)));
+    }
+    
+    // Slab test. distance is where the ray enters the box, 0 if it starts inside
+    bool Intersects(const BoundingBox& box, float maxDistance, float& distance) const {
+        const Vec3 inverse = 1.0f / direction;
+        const Vec3 t0 = (box.min - origin) * inverse;
+        const Vec3 t1 = (box.max - origin) * inverse;
+        const Vec3 tMin = glm::min(t0, t1);
+        const Vec3 tMax = glm::max(t0, t1);
+        const float enter = std::max(std::max(tMin.x, tMin.y), std::max(tMin.z, 0.0f));
+        const float exit  = std::min(std::min(tMax.x, tMax.y), std::min(tMax.z, maxDistance));
+        distance = enter;
+        return enter <= exit;
+    }
 };
 
 } // namespace TLETC
\ No newline at end of file
@@ -0,0 +1,50 @@
+#pragma once
+
+#include "TLETC/Core/Types.h"
+
+#include <map>
+
+namespace TLETC
+{
+
+/**
+ * RangeAllocator - First-fit sub-allocator over a linear range of units
+ *
+ * Only does the bookkeeping; what a unit is (a vertex, an index, a byte) and where
+ * the memory lives is up to the owner. Freed ranges merge with their free neighbours,
+ * so a pool that is emptied is one free range again.
+ *
+ * usage : RangeAllocator vertices(65536);
+ *         size_t first = 0;
+ *         if (!vertices.Allocate(count, first)) { grow, then vertices.Grow(newCapacity); }
+ *         ...
+ *         vertices.Free(first, count);
+ */
+class RangeAllocator
+{
+public:
+    explicit RangeAllocator(size_t capacity = 0);
+
+    // False if no free range is large enough. Zero-sized allocations always succeed at 0
+    bool Allocate(size_t size, size_t& offset);
+
+    // Size must match the allocation
+    void Free(size_t offset, size_t size);
+
+    // Extend the range, existing allocations keep their offsets
+    void Grow(size_t capacity);
+
+    void Reset(size_t capacity);
+
+    size_t GetCapacity() const    { return capacity_; }
+    size_t GetUsed() const        { return used_; }
+    size_t GetLargestFree() const;
+    size_t GetFreeRangeCount() const { return free_.size(); }
+
+private:
+    std::map<size_t, size_t> free_;  // offset -> size, never adjacent
+    size_t                   capacity_;
+    size_t                   used_;
+};
+
+} // namespace TLETC
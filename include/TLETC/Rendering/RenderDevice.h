@@ -3,9 +3,12 @@
 #include "TLETC/Core/Types.h"
 #include "TLETC/Core/Math.h"
 #include "TLETC/Rendering/Handle.h"
+#include "TLETC/Rendering/UniformID.h"
 #include "TLETC/Resources/Mesh.h"
 
+#include <span>
 #include <string>
+#include <string_view>
 
 namespace TLETC 
 {
@@ -37,6 +40,95 @@ enum class PrimitiveType {
     Patches         // For tessellation
 };
 
+// Per-frame counters, reset by BeginFrame (or ResetStats).
+// The resident totals describe the device, not the frame, and survive the reset
+struct RenderStats 
+{
+    uint32 drawCalls           = 0; // API draw calls, a multi-draw counts once
+    uint32 indirectCommands    = 0; // Draws issued through multi-draw indirect
+    uint32 stateChangesIssued  = 0; // State calls that reached the driver
+    uint32 stateChangesSkipped = 0; // State calls filtered out as redundant
+    
+    uint32 meshUploads         = 0; // Mesh buffers (re)uploaded
+    size_t meshUploadBytes     = 0;
+    uint32 meshEvictions       = 0; // Meshes dropped to stay under the memory budget
+    uint32 meshesResident      = 0;
+    size_t meshBytesResident   = 0; // GPU memory held for meshes, shared pools at their full size
+    
+    size_t streamBytes         = 0; // Handed out by AllocateStream (instances included)
+    uint32 streamStalls        = 0; // Frames that had to wait for the GPU to free stream memory
+};
+
+// Per-frame streaming memory, written by the CPU and read by the GPU in the same frame.
+// Valid until EndFrame, never read it back
+struct StreamAllocation
+{
+    BufferHandle buffer;
+    size_t       offset = 0;        // Bytes into buffer, for bind-range / attribute offsets
+    void*        data   = nullptr;  // Write-only
+    size_t       size   = 0;
+    
+    bool IsValid() const { return data != nullptr; }
+};
+
+/**
+ * FrameData - Standard per-frame uniform block, shared by every program that declares it
+ *
+ * Uploaded once per frame by SetFrameData and bound to FrameData::Slot. Programs declaring
+ * the block below are hooked up to the slot when they are linked:
+ *
+ *   layout(std140) uniform FrameData
+ *   {
+ *       mat4 u_view;
+ *       mat4 u_projection;
+ *       mat4 u_viewProjection;
+ *       vec4 u_time;   // x = seconds since start, y = delta time
+ *   };
+ */
+struct FrameData
+{
+    static constexpr uint32 Slot = 0;
+    static constexpr const char* BlockName = "FrameData";
+    
+    Mat4 view;
+    Mat4 projection;
+    Mat4 viewProjection;
+    Vec4 time;
+};
+static_assert(sizeof(FrameData) == 3 * 64 + 16, "FrameData must match the std140 block layout");
+
+/**
+ * ObjectData - Per-object entry of the frame's object storage buffer
+ *
+ * DrawMesh, DrawMeshInstanced and DrawMeshBatch write one entry per object (the normal matrix is
+ * computed once on the CPU) and the draw's base instance points at the first one.
+ * Shaders find their entry through the per-instance index at ObjectData::IndexLocation,
+ * which is base instance + instance, the same value gl_BaseInstance + gl_InstanceID
+ * would give, without needing shader draw parameters:
+ *
+ *   struct ObjectData { mat4 model; mat4 normal; };
+ *   layout(std430, binding = 0) readonly buffer Objects { ObjectData u_objects[]; };
+ *   layout(location = 8) in uint a_objectIndex;
+ *
+ * The model matrix of the same entry is also fed to locations 4-7, for shaders
+ * that take it as an attribute (see assets/shaders/basic_instanced.vert).
+ */
+struct ObjectData
+{
+    static constexpr uint32 Slot          = 0;  // Shader storage binding
+    static constexpr uint32 IndexLocation = 8;
+    
+    Mat4 model;
+    Mat4 normal;  // transpose(inverse(model)), upper 3x3 used
+};
+
+// One mesh drawn once per transform, as part of a DrawMeshBatch
+struct MeshBatch
+{
+    const Mesh*           mesh = nullptr;
+    std::span<const Mat4> transforms;
+};
+
 /**
  * RenderDevice - Abstract interface for rendering APIs
  * 
@@ -62,6 +154,18 @@ public:
     virtual void UpdateBuffer(BufferHandle buffer, const void* data, size_t size, size_t offset = 0) = 0;
     virtual void DestroyBuffer(BufferHandle buffer) = 0;
     
+    // Sub-allocate from the frame's stream buffer - per-draw data, dynamic vertices, uniform blocks.
+    // No driver copies: write through data, then point the GPU at buffer + offset
+    virtual StreamAllocation AllocateStream(size_t size, size_t alignment = 16) = 0;
+    
+    // Uniform buffers - one upload shared by every program whose block is bound to the same slot
+    virtual BufferHandle CreateUniformBuffer(const void* data, size_t size, BufferUsage usage) = 0;
+    virtual void BindUniformBuffer(uint32 slot, BufferHandle buffer, size_t offset = 0, size_t size = 0) = 0; // size 0 = whole buffer
+    virtual void BindUniformBlock(ShaderHandle shader, std::string_view blockName, uint32 slot) = 0;         // GLSL 330 has no layout(binding)
+    
+    // Upload the FrameData block for this frame and bind it to FrameData::Slot
+    virtual void SetFrameData(const Mat4& view, const Mat4& projection, float time, float deltaTime = 0.0f) = 0;
+    
     // Shader operations
     virtual ShaderHandle CreateShader(ShaderType type, const std::string& source) = 0;
     
@@ -92,15 +196,30 @@ public:
     virtual void DestroyShader(ShaderHandle shader) = 0;
     virtual void UseShader(ShaderHandle shader) = 0;
     
-    // Shader uniforms
-    virtual void SetUniformInt(ShaderHandle shader, const std::string& name, int value) = 0;
-    virtual void SetUniformFloat(ShaderHandle shader, const std::string& name, float value) = 0;
-    virtual void SetUniformVec3(ShaderHandle shader, const std::string& name, const Vec3& value) = 0;
-    virtual void SetUniformVec4(ShaderHandle shader, const std::string& name, const Vec4& value) = 0;
-    virtual void SetUniformMat4(ShaderHandle shader, const std::string& name, const Mat4& value) = 0;
+    // Shader uniforms (pre-hashed, no string work or driver lookup)
+    virtual void SetUniformInt(ShaderHandle shader, UniformID id, int value) = 0;
+    virtual void SetUniformFloat(ShaderHandle shader, UniformID id, float value) = 0;
+    virtual void SetUniformVec3(ShaderHandle shader, UniformID id, const Vec3& value) = 0;
+    virtual void SetUniformVec4(ShaderHandle shader, UniformID id, const Vec4& value) = 0;
+    virtual void SetUniformMat4(ShaderHandle shader, UniformID id, const Mat4& value) = 0;
+    
+    // Shader uniforms by name (hashed per call, never allocates)
+    void SetUniformInt(ShaderHandle shader, std::string_view name, int value)           { SetUniformInt(shader, UniformID(name), value); }
+    void SetUniformFloat(ShaderHandle shader, std::string_view name, float value)       { SetUniformFloat(shader, UniformID(name), value); }
+    void SetUniformVec3(ShaderHandle shader, std::string_view name, const Vec3& value)  { SetUniformVec3(shader, UniformID(name), value); }
+    void SetUniformVec4(ShaderHandle shader, std::string_view name, const Vec4& value)  { SetUniformVec4(shader, UniformID(name), value); }
+    void SetUniformMat4(ShaderHandle shader, std::string_view name, const Mat4& value)  { SetUniformMat4(shader, UniformID(name), value); }
     
     // Mesh rendering
     virtual void DrawMesh(const Mesh& mesh, const Mat4& transform, PrimitiveType primitiveType = PrimitiveType::Triangles) = 0;
+    
+    // Draw one mesh once per transform in a single call. Each instance gets its own
+    // ObjectData entry, see ObjectData for how shaders read it
+    virtual void DrawMeshInstanced(const Mesh& mesh, std::span<const Mat4> transforms, PrimitiveType primitiveType = PrimitiveType::Triangles) = 0;
+    
+    // Draw several meshes with the current shader, in order. Meshes sharing vertex storage
+    // are merged into one multi-draw, so a whole pass can be a handful of calls
+    virtual void DrawMeshBatch(std::span<const MeshBatch> batches, PrimitiveType primitiveType = PrimitiveType::Triangles) = 0;
     virtual void DrawIndexed(BufferHandle vertexBuffer, BufferHandle indexBuffer, uint32 indexCount, PrimitiveType primitiveType = PrimitiveType::Triangles) = 0;
     
     // Compute shader operations
@@ -117,10 +236,28 @@ public:
     virtual void EnableCulling(bool enable) = 0;
     virtual void SetWireframeMode(bool enable) = 0;
     
+    // Frustum-cull the instances of DrawMeshBatch on the GPU, against the FrameData camera.
+    // Survivors keep their order, so sorted (transparent) batches stay sorted.
+    // Only batched meshes in shared vertex storage are culled. Meshes with their own
+    // buffers (non-interleaved or quantized positions) and DrawMesh / DrawMeshInstanced
+    // are always drawn in full - cull those on the CPU (CullingSystem)
+    virtual void EnableGpuCulling(bool enable) = 0;
+    
+    // Statistics
+    virtual const RenderStats& GetStats() const = 0;
+    virtual void ResetStats() = 0;
+    
+    // Mesh residency - GPU memory for mesh buffers, least recently drawn meshes are
+    // evicted (and re-uploaded when drawn again) once it is exceeded. Shared vertex storage
+    // counts whole and shrinks once evictions leave it mostly empty. 0 = unlimited
+    virtual void   SetMeshMemoryBudget(size_t bytes) = 0;
+    virtual size_t GetMeshMemoryBudget() const = 0;
+    
     // Query
     virtual const int   GetMaxTessLevel() const = 0;
     virtual const char* GetRendererName() const = 0;
     virtual const char* GetAPIVersion() const = 0;
+    virtual size_t      GetUniformBufferAlignment() const = 0; // Required offset alignment for BindUniformBuffer
 };
 
 // ============================================================================
@@ -0,0 +1,94 @@
+#pragma once
+
+#include "TLETC/Core/Types.h"
+#include "TLETC/Core/Math.h"
+#include "TLETC/Rendering/Handle.h"
+#include "TLETC/Rendering/RenderDevice.h"
+#include "TLETC/Resources/Mesh.h"
+
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace TLETC
+{
+// Render passes, flushed in this order
+enum class RenderPass : uint8
+{
+    Opaque      = 0,  // Front to back
+    Transparent = 1,  // Back to front
+    Overlay     = 2   // Front to back, drawn last
+};
+
+/**
+ * RenderQueue - Deferred, sorted draw submission
+ *
+ * Draws submitted during the Render phase are collected, sorted by a 64-bit key
+ * and flushed once at the end of the phase. Consecutive draws of the same mesh with
+ * the same shader are merged into one instanced batch, every batch of a shader goes to
+ * the device in one DrawMeshBatch (a multi-draw for meshes in shared vertex storage),
+ * and the program is only switched when the shader actually changes.
+ *
+ * Key layout (high to low bits):
+ *   Opaque/Overlay : pass(8) | shader(16) | mesh(16) | depth(24)
+ *   Transparent    : pass(8) | inverted depth(24) | shader(16) | mesh(16)
+ *
+ * Every draw goes through DrawMeshBatch, so queued shaders read the model matrix
+ * from their ObjectData entry (see assets/shaders/basic.vert) or the instance attribute
+ * (see assets/shaders/basic_instanced.vert). Camera matrices
+ * come from the FrameData block (RenderDevice::SetFrameData); other uniforms shared by a
+ * whole pass (lights) are set by the caller before the flush.
+ */
+class RenderQueue
+{
+public:
+    struct Stats
+    {
+        uint32 commands      = 0;  // Draws submitted
+        uint32 drawCalls     = 0;  // DrawMeshBatch calls issued
+        uint32 meshBatches   = 0;  // Runs of one mesh, one instanced draw each
+        uint32 shaderChanges = 0;  // UseShader calls issued
+    };
+
+    RenderQueue();
+    ~RenderQueue();
+
+    // Queue a draw. Depth is the distance from the view position to the transform's origin
+    void Submit(const Mesh& mesh, ShaderHandle shader, const Mat4& transform, RenderPass pass = RenderPass::Opaque, PrimitiveType primitiveType = PrimitiveType::Triangles);
+
+    // Sort, batch and issue every queued draw, then clear the queue
+    void Flush(RenderDevice& device);
+
+    // Drop every queued draw without issuing it
+    void Clear();
+
+    // Camera position used for depth sorting
+    void SetViewPosition(const Vec3& position) { viewPosition_ = position; }
+    const Vec3& GetViewPosition() const        { return viewPosition_; }
+
+    size_t       GetCommandCount() const { return commands_.size(); }
+    const Stats& GetStats() const        { return stats_; } // Of the last flush
+
+    static uint64 MakeSortKey(RenderPass pass, uint16 shader, uint16 mesh, float depth);
+
+private:
+    struct Command
+    {
+        const Mesh*   mesh;
+        ShaderHandle  shader;
+        PrimitiveType primitiveType;
+        Mat4          transform;
+    };
+
+    uint16 GetMeshKey(const Mesh* mesh);
+
+    std::vector<Command>                    commands_;
+    std::vector<std::pair<uint64, uint32>>  keys_;       // sort key, command index
+    std::vector<Mat4>                       instances_;  // scratch for merged runs
+    std::vector<MeshBatch>                  batches_;    // scratch, spans into instances_
+    std::unordered_map<const Mesh*, uint16> meshKeys_;   // dense per-frame mesh ids
+    Vec3                                    viewPosition_;
+    Stats                                   stats_;
+};
+
+} // namespace TLETC
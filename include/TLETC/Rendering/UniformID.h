@@ -0,0 +1,46 @@
+#pragma once
+
+#include "TLETC/Core/Types.h"
+
+#include <string_view>
+
+namespace TLETC
+{
+/**
+ * UniformID - Pre-hashed shader uniform name
+ *
+ * Hashing happens once, when the ID is built (at compile time for constexpr IDs),
+ * so setting a uniform through an ID is a table lookup with no string work.
+ *
+ * usage : static constexpr UniformID ModelID("u_model");
+ *         renderer->SetUniformMat4(shader, ModelID, model);
+ */
+class UniformID
+{
+public:
+    constexpr UniformID() : hash_(0) {}
+    constexpr explicit UniformID(std::string_view name) : hash_(Hash(name)) {}
+
+    constexpr bool   IsValid() const { return hash_ != 0; }
+    constexpr uint32 GetHash() const { return hash_; }
+
+    constexpr bool operator==(const UniformID& other) const { return hash_ == other.hash_; }
+    constexpr bool operator!=(const UniformID& other) const { return hash_ != other.hash_; }
+
+    // 32-bit FNV-1a
+    static constexpr uint32 Hash(std::string_view name)
+    {
+        uint32 hash = 2166136261u;
+        for (char c : name)
+        {
+            hash ^= static_cast<uint8>(c);
+            hash *= 16777619u;
+        }
+        return hash;
+    }
+
+private:
+    uint32 hash_;
+};
+
+} // namespace TLETC
@@ -2,16 +2,56 @@
 
 #include "TLETC/Core/Types.h"
 #include "TLETC/Core/Math.h"
+#include "TLETC/Resources/VertexLayout.h"
 
+#include <array>
+#include <limits>
+#include <span>
 #include <vector>
 
 namespace TLETC 
 {
-// Mesh class - holds geometry data
+// Vertices (or indices) [begin, end) written since the render device last synced
+struct DirtyRange
+{
+    static constexpr size_t All = std::numeric_limits<size_t>::max();
+    
+    size_t begin = 0;
+    size_t end   = 0;
+    
+    bool IsEmpty() const { return begin >= end; }
+    
+    void Add(size_t first, size_t count)
+    {
+        const size_t last = count > All - first ? All : first + count;
+        if (IsEmpty()) { begin = first; end = last; return; }
+        begin = first < begin ? first : begin;
+        end   = last > end ? last : end;
+    }
+};
+
+/**
+ * Mesh - holds geometry data
+ *
+ * Every mesh carries a stable ID (unique for the lifetime of the process, never reused)
+ * and generation counters that render devices compare against what they uploaded.
+ * Copies are new meshes with new IDs; assignment keeps the ID and marks everything changed.
+ *
+ * Edits through setters mark only the touched stream and vertex range, so a deforming
+ * mesh re-uploads just what moved. The stream getters are read-only and mark nothing;
+ * Edit* hands out a writable span and marks only that range (the whole stream by default).
+ *
+ * usage : auto positions = mesh.EditVertexPositions(first, count);
+ *         for (Vec3& p : positions) p.y += wave;
+ */
 class Mesh 
 {
 public:
     Mesh();
+    Mesh(const Mesh& other);
+    Mesh(Mesh&& other) noexcept;
+    Mesh& operator=(const Mesh& other);
+    Mesh& operator=(Mesh&& other) noexcept;
     ~Mesh();
 
     // Vertex data management
@@ -37,10 +77,12 @@ public:
     const std::vector<Vec2>& GetVertexUVs()       const { return uvs_; }
     const std::vector<Vec4>& GetVertexColors()    const { return colors_; }
 
-    std::vector<Vec3>& GetVertexPositions() { return positions_; }
-    std::vector<Vec3>& GetVertexNormals()   { return normals_; }
-    std::vector<Vec2>& GetVertexUVs()       { return uvs_; }
-    std::vector<Vec4>& GetVertexColors()    { return colors_; }
+    // Writable window over [first, first + count) of a stream, marks just that range. No count
+    // runs to the end of the stream
+    std::span<Vec3> EditVertexPositions(size_t first = 0, size_t count = DirtyRange::All) { MarkDirty(VertexStream::Position, first, count); return std::span<Vec3>(positions_).subspan(first, count); }
+    std::span<Vec3> EditVertexNormals(size_t first = 0, size_t count = DirtyRange::All)   { MarkDirty(VertexStream::Normal, first, count);   return std::span<Vec3>(normals_).subspan(first, count); }
+    std::span<Vec2> EditVertexUVs(size_t first = 0, size_t count = DirtyRange::All)       { MarkDirty(VertexStream::UV, first, count);       return std::span<Vec2>(uvs_).subspan(first, count); }
+    std::span<Vec4> EditVertexColors(size_t first = 0, size_t count = DirtyRange::All)    { MarkDirty(VertexStream::Color, first, count);    return std::span<Vec4>(colors_).subspan(first, count); }
     
     // Index data management
     void AddIndex(uint32 index);
@@ -49,7 +91,7 @@ public:
     
     void SetIndices(const std::vector<uint32>& indices);
     const std::vector<uint32>& GetIndices() const { return indices_; }
-    std::vector<uint32>& GetIndices() { return indices_; }
+    std::span<uint32> EditIndices(size_t first = 0, size_t count = DirtyRange::All) { MarkIndicesDirty(first, count); return std::span<uint32>(indices_).subspan(first, count); }
     
     // Queries
     size_t GetVertexCount() const   { return positions_.size(); }
@@ -59,12 +101,42 @@ public:
     bool IsEmpty()   const { return positions_.empty(); }
     bool IsIndexed() const { return !indices_.empty(); }
     
+    // GPU vertex layout and VertexCompression flags, applied when the mesh is uploaded
+    void         SetVertexLayout(VertexLayout layout)    { layout_ = layout; MarkFormatDirty(); }
+    VertexLayout GetVertexLayout() const                 { return layout_; }
+    void         SetVertexCompression(uint32 compression) { compression_ = compression; MarkFormatDirty(); }
+    uint32       GetVertexCompression() const            { return compression_; }
+    
+    // Identity and change tracking
+    uint32 GetID() const                              { return id_; }
+    uint32 GetGeneration() const                      { return generation_; }  // Bumped by any change
+    uint32 GetStreamGeneration(VertexStream s) const  { return streamGenerations_[static_cast<size_t>(s)]; }
+    uint32 GetIndexGeneration() const                 { return indexGeneration_; }
+    uint32 GetFormatGeneration() const                { return formatGeneration_; } // Layout or compression
+    
+    void MarkDirty(VertexStream stream, size_t first = 0, size_t count = DirtyRange::All);
+    void MarkIndicesDirty(size_t first = 0, size_t count = DirtyRange::All);
+    void MarkAllDirty();
+    
+    // Ranges written since the last ClearDirtyRanges, unbounded ends mean "to the end of the stream".
+    // Consumed by the render device when it syncs its copy
+    const DirtyRange& GetDirtyRange(VertexStream stream) const { return dirtyRanges_[static_cast<size_t>(stream)]; }
+    const DirtyRange& GetIndexDirtyRange() const               { return indexDirtyRange_; }
+    void              ClearDirtyRanges() const;
+    
+    // GPU residency - render devices flag meshes they cache, so they hear about their destruction
+    void MarkResident() const { resident_ = true; }
+    
+    // IDs of resident meshes destroyed since the last call (thread-safe)
+    static void CollectDestroyed(std::vector<uint32>& ids);
+    
     // Utility
     void Clear();
     void Reserve(size_t vertexCount, size_t indexCount = 0);
     
     // Calculate mesh properties
-    BoundingBox CalculateBoundingBox() const;
+    BoundingBox        CalculateBoundingBox() const;
+    const BoundingBox& GetBoundingBox() const;  // Cached, recalculated when positions change
     void RecalculateNormals();
     void RecalculateTangents();
     
@@ -83,6 +155,26 @@ protected:
 
     // mesh indices
     std::vector<uint32> indices_;
+    
+    VertexLayout layout_;
+    uint32       compression_;
+
+private:
+    void MarkFormatDirty() { ++formatGeneration_; ++generation_; }
+    
+    uint32                id_;
+    uint32                generation_;
+    std::array<uint32, 4> streamGenerations_;  // Indexed by VertexStream
+    uint32                indexGeneration_;
+    uint32                formatGeneration_;
+    mutable bool          resident_;
+    
+    mutable BoundingBox bounds_;
+    mutable uint32      boundsGeneration_;  // Position generation bounds_ was taken at
+    mutable bool        boundsValid_;
+    
+    mutable std::array<DirtyRange, 4> dirtyRanges_;
+    mutable DirtyRange                indexDirtyRange_;
 };
 
 // ============================================================================
@@ -0,0 +1,96 @@
+#pragma once
+
+#include "TLETC/Core/Types.h"
+#include "TLETC/Core/Math.h"
+#include "TLETC/Core/BVH.h"
+
+#include <span>
+#include <vector>
+
+namespace TLETC
+{
+
+class Mesh;
+class JobSystem;
+
+struct MeshRaycastHit
+{
+    static constexpr uint32 NoTriangle = ~0u;
+
+    float  distance = 0.0f;
+    uint32 triangle = NoTriangle;  // Index of the triangle in the mesh (indices / 3)
+    Vec2   barycentric;            // Weights of the triangle's second and third vertex
+
+    bool IsHit() const { return triangle != NoTriangle; }
+};
+
+/**
+ * MeshBVH - Triangle bounding volume hierarchy over one mesh, for exact ray queries
+ *
+ * Built on demand from a mesh's positions and indices (binned SAH, 32-byte BVHNode).
+ * Leaves hold up to four triangles, stored pre-transposed so one SIMD Möller-Trumbore
+ * test covers the whole leaf. Triangles count from both sides.
+ *
+ * Queries are in mesh space: move world rays in with the inverse of the world matrix
+ * (Ray::Transformed keeps distances comparable). The mesh is not referenced after the
+ * build; rebuild when IsCurrent says its positions or indices changed.
+ *
+ * Batched queries split the rays over a JobSystem's threads and are safe to run concurrently with
+ * other queries on the same BVH.
+ *
+ * usage : MeshBVH bvh(mesh);
+ *         MeshRaycastHit hit;
+ *         if (bvh.Raycast(worldRay.Transformed(inverse(world)), 1000.0f, hit)) ...
+ */
+class MeshBVH
+{
+public:
+    MeshBVH();
+    explicit MeshBVH(const Mesh& mesh);
+
+    // False if the mesh has no triangles
+    bool Build(const Mesh& mesh);
+    void Clear();
+
+    bool IsBuilt() const { return !nodes_.empty(); }
+    bool IsCurrent(const Mesh& mesh) const;  // Built from this mesh, and it hasn't changed since
+
+    // Closest triangle along the ray within maxDistance
+    bool Raycast(const Ray& ray, float maxDistance, MeshRaycastHit& hit) const;
+
+    // Any triangle along the ray within maxDistance - stops at the first, for shadow and visibility rays
+    bool Occluded(const Ray& ray, float maxDistance) const;
+
+    // One result per ray. Split across the job system when given one, small batches stay on the caller's thread
+    void Raycast(std::span<const Ray> rays, float maxDistance, std::span<MeshRaycastHit> hits, JobSystem* jobs = nullptr) const;
+    void Occluded(std::span<const Ray> rays, float maxDistance, std::span<uint8> occluded, JobSystem* jobs = nullptr) const;
+
+    size_t GetTriangleCount() const { return triangleCount_; }
+    size_t GetNodeCount() const     { return nodes_.size(); }
+    size_t GetMemoryUsage() const;  // Bytes held by nodes and triangle packets
+
+private:
+    // Four triangles as vertex 0 and the two edges from it, one float per lane
+    struct alignas(16) TrianglePacket
+    {
+        float  v0x[4], v0y[4], v0z[4];
+        float  e1x[4], e1y[4], e1z[4];
+        float  e2x[4], e2y[4], e2z[4];
+        uint32 triangles[4];
+    };
+
+    template<bool AnyHit>
+    bool Traverse(const Ray& ray, float maxDistance, MeshRaycastHit& hit) const;
+
+    std::vector<BVHNode>        nodes_;    // Leaves point at their packet, count is its used lanes
+    std::vector<TrianglePacket> packets_;
+    size_t                      triangleCount_;
+    uint32                      depth_;    // Sizes the traversal stack
+
+    // What the BVH was built from
+    uint32 meshID_;
+    uint32 positionGeneration_;
+    uint32 indexGeneration_;
+};
+
+} // namespace TLETC
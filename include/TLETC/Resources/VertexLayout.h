@@ -0,0 +1,145 @@
+#pragma once
+
+#include "TLETC/Core/Types.h"
+#include "TLETC/Core/Math.h"
+
+#include <span>
+#include <vector>
+
+namespace TLETC
+{
+
+// Forward declaration
+class Mesh;
+
+// How a mesh's vertex streams are stored on the GPU
+enum class VertexLayout : uint8
+{
+    Separate,    // One buffer per stream (position, normal, uv, color)
+    Interleaved  // One buffer, all attributes of a vertex packed together
+};
+
+// Source stream in Mesh an attribute is read from
+enum class VertexStream : uint8
+{
+    Position,
+    Normal,
+    UV,
+    Color
+};
+
+// Component type of an attribute in GPU memory
+enum class VertexAttribType : uint8
+{
+    Float32,
+    Float16,
+    Int16,
+    UInt16,
+    UInt8
+};
+
+// How a stream's values are transformed before they are stored
+enum class VertexEncoding : uint8
+{
+    Direct,      // Stored as-is (converted/normalized to the attribute type)
+    Octahedral,  // Unit vector folded onto 2 components, decode in the shader
+    Bounds       // Position remapped to [0,1] inside the mesh bounding box
+};
+
+/**
+ * VertexCompression - Optional compact GPU encodings, combined as bit flags
+ *
+ * OctahedralNormals and QuantizedPositions need decoding in the vertex shader,
+ * see assets/shaders/basic_compact.vert. The others decode in the vertex fetch.
+ */
+struct VertexCompression
+{
+    enum Flag : uint32
+    {
+        None               = 0,
+        OctahedralNormals  = 1 << 0,  // 2x snorm16         12 -> 4 bytes
+        HalfUVs            = 1 << 1,  // 2x float16          8 -> 4 bytes
+        Unorm16UVs         = 1 << 2,  // 2x unorm16, [0,1]   8 -> 4 bytes
+        Unorm8Colors       = 1 << 3,  // RGBA8              16 -> 4 bytes
+        QuantizedPositions = 1 << 4,  // 3x unorm16 + pad   12 -> 8 bytes
+
+        // Common combinations
+        Compact = OctahedralNormals | HalfUVs | Unorm8Colors,   // 48 -> 24 bytes
+        Smallest = Compact | QuantizedPositions                 // 48 -> 20 bytes
+    };
+};
+
+// Index element size in GPU memory
+enum class IndexType : uint8
+{
+    UInt16,
+    UInt32
+};
+
+// One attribute of a packed vertex
+struct VertexAttribute
+{
+    VertexStream     stream;
+    uint32           location;    // Shader input location
+    VertexAttribType type;
+    uint32           components;
+    bool             normalized;  // Integer types read as [0,1] / [-1,1]
+    uint32           offset;      // Bytes from the start of the vertex
+    VertexEncoding   encoding;
+};
+
+/**
+ * VertexFormat - Byte layout of one packed vertex
+ *
+ * Attributes are laid out in the order they are added, each one directly after the previous.
+ *
+ * usage : VertexFormat format = VertexFormat::Standard();
+ *         std::vector<uint8> bytes = PackVertices(mesh, format);
+ */
+class VertexFormat
+{
+public:
+    VertexFormat() : stride_(0) {}
+
+    VertexFormat& Add(VertexStream stream, uint32 location, VertexAttribType type, uint32 components, bool normalized = false, VertexEncoding encoding = VertexEncoding::Direct);
+
+    const std::vector<VertexAttribute>& GetAttributes() const { return attributes_; }
+    uint32 GetStride() const { return stride_; }
+
+    // Full float vertex: position(3) normal(3) uv(2) color(4) = 48 bytes
+    static VertexFormat Standard();
+
+    // Standard layout with the given VertexCompression flags applied
+    static VertexFormat Create(uint32 compression);
+
+    bool HasQuantizedPositions() const;
+
+    // Format holding a single attribute of this one, for one-buffer-per-stream uploads
+    VertexFormat Extract(size_t attributeIndex) const;
+
+    static uint32 GetTypeSize(VertexAttribType type);
+
+private:
+    std::vector<VertexAttribute> attributes_;
+    uint32                       stride_;
+};
+
+// Pack a mesh's SoA streams into one strided buffer laid out as described by format.
+// Quantized positions are stored relative to bounds; decode with min + q * (max - min)
+std::vector<uint8> PackVertices(const Mesh& mesh, const VertexFormat& format);
+std::vector<uint8> PackVertices(const Mesh& mesh, const VertexFormat& format, const BoundingBox& bounds);
+
+// Pack only vertices [firstVertex, firstVertex + vertexCount), for partial re-uploads
+std::vector<uint8> PackVertices(const Mesh& mesh, const VertexFormat& format, const BoundingBox& bounds, size_t firstVertex, size_t vertexCount);
+
+// Smallest index type able to address vertexCount vertices
+IndexType SelectIndexType(size_t vertexCount);
+
+// Narrow 32-bit indices to 16 bits, every index must be below 65536
+std::vector<uint16> NarrowIndices(std::span<const uint32> indices);
+
+// Octahedral unit vector encoding, components in [-1,1]
+Vec2 EncodeOctahedral(const Vec3& n);
+Vec3 DecodeOctahedral(const Vec2& e);
+
+} // namespace TLETC
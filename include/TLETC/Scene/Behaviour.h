@@ -11,6 +11,8 @@ namespace TLETC
 
 // Forward declarations
 class Entity;
+class JobSystem;
+class World;
 
 /**
  * Behaviour - Base class for all game logic components
@@ -49,6 +51,19 @@ enum EventFlag : uint32
 };
 static const uint32 MaxEventFlags = 10; 
 
+/**
+ * Bit flags for the parts of its own entity a behaviour's update callbacks touch
+ * Declaring them lets those updates run in parallel (see DeclareAccess)
+ */
+enum DataFlag : uint32
+{
+    NoData        = 0,
+    TransformData = 1 << 0,  // Local position, rotation and scale (world matrices resolve parents, keep those serial)
+    MeshData      = 1 << 1,  // Meshes are shared between entities, so these all run as one task
+    EntityData    = 1 << 2,  // Name and enabled state
+    UserData      = 1 << 8,  // First bit free for game-defined data, shift up from here
+};
+
 public:
     Behaviour();
     virtual ~Behaviour();
@@ -92,6 +107,21 @@ public:
     bool HasEvent(const uint32 flag) const    { return (eventFlags_ & flag) != 0;}
     void ClearEvents()                        { eventFlags_ = EventFlag::None; }
 
+    // Parallel updates (opt-in) - set these before the behaviour is added, like the events.
+    // Within one execution order, OnEarlyUpdate/OnUpdate/OnLateUpdate of behaviours that opted in
+    // run across the job system, the others one by one on the main thread as before.
+    //   - declared access: the callbacks touch nothing but these parts of their own entity and the
+    //     behaviour's own members. Behaviours on one entity share a thread when their access conflicts
+    //   - thread-safe: the callbacks synchronise whatever they touch themselves
+    // example - DeclareAccess(DataFlag::TransformData, DataFlag::TransformData);  // Spins its own entity
+    void   DeclareAccess(const uint32 reads, const uint32 writes) { reads_ = reads; writes_ = writes; accessDeclared_ = true; }
+    uint32 GetReads() const                { return reads_; }
+    uint32 GetWrites() const               { return writes_; }
+    bool   HasDeclaredAccess() const       { return accessDeclared_; }
+    void   SetThreadSafe(const bool safe)  { threadSafe_ = safe; }
+    bool   IsThreadSafe() const            { return threadSafe_; }
+    bool   RunsInParallel() const          { return threadSafe_ || accessDeclared_; }
+
     // Entity access
     Entity* GetEntity() const { return entity_; }
     
@@ -102,12 +132,26 @@ protected:
     // Helper to get input (if entity has access to it)
     Input* GetInput() const;
 
+    // The application's job system, for splitting heavy work across threads (null outside an application)
+    JobSystem* GetJobSystem() const;
+
+    // The application's component world, for systems that iterate components instead of entities
+    World* GetWorld() const;
+
 private:
     friend class Entity;
+    friend class Application;
+    static constexpr uint32 NoEventSlot = ~0u;
+
     Entity* entity_;
     bool    enabled_;
     uint16  executionOrder_;  
     uint32  eventFlags_;
+    uint32  reads_;
+    uint32  writes_;
+    bool    accessDeclared_;
+    bool    threadSafe_;
+    uint32  eventSlots_[MaxEventFlags];  // Position in each of the application's event lists, NoEventSlot if not in it
 };
 
 // ============================================================================
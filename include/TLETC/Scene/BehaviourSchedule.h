@@ -0,0 +1,92 @@
+#pragma once
+
+#include "TLETC/Core/Types.h"
+#include "TLETC/Core/JobSystem.h"
+#include "TLETC/Scene/Behaviour.h"
+
+#include <vector>
+
+namespace TLETC
+{
+
+/**
+ * BehaviourSchedule - One update phase's behaviours, split into what may run in parallel
+ *
+ * Built from a list sorted by execution order. Every execution order becomes a batch, and
+ * batches run strictly one after another, so lower orders still finish before higher ones
+ * start. Within a batch the behaviours that didn't opt in run first, one by one on the
+ * calling thread in list order, then the ones that did run as tasks across the job system:
+ *   - a thread-safe behaviour is a task of its own
+ *   - behaviours with declared access are grouped per entity, and the ones on an entity
+ *     whose reads and writes overlap share a task, run in list order
+ *   - all that touch MeshData share one task, whatever their entity, since meshes are shared
+ *
+ * usage : schedule.Build(sortedUpdateList);
+ *         schedule.Run(&jobs, [dt](Behaviour* b) { b->OnUpdate(dt); });
+ */
+class BehaviourSchedule
+{
+public:
+    BehaviourSchedule() = default;
+
+    void Build(const std::vector<Behaviour*>& sorted);
+    void Clear();
+
+    // fn(behaviour) for every enabled behaviour. Without a job system everything runs on the caller
+    template<typename Fn>
+    void Run(JobSystem* jobs, Fn&& fn) const;
+
+    size_t GetBatchCount() const    { return batches_.size(); }
+    size_t GetSerialCount() const   { return serial_.size(); }
+    size_t GetParallelCount() const { return parallel_.size(); }
+    size_t GetTaskCount() const     { return taskStarts_.empty() ? 0 : taskStarts_.size() - 1; }
+
+private:
+    static constexpr size_t MinTasksPerJob = 16;  // Updates are short, hand them out in bunches
+
+    struct Batch
+    {
+        uint32 serialBegin, serialEnd;  // Range in serial_
+        uint32 taskBegin, taskEnd;      // Range of tasks, task t is parallel_[taskStarts_[t], taskStarts_[t + 1])
+    };
+
+    void AddTasks(std::vector<Behaviour*>& threadSafe, std::vector<Behaviour*>& declared);
+
+private:
+    std::vector<Batch>      batches_;
+    std::vector<Behaviour*> serial_;
+    std::vector<Behaviour*> parallel_;    // Task by task
+    std::vector<uint32>     taskStarts_;  // First behaviour of each task in parallel_, then parallel_.size()
+};
+
+template<typename Fn>
+void BehaviourSchedule::Run(JobSystem* jobs, Fn&& fn) const
+{
+    auto runTasks = [&](size_t begin, size_t end) {
+        for (uint32 i = taskStarts_[begin]; i < taskStarts_[end]; ++i)
+        {
+            if (parallel_[i]->IsEnabled())
+                fn(parallel_[i]);
+        }
+    };
+
+    for (const Batch& batch : batches_)
+    {
+        for (uint32 i = batch.serialBegin; i < batch.serialEnd; ++i)
+        {
+            if (serial_[i]->IsEnabled())
+                fn(serial_[i]);
+        }
+
+        // Tasks are contiguous, so a range of them is a range of behaviours
+        const size_t taskCount = batch.taskEnd - batch.taskBegin;
+        if (taskCount == 0)
+            continue;
+        if (jobs && taskCount > 1)
+            jobs->ParallelFor(taskCount, MinTasksPerJob, [&](size_t begin, size_t end) { runTasks(batch.taskBegin + begin, batch.taskBegin + end); });
+        else
+            runTasks(batch.taskBegin, batch.taskEnd);
+    }
+}
+
+} // namespace TLETC
@@ -0,0 +1,31 @@
+#pragma once
+
+#include "TLETC/Core/Types.h"
+#include "TLETC/Core/Math.h"
+
+namespace TLETC
+{
+
+class Mesh;
+
+// Plain-data components for the World. Transform works as one too (see World)
+
+// Mesh to draw the entity with, not owned
+struct MeshRef
+{
+    const Mesh* mesh = nullptr;
+};
+
+// World-space bounds, kept up to date by whoever moves the entity
+struct Bounds
+{
+    BoundingBox world;
+};
+
+struct Velocity
+{
+    Vec3 linear  = Vec3(0.0f);  // Units per second
+    Vec3 angular = Vec3(0.0f);  // Rotation axis scaled by degrees per second
+};
+
+} // namespace TLETC
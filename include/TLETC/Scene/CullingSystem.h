@@ -0,0 +1,54 @@
+#pragma once
+
+#include "TLETC/Core/Types.h"
+#include "TLETC/Core/Math.h"
+
+#include <vector>
+
+namespace TLETC
+{
+
+/**
+ * CullingSystem - World-space bounds tested against a view frustum, several at a time
+ *
+ * Boxes are kept as centre and half-extent arrays (one array per component), so a frustum
+ * plane is tested against a whole register of boxes with a handful of multiply-adds:
+ * eight boxes per step with AVX, four with SSE, one at a time elsewhere. What gets
+ * compiled is picked by the target flags (TLETC_ENABLE_AVX turns AVX on).
+ *
+ * Slots are plain indices in insertion order, mapping them back to objects is up to the
+ * owner. The visible list comes out compact and in ascending slot order.
+ *
+ * usage : culling.Clear();
+ *         for (Entity* e : renderables) culling.Add(e->mesh->GetBoundingBox().Transformed(world));
+ *         culling.Cull(Frustum::FromMatrix(projection * view), visible);
+ *         for (uint32 slot : visible) Draw(renderables[slot]);
+ */
+class CullingSystem
+{
+public:
+    CullingSystem();
+
+    void Clear();
+    void Reserve(size_t count);
+
+    // World-space bounds, returns the slot
+    uint32      Add(const BoundingBox& bounds);
+    void        Set(uint32 slot, const BoundingBox& bounds);
+    BoundingBox Get(uint32 slot) const;
+    size_t      GetCount() const { return count_; }
+
+    // Replaces visible with the slots that touch the frustum, returns how many there are
+    size_t Cull(const Frustum& frustum, std::vector<uint32>& visible) const;
+
+    // Boxes tested per step by Cull on this build
+    static uint32 GetLaneCount();
+
+private:
+    // Capacity is kept a multiple of the widest lane count, so full-width loads never run off the end
+    std::vector<float> centerX_, centerY_, centerZ_;
+    std::vector<float> extentX_, extentY_, extentZ_;
+    size_t             count_;
+};
+
+} // namespace TLETC
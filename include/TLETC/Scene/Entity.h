@@ -16,6 +16,18 @@ namespace TLETC
 // forward declaration
 class Application;
 
+// An entity of an Application: slot index plus the generation of that slot, so handles to destroyed entities stay dead
+struct EntityHandle
+{
+    static constexpr uint32 NoIndex = ~0u;
+
+    uint32 index      = NoIndex;
+    uint32 generation = 0;
+
+    bool IsValid() const { return index != NoIndex; }
+    bool operator==(const EntityHandle& other) const = default;
+};
+
 /**
  * Entity - A game object that can have behaviours attached
  * 
@@ -26,7 +38,8 @@ class Entity
 {
     friend class Application;
 public:
-    Entity(const std::string& name = "Entity");
+    // The transform is a node of the given system, which has to outlive the entity
+    explicit Entity(TransformSystem& transforms, const std::string& name = "Entity");
     ~Entity();
 
     // Transform
@@ -86,7 +99,7 @@ public:
         return result;
     }
 
-    void RemoveBehaviour(Behaviour* behaviour);
+    void RemoveBehaviour(Behaviour* behaviour);  // OnDestroy now, freed at the end of the frame when the entity has an application
     
     // Lifecycle
     void Init();
@@ -104,6 +117,9 @@ public:
     void SetApplication(class Application* app) { application_ = app; }
     class Application* GetApplication() const { return application_; }
 
+    // Handle to look the entity up with (Application::GetEntity), invalid unless the application created it
+    EntityHandle GetHandle() const { return handle_; }
+
 private:
     // Register Behaviours for events
     bool RegisterBehaviour(Behaviour* b) const;
@@ -114,6 +130,7 @@ private:
     bool    initialized_;
     Input*  input_;
     Application* application_;
+    EntityHandle handle_;
 };
 
 // ============================================================================
@@ -0,0 +1,89 @@
+#pragma once
+
+#include "TLETC/Core/Types.h"
+#include "TLETC/Core/Math.h"
+#include "TLETC/Core/BVH.h"
+
+#include <unordered_map>
+#include <vector>
+
+namespace TLETC
+{
+
+class Entity;
+
+struct SceneRaycastHit
+{
+    Entity* entity   = nullptr;
+    float   distance = 0.0f;  // Where the ray enters the entity's bounds
+};
+
+/**
+ * SceneBVH - Bounding volume hierarchy over entities, for ray, frustum and overlap queries
+ *
+ * Each entity is one world-space box. Moving boxes only refits the nodes above them, walking
+ * up until a parent no longer changes. Refits let the tree degrade, so it is rebuilt with a
+ * binned SAH once its cost has grown past the rebuild threshold, and always after entities
+ * were inserted or removed.
+ *
+ * Edits are collected and applied by Update(); queries see the tree as of the last Update.
+ *
+ * usage : bvh.Insert(entity, worldBounds);   // or SetBounds when it moves
+ *         bvh.Update();
+ *         SceneRaycastHit hit;
+ *         if (bvh.Raycast(Ray::FromScreenPoint(mouseNdc, viewProjection), 1000.0f, hit)) Select(hit.entity);
+ */
+class SceneBVH
+{
+public:
+    SceneBVH();
+
+    // Entity bookkeeping, bounds in world space
+    void Insert(Entity* entity, const BoundingBox& bounds);
+    void SetBounds(Entity* entity, const BoundingBox& bounds);  // No-op if unchanged
+    void Remove(Entity* entity);
+    bool Contains(const Entity* entity) const { return items_.count(entity) > 0; }
+    void Clear();
+
+    // Apply pending edits - rebuild if the set of entities changed or the tree wore out, refit otherwise
+    void Update();
+    void Rebuild();
+
+    // Closest box along the ray, false if nothing is hit within maxDistance
+    bool Raycast(const Ray& ray, float maxDistance, SceneRaycastHit& hit) const;
+
+    // Append the entities whose bounds touch the frustum / box
+    void QueryFrustum(const Frustum& frustum, std::vector<Entity*>& results) const;
+    void QueryOverlap(const BoundingBox& box, std::vector<Entity*>& results) const;
+
+    // Rebuild once refitting pushes the SAH cost past this multiple of the cost right after a build
+    void  SetRebuildThreshold(float ratio) { rebuildThreshold_ = ratio; }
+    float GetRebuildThreshold() const      { return rebuildThreshold_; }
+
+    size_t GetEntityCount() const  { return entities_.size(); }
+    size_t GetNodeCount() const    { return nodes_.size(); }
+    float  GetCost() const         { return cost_; }
+    uint32 GetRebuildCount() const { return rebuildCount_; }
+
+private:
+    void CollectSubtree(uint32 node, std::vector<Entity*>& results) const;
+
+    // Per item, in insertion order (removal swaps the last one in)
+    std::vector<Entity*>     entities_;
+    std::vector<BoundingBox> bounds_;
+    std::vector<uint32>      itemLeaves_;  // Leaf holding the item, valid once built
+    std::unordered_map<const Entity*, uint32> items_;
+
+    std::vector<BVHNode> nodes_;
+    std::vector<uint32>  parents_;
+    std::vector<uint32>  order_;        // Leaf runs -> item
+    std::vector<uint32>  dirtyLeaves_;
+
+    float  builtCost_;
+    float  cost_;
+    float  rebuildThreshold_;
+    uint32 rebuildCount_;
+    bool   structureDirty_;
+};
+
+} // namespace TLETC
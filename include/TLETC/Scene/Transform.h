@@ -1,87 +1,89 @@
 #pragma once
 
 #include "TLETC/Core/Math.h"
+#include "TLETC/Scene/TransformSystem.h"
 
 namespace TLETC {
 
+/**
+ * Transform - Local position, rotation and scale, with an optional parent
+ *
+ * A handle to one node of a TransformSystem, which holds the values and caches world
+ * matrices. Entities use their Application's system, standalone transforms bring their own. Setters flag the node, and the
+ * system's per-frame Update refreshes all flagged nodes and their subtrees in one pass.
+ * Reads in between still come back current.
+ *
+ * Copies are new nodes with the same local values and parent. Moves take the node
+ * along, children included, and leave the source empty: assign to it or let it go,
+ * anything else asserts.
+ * Destroying a parent turns its children into roots. Not thread-safe.
+ */
 class Transform {
 public:
-    Vec3 position;
-    Quat rotation;
-    Vec3 scale;
-    
-    Transform* parent;
-    
-    Transform()
-        : position(0.0f, 0.0f, 0.0f)
-        , rotation(1.0f, 0.0f, 0.0f, 0.0f)  // Identity quaternion
-        , scale(1.0f, 1.0f, 1.0f)
-        , parent(nullptr)
-    {}
-    
+    explicit Transform(TransformSystem& system);
+    Transform(const Transform& other);
+    Transform(Transform&& other) noexcept;
+    Transform& operator=(const Transform& other);
+    Transform& operator=(Transform&& other) noexcept;
+    ~Transform();
+
+    // Local values
+    Vec3 GetPosition() const { return system_->GetPosition(id_); }
+    Quat GetRotation() const { return system_->GetRotation(id_); }
+    Vec3 GetScale() const    { return system_->GetScale(id_); }
+
+    void SetPosition(const Vec3& position) { system_->SetPosition(id_, position); }
+    void SetRotation(const Quat& rotation) { system_->SetRotation(id_, rotation); }
+    void SetScale(const Vec3& scale)       { system_->SetScale(id_, scale); }
+
     // Get the local transformation matrix
     Mat4 GetModelMatrix() const {
-        Mat4 S = glm::scale(Mat4(1.0f), scale);
-        Mat4 R = glm::mat4_cast(rotation);
-        Mat4 T = glm::translate(Mat4(1.0f), position);
-        return T * R * S;
+        return TransformSystem::ComposeMatrix(GetPosition(), GetRotation(), GetScale());
     }
-    
+
     // Get the world transformation matrix (including parent transforms)
     Mat4 GetWorldMatrix() const {
-        Mat4 localMatrix = GetModelMatrix();
-        if (parent) {
-            return parent->GetWorldMatrix() * localMatrix;
-        }
-        return localMatrix;
+        return system_->GetWorldMatrix(id_);
     }
-    
+
     // Get world position
     Vec3 GetWorldPosition() const {
-        if (parent) {
-            Mat4 worldMatrix = GetWorldMatrix();
-            return Vec3(worldMatrix[3]);
-        }
-        return position;
+        return Vec3(system_->GetWorldMatrix(id_)[3]);
     }
-    
+
     // Direction vectors
     Vec3 GetForward() const {
-        return rotation * Vec3(0.0f, 0.0f, -1.0f);
+        return GetRotation() * Vec3(0.0f, 0.0f, -1.0f);
     }
-    
+
     Vec3 GetRight() const {
-        return rotation * Vec3(1.0f, 0.0f, 0.0f);
+        return GetRotation() * Vec3(1.0f, 0.0f, 0.0f);
     }
-    
+
     Vec3 GetUp() const {
-        return rotation * Vec3(0.0f, 1.0f, 0.0f);
+        return GetRotation() * Vec3(0.0f, 1.0f, 0.0f);
     }
-    
+
     // Transform helpers
-    void Rotate(const Vec3& axis, float angleDegrees) {
-        rotation = QuatFromAxisAngle(axis, Radians(angleDegrees)) * rotation;
-        rotation = normalize(rotation);
-    }
+    void Rotate(const Vec3& axis, float angleDegrees);
+    void Translate(const Vec3& delta);
+    void LookAt(const Vec3& target, const Vec3& up = Vec3(0.0f, 1.0f, 0.0f));
 
-    void Translate(const Vec3& delta) {
-        position += delta;
-    }
+    // Hierarchy - false (and unchanged) if newParent is in another system, this transform or one of its children
+    bool SetParent(Transform* newParent);
+    Transform* GetParent() const;
 
-    void SetScale(const Vec3& s) {
-        scale = s;
-    }
-    
-    void LookAt(const Vec3& target, const Vec3& up = Vec3(0.0f, 1.0f, 0.0f)) {
-        Vec3 direction = normalize(target - position);
-        Mat4 lookMatrix = glm::lookAt(position, target, up);
-        rotation = glm::quat_cast(glm::inverse(lookMatrix));
-    }
-    
-    // Hierarchy
-    void SetParent(Transform* newParent) {
-        parent = newParent;
-    }
+    // True while this transform or a parent has changes the next TransformSystem::Update will apply
+    bool IsDirty() const { return system_->IsDirty(id_); }
+    // Moves on whenever the world matrix is recomputed (see TransformSystem::GetVersion)
+    uint32 GetVersion() const { return system_->GetVersion(id_); }
+
+    TransformSystem& GetSystem() const { return *system_; }
+    uint32           GetID() const     { return id_; }
+
+private:
+    TransformSystem* system_;
+    uint32           id_;  // TransformSystem::NoNode once moved from
 };
 
-} // namespace TLETC
\ No newline at end of file
+} // namespace TLETC
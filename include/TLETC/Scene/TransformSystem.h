@@ -0,0 +1,153 @@
+#pragma once
+
+#include "TLETC/Core/Types.h"
+#include "TLETC/Core/Math.h"
+
+#include <atomic>
+#include <cassert>
+#include <vector>
+
+namespace TLETC
+{
+
+class Transform;
+class JobSystem;
+
+/**
+ * TransformSystem - Every transform's local TRS, parent and world matrix in flat arrays
+ *
+ * Nodes are stored one array per field, sorted so a parent always sits before its
+ * children (depth by depth). New nodes are roots and go after the last depth, destroyed
+ * leaves are left as holes, so neither needs a re-sort; only re-parenting, destroying a
+ * parent, or holes piling up do. Update then computes every world matrix that needs it in
+ * one front-to-back sweep: a node is recomputed when it or its parent changed, and
+ * the parent's result is already there to multiply with. Nodes of one depth don't depend
+ * on each other, so large hierarchies split every level across a JobSystem, with
+ * identical results on any thread count.
+ *
+ * Nodes are addressed by ids that survive the re-sorting. Reads between two updates
+ * still see current values, resolved up the parent chain on demand. Every world matrix
+ * carries a version, bumped when it is recomputed, and remembers the parent version it
+ * was built from, so a read or an Update recomputes a node only once per change above it.
+ * Transform is the front end: entities and behaviours use it and never see the ids.
+ *
+ * Local values of different nodes can be set from different threads at once (parallel
+ * behaviour updates do). Creating, destroying, re-parenting and reading world matrices
+ * (which resolves parents) belong on one thread.
+ *
+ * usage : TransformSystem system;
+ *         uint32 root = system.Create(), child = system.Create();
+ *         system.SetParent(child, root);
+ *         system.SetPosition(root, Vec3(0, 1, 0));
+ *         system.Update();
+ *         const Mat4& world = system.GetWorldMatrix(child);
+ */
+class TransformSystem
+{
+public:
+    static constexpr uint32 NoNode = ~0u;
+
+    TransformSystem();
+    TransformSystem(const TransformSystem&) = delete;
+    TransformSystem& operator=(const TransformSystem&) = delete;
+
+    // New root node at the origin. The owner is what GetOwner hands back, optional
+    uint32 Create(Transform* owner = nullptr);
+
+    // Children of a destroyed node become roots
+    void Destroy(uint32 id);
+    bool IsValid(uint32 id) const { return id < slots_.size() && slots_[id] != NoNode; }
+
+    void       SetOwner(uint32 id, Transform* owner) { owners_[SlotOf(id)] = owner; }
+    Transform* GetOwner(uint32 id) const             { return owners_[SlotOf(id)]; }
+
+    // Local values
+    const Vec3& GetPosition(uint32 id) const { return positions_[SlotOf(id)]; }
+    const Quat& GetRotation(uint32 id) const { return rotations_[SlotOf(id)]; }
+    const Vec3& GetScale(uint32 id) const    { return scales_[SlotOf(id)]; }
+
+    void SetPosition(uint32 id, const Vec3& position);
+    void SetRotation(uint32 id, const Quat& rotation);
+    void SetScale(uint32 id, const Vec3& scale);
+
+    // NoNode detaches. False (and unchanged) if the parent is invalid or would create a cycle
+    bool   SetParent(uint32 id, uint32 parent);
+    uint32 GetParent(uint32 id) const;
+
+    // Current even before Update, the chain up to the root is resolved when something in it changed
+    const Mat4& GetWorldMatrix(uint32 id);
+
+    // True while the world matrix is out of date: the node or one of its parents changed
+    // since it was last computed (by Update, or by a read)
+    bool IsDirty(uint32 id) const;
+
+    // Moves on every time the world matrix is recomputed, so callers can tell it changed
+    // since they last looked. As of the last Update or read of this node
+    uint32 GetVersion(uint32 id) const { return versions_[SlotOf(id)]; }
+
+    // Re-sorts if the hierarchy changed shape, then refreshes every world matrix that needs it.
+    // Large levels are split across the job system when given one, the rest stays on the caller's thread
+    void Update(JobSystem* jobs = nullptr);
+
+    void   Reserve(size_t count);
+    size_t GetCount() const;        // Live nodes
+    uint32 GetDepthCount() const;   // Levels in the hierarchy as of the last Update
+
+    // Local matrix from position, rotation and scale, same as glm translate * rotate * scale
+    static Mat4 ComposeMatrix(const Vec3& position, const Quat& rotation, const Vec3& scale);
+
+private:
+    // Ids of destroyed nodes (and NoNode, which a moved-from Transform holds) have no slot
+    uint32 SlotOf(uint32 id) const
+    {
+        assert(IsValid(id) && "TransformSystem: node was destroyed, or its Transform moved from");
+        return slots_[id];
+    }
+
+    uint32 ParentSlot(uint32 slot) const;  // NoNode for roots and for destroyed parents
+    void   Resolve(uint32 slot);
+    void   Recompute(uint32 slot, uint32 parent);
+    void   Sort();
+    void   Sweep(size_t begin, size_t end);
+
+    // Only the first change after an Update writes the flag, threads setting values don't fight over it
+    void NoteChange()
+    {
+        if (!changedSinceUpdate_.load(std::memory_order_relaxed))
+            changedSinceUpdate_.store(true, std::memory_order_relaxed);
+    }
+
+private:
+    // Per slot, in parent-before-child order
+    std::vector<Vec3>       positions_;
+    std::vector<Quat>       rotations_;
+    std::vector<Vec3>       scales_;
+    std::vector<uint32>     parents_;   // Parent slot or NoNode
+    std::vector<Mat4>       worlds_;
+    std::vector<uint32>     versions_;        // Of the world matrix
+    std::vector<uint32>     parentVersions_;  // The parent's version the world matrix was built from
+    std::vector<uint8>      changed_;         // Local values or parent changed since the world matrix was built
+    std::vector<uint32>     childCounts_;     // Live children, only leaves are destroyed in place
+    std::vector<Transform*> owners_;
+    std::vector<uint32>     ids_;       // Slot to id, NoNode once destroyed
+
+    // Id to slot, NoNode for free ids
+    std::vector<uint32> slots_;
+    std::vector<uint32> freeIds_;
+
+    std::vector<uint32> levels_;  // First slot of each depth, then the end of the sorted slots (roots created since follow)
+
+    // Kept between sorts, so re-sorting doesn't allocate
+    struct SortScratch
+    {
+        std::vector<uint32> depths, path, offsets, order, newSlots;
+        std::vector<uint8>  values;
+    };
+    SortScratch sortScratch_;
+
+    size_t            destroyedCount_;      // Holes left by destroyed nodes, dropped by the next sort
+    bool              sortNeeded_;          // The hierarchy changed shape
+    std::atomic<bool> changedSinceUpdate_;  // Reads have to check the parent chain. Set from any thread
+};
+
+} // namespace TLETC
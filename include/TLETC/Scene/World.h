@@ -0,0 +1,339 @@
+#pragma once
+
+#include "TLETC/Core/Types.h"
+#include "TLETC/Core/JobSystem.h"
+
+#include <map>
+#include <new>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace TLETC
+{
+
+// An entity of a World: slot index plus the generation of that slot, so stale ids stay dead
+struct EntityID
+{
+    static constexpr uint32 NoIndex = ~0u;
+
+    uint32 index      = NoIndex;
+    uint32 generation = 0;
+
+    bool IsValid() const { return index != NoIndex; }
+    bool operator==(const EntityID& other) const = default;
+};
+
+/**
+ * World - Archetype store for plain-data components
+ *
+ * Entities with the same set of component types share an archetype, which keeps them in
+ * 16 KiB chunks, one array per component type. Queries walk the chunks of every archetype
+ * that has the requested types, so iterating a component touches memory front to back
+ * instead of chasing one heap object per entity. Adding or removing a component moves
+ * the entity to the archetype for its new set; removals fill the gap with the archetype's
+ * last entity, so rows stay packed.
+ *
+ * Any nothrow-movable type can be a component, including Transform (a handle into its
+ * TransformSystem). Component pointers are only good until the next structural change
+ * (creating, destroying, adding or removing anything); queries must not make one.
+ *
+ * Lives next to Entity/Behaviour so hot systems can move over one at a time: a behaviour
+ * reaches the application's world with GetWorld and runs its queries from an update.
+ *
+ * usage : EntityID rock = world.Create(Transform(app.GetTransformSystem()), MeshRef{ &rockMesh }, Velocity{});
+ *         world.Each<Transform, Velocity>([dt](Transform& t, Velocity& v) { t.Translate(v.linear * dt); });
+ *         world.ParallelEach<Bounds>(&jobs, [](EntityID id, Bounds& b) { ... });
+ */
+class World
+{
+public:
+    static constexpr size_t ChunkSize = 16 * 1024;
+
+    World();
+    ~World();
+
+    World(const World&) = delete;
+    World& operator=(const World&) = delete;
+
+    // Entities
+    EntityID Create();
+    template<typename... Ts>
+    EntityID Create(Ts&&... components);  // Each type at most once
+    void     Destroy(EntityID entity);  // No-op for dead entities
+    bool     IsAlive(EntityID entity) const;
+    void     Clear();                   // Destroys every entity, archetypes stay
+
+    // Components. Add replaces one the entity already has; it and Get return null for dead entities
+    template<typename T, typename... Args>
+    T* Add(EntityID entity, Args&&... args);
+    template<typename T>
+    bool Remove(EntityID entity);
+    template<typename T>
+    bool Has(EntityID entity) const { return Locate(entity, TypeOf<T>()) != nullptr; }
+    template<typename T>
+    T* Get(EntityID entity) { return static_cast<T*>(Locate(entity, TypeOf<T>())); }
+    template<typename T>
+    const T* Get(EntityID entity) const { return static_cast<const T*>(Locate(entity, TypeOf<T>())); }
+
+    // fn(Ts&...) or fn(EntityID, Ts&...) for every entity with all of Ts, chunk by chunk
+    template<typename... Ts, typename Fn>
+    void Each(Fn&& fn);
+
+    // Same, chunks split across the job system. fn runs on several threads at once: it may
+    // only touch what it is handed (and its own synchronised state)
+    template<typename... Ts, typename Fn>
+    void ParallelEach(JobSystem* jobs, Fn&& fn);
+
+    // Entities with all of Ts
+    template<typename... Ts>
+    size_t Count() const;
+
+    size_t GetCount() const          { return aliveCount_; }
+    size_t GetArchetypeCount() const { return archetypes_.size(); }
+    size_t GetChunkCount() const;
+
+private:
+    struct ComponentInfo
+    {
+        uint32 type;
+        uint32 size;
+        uint32 align;
+        void (*relocate)(void* destination, void* source);  // Move-construct, then destroy the source
+        void (*destroy)(void* component);
+    };
+
+    struct Column
+    {
+        ComponentInfo info;
+        size_t        offset;  // Of this component's array within a chunk
+    };
+
+    struct Chunk
+    {
+        unsigned char* memory;  // Entity ids, then one array per column
+        uint32         count;
+    };
+
+    struct Archetype
+    {
+        std::vector<uint32> types;       // Sorted
+        std::vector<Column> columns;     // In the order of types
+        uint32              capacity;    // Rows per chunk
+        size_t              chunkBytes;
+        std::vector<Chunk>  chunks;      // All full but the last, none empty
+        uint32              count;
+
+        // Archetype reached by adding / removing one type, filled in as they are used
+        std::unordered_map<uint32, uint32> addEdges;
+        std::unordered_map<uint32, uint32> removeEdges;
+
+        int       ColumnOf(uint32 type) const;  // -1 if the archetype doesn't have it
+        void*     At(size_t column, uint32 row) const;
+        EntityID& IdAt(uint32 row) const;
+    };
+
+    struct Location
+    {
+        uint32 archetype;  // NoArchetype while the slot is free
+        uint32 row;
+        uint32 generation;
+    };
+
+    static constexpr uint32 NoArchetype = ~0u;
+
+    template<typename T>
+    static uint32 TypeOf();
+    template<typename T, typename... Ts>
+    static constexpr size_t CountOf = (size_t(0) + ... + size_t(std::is_same_v<T, Ts>));  // How often T is among Ts
+    template<typename T>
+    static const ComponentInfo& InfoOf();
+    static uint32 NextType();
+    static void   ReportDeadEntity(const char* operation);
+
+    EntityID NewEntity();
+    uint32   FindOrCreateArchetype(std::vector<ComponentInfo> infos);
+    uint32   AddType(uint32 archetype, const ComponentInfo& info);
+    uint32   RemoveType(uint32 archetype, uint32 type);
+    void     AllocateRow(uint32 archetype, EntityID entity);
+    void     FreeRow(uint32 archetype, uint32 row, bool destroyComponents);
+    void     Move(EntityID entity, uint32 archetype);
+    void*    Locate(EntityID entity, uint32 type) const;
+    bool     Matches(const Archetype& archetype, const uint32* types, size_t count) const;
+
+    template<typename... Ts, typename Fn, size_t... I>
+    static void EachInChunk(const Chunk& chunk, const size_t* offsets, Fn& fn, std::index_sequence<I...>);
+
+private:
+    std::vector<Archetype>                archetypes_;  // 0 is the one without components
+    std::map<std::vector<uint32>, uint32> archetypeLookup_;
+    std::vector<Location>                 locations_;   // By entity index
+    std::vector<uint32>                   freeIndices_;
+    size_t                                aliveCount_;
+};
+
+// ============================================================================
+// Template implementation
+// ============================================================================
+
+template<typename T>
+uint32 World::TypeOf()
+{
+    static const uint32 type = NextType();
+    return type;
+}
+
+template<typename T>
+const World::ComponentInfo& World::InfoOf()
+{
+    static_assert(std::is_nothrow_move_constructible_v<T>, "Components are moved between chunks and must not throw doing it");
+    static_assert(alignof(T) <= 64, "Chunks are aligned to 64 bytes");
+
+    static const ComponentInfo info = {
+        TypeOf<T>(), static_cast<uint32>(sizeof(T)), static_cast<uint32>(alignof(T)),
+        [](void* destination, void* source) {
+            T* from = static_cast<T*>(source);
+            new (destination) T(std::move(*from));
+            from->~T();
+        },
+        [](void* component) { static_cast<T*>(component)->~T(); }
+    };
+    return info;
+}
+
+template<typename... Ts>
+EntityID World::Create(Ts&&... components)
+{
+    // A type given twice would be placed twice into its one column
+    static_assert(((CountOf<std::decay_t<Ts>, std::decay_t<Ts>...> == 1) && ...), "Create takes each component type once");
+
+    // Straight into the final archetype, no moves through the ones in between
+    const EntityID entity    = NewEntity();
+    const uint32   archetype = FindOrCreateArchetype({ InfoOf<std::decay_t<Ts>>()... });
+    AllocateRow(archetype, entity);
+    (new (Locate(entity, TypeOf<std::decay_t<Ts>>())) std::decay_t<Ts>(std::forward<Ts>(components)), ...);
+    return entity;
+}
+
+template<typename T, typename... Args>
+T* World::Add(EntityID entity, Args&&... args)
+{
+    // const T would be a type of its own, a second column next to T's
+    static_assert(std::is_same_v<T, std::remove_cvref_t<T>>, "Add takes the plain component type");
+
+    if (!IsAlive(entity))
+    {
+        ReportDeadEntity("Add");
+        return nullptr;
+    }
+
+    if (T* existing = Get<T>(entity))
+    {
+        *existing = T(std::forward<Args>(args)...);
+        return existing;
+    }
+
+    Move(entity, AddType(locations_[entity.index].archetype, InfoOf<T>()));
+    return new (Locate(entity, TypeOf<T>())) T(std::forward<Args>(args)...);
+}
+
+template<typename T>
+bool World::Remove(EntityID entity)
+{
+    if (!Has<T>(entity))
+        return false;
+
+    // Moving leaves behind (destroys) whatever the new archetype has no column for
+    Move(entity, RemoveType(locations_[entity.index].archetype, TypeOf<T>()));
+    return true;
+}
+
+template<typename... Ts, typename Fn, size_t... I>
+void World::EachInChunk(const Chunk& chunk, const size_t* offsets, Fn& fn, std::index_sequence<I...>)
+{
+    const EntityID*   ids = reinterpret_cast<const EntityID*>(chunk.memory);
+    std::tuple<Ts*...> arrays(std::launder(reinterpret_cast<Ts*>(chunk.memory + offsets[I]))...);
+
+    for (uint32 row = 0; row < chunk.count; ++row)
+    {
+        if constexpr (std::is_invocable_v<Fn&, EntityID, Ts&...>)
+            fn(ids[row], std::get<I>(arrays)[row]...);
+        else
+            fn(std::get<I>(arrays)[row]...);
+    }
+}
+
+template<typename... Ts, typename Fn>
+void World::Each(Fn&& fn)
+{
+    static_assert(sizeof...(Ts) > 0, "Each needs at least one component type");
+
+    const uint32 types[] = { TypeOf<std::remove_const_t<Ts>>()... };
+    for (const Archetype& archetype : archetypes_)
+    {
+        if (archetype.count == 0 || !Matches(archetype, types, sizeof...(Ts)))
+            continue;
+
+        const size_t offsets[] = { archetype.columns[archetype.ColumnOf(TypeOf<std::remove_const_t<Ts>>())].offset... };
+        for (const Chunk& chunk : archetype.chunks)
+            EachInChunk<Ts...>(chunk, offsets, fn, std::index_sequence_for<Ts...>());
+    }
+}
+
+template<typename... Ts, typename Fn>
+void World::ParallelEach(JobSystem* jobs, Fn&& fn)
+{
+    static_assert(sizeof...(Ts) > 0, "ParallelEach needs at least one component type");
+
+    if (!jobs || !jobs->IsInitialized())
+    {
+        Each<Ts...>(fn);
+        return;
+    }
+
+    // One work item per chunk, they are sized to be worth a thread's while
+    struct Work
+    {
+        const Chunk* chunk;
+        size_t       offsets[sizeof...(Ts)];
+    };
+    std::vector<Work> work;
+
+    const uint32 types[] = { TypeOf<std::remove_const_t<Ts>>()... };
+    for (const Archetype& archetype : archetypes_)
+    {
+        if (archetype.count == 0 || !Matches(archetype, types, sizeof...(Ts)))
+            continue;
+
+        Work item = { nullptr, { archetype.columns[archetype.ColumnOf(TypeOf<std::remove_const_t<Ts>>())].offset... } };
+        for (const Chunk& chunk : archetype.chunks)
+        {
+            item.chunk = &chunk;
+            work.push_back(item);
+        }
+    }
+
+    jobs->ParallelFor(work.size(), 1, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i)
+            EachInChunk<Ts...>(*work[i].chunk, work[i].offsets, fn, std::index_sequence_for<Ts...>());
+    });
+}
+
+template<typename... Ts>
+size_t World::Count() const
+{
+    static_assert(sizeof...(Ts) > 0, "Count needs at least one component type, GetCount counts everything");
+
+    const uint32 types[] = { TypeOf<std::remove_const_t<Ts>>()... };
+    size_t count = 0;
+    for (const Archetype& archetype : archetypes_)
+    {
+        if (Matches(archetype, types, sizeof...(Ts)))
+            count += archetype.count;
+    }
+    return count;
+}
+
+} // namespace TLETC
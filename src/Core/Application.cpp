@@ -11,10 +11,15 @@ namespace TLETC
 Application::Application(const std::string& title, uint32 width, uint32 height)
     : title_(title)
     , width_(width), height_(height)
-    , running_(false), initialized_(false), eventsEnabled_(true)
+    , running_(false), initialized_(false), eventsEnabled_(true), parallelUpdates_(true)
     , time_(0.0f), deltaTime_(0.0f)
     , lastFrameTime_(0.0)
+    , cullingEnabled_(false), visibleDirty_(true)
+    , sceneBVHDirty_(true)
 {
+    std::fill(std::begin(behaviourEventListsDirty_), std::end(behaviourEventListsDirty_), false);
+    std::fill(std::begin(behaviourEventListHoles_), std::end(behaviourEventListHoles_), 0u);
+    std::fill(std::begin(updateSchedulesDirty_), std::end(updateSchedulesDirty_), true);
 }
 
 Application::~Application() 
@@ -51,12 +56,18 @@ bool Application::Initialize()
     std::cout << "Renderer: " << renderDevice_->GetRendererName() << std::endl;
     std::cout << "OpenGL: "   << renderDevice_->GetAPIVersion() << std::endl;
 
+    renderQueue_ = MakeUnique<RenderQueue>();
+
     // Create input
     input_ = MakeUnique<Input>();
     input_->Initialize(window_->GetNativeWindow());
     
     std::cout << "Input system initialized" << std::endl;
 
+    // Start worker threads
+    jobSystem_.Initialize();
+    std::cout << "Job system: " << jobSystem_.GetThreadCount() << " thread(s)" << std::endl;
+
     initialized_ = true;
     
     // Call user initialization
@@ -96,14 +107,20 @@ void Application::Run()
         lastFrameTime_   = currentTime;
         time_            = static_cast<float>(currentTime);
         
+        renderDevice_->BeginFrame();
+        sceneBVHDirty_ = true;
+        
         // Execute game loop phases IN ORDER
         ProcessInput();    // 1. Read hardware, fire input events
         EarlyUpdate();     // 2. Pre-physics, input handling
         Update();          // 3. Main game logic
         LateUpdate();      // 4. Post-logic, cameras, etc.
+        transformSystem_.Update(&jobSystem_);  // World matrices for everything that moved
         PreRender();       // 5. Prepare for rendering
         Render();          // 6. Draw everything
         PostRender();      // 7. UI, debug overlays, cleanup
+        
+        renderDevice_->EndFrame();
 
         // Process any deferred destructions (safe to destroy now)
         ProcessDestroyQueue();
@@ -125,12 +142,34 @@ void Application::Shutdown()
     // Call user shutdown
     OnShutdown();
     
-    // Destroy all entities
+    // Destroy all entities, their handles stay dead
     for (auto& entity : entities_)
+    {
         entity->Destroy();
+        ++entitySlots_[entity->handle_.index].generation;
+        entitySlots_[entity->handle_.index].bvhMesh = nullptr;
+        freeEntitySlots_.push_back(entity->handle_.index);
+    }
     entities_.clear();
+    entitiesToDestroy_.clear();
+    behavioursToDestroy_.clear();
+    for (uint32 i = 0; i < Behaviour::MaxEventFlags; ++i)
+    {
+        behaviourEventLists_[i].clear();
+        behaviourEventListsDirty_[i] = false;
+        behaviourEventListHoles_[i]  = 0;
+    }
+    for (uint32 i = 0; i < UpdateEventCount; ++i)
+    {
+        updateSchedules_[i].Clear();
+        updateSchedulesDirty_[i] = true;
+    }
+    sceneBVH_.Clear();
+    world_.Clear();
     
     // Shutdown systems
+    jobSystem_.Shutdown();
+    if (renderQueue_) renderQueue_->Clear();
     if (input_) input_->Shutdown();
     if (renderDevice_) renderDevice_->Shutdown();
     if (window_) window_->Destroy();
@@ -143,10 +182,25 @@ void Application::Shutdown()
 
 Entity* Application::CreateEntity(const std::string& name) 
 {
-    auto entity = MakeUnique<Entity>(name);
+    auto entity = MakeUnique<Entity>(transformSystem_, name);
     entity->SetInput(input_.get());
     entity->SetApplication(this); // access to Application for event registration
     
+    // Reuse a free slot if there is one, its generation already moved past the old handles
+    uint32 index;
+    if (!freeEntitySlots_.empty())
+    {
+        index = freeEntitySlots_.back();
+        freeEntitySlots_.pop_back();
+    }
+    else
+    {
+        index = static_cast<uint32>(entitySlots_.size());
+        entitySlots_.push_back({ 0, 0, nullptr, 0, 0 });
+    }
+    entitySlots_[index].position = static_cast<uint32>(entities_.size());
+    entity->handle_ = { index, entitySlots_[index].generation };
+    
     Entity* ptr = entity.get();
     entities_.push_back(std::move(entity));
     
@@ -158,9 +212,120 @@ Entity* Application::CreateEntity(const std::string& name)
 }
 
 void Application::DestroyEntity(Entity* entity) 
+{
+    if (!entity || GetEntity(entity->handle_) != entity)
+    {
+        std::cerr << "Application::DestroyEntity: entity doesn't belong to this application" << std::endl;
+        return;
+    }
+    DestroyEntity(entity->handle_);
+}
+
+void Application::DestroyEntity(EntityHandle handle) 
 {
     // Don't destroy immediately - queue for end of frame
-    entitiesToDestroy_.push_back(entity);
+    if (IsAlive(handle))
+        entitiesToDestroy_.push_back(handle);
+}
+
+Entity* Application::GetEntity(EntityHandle handle) const
+{
+    if (handle.index >= entitySlots_.size() || entitySlots_[handle.index].generation != handle.generation)
+        return nullptr;
+    
+    // A free slot's generation is one no handle has yet, so a match is alive
+    return entities_[entitySlots_[handle.index].position].get();
+}
+
+void Application::SetCullingCamera(const Mat4& viewProjection)
+{
+    cullingFrustum_ = Frustum::FromMatrix(viewProjection);
+    cullingEnabled_ = true;
+    visibleDirty_   = true;
+}
+
+void Application::ClearCullingCamera()
+{
+    cullingEnabled_ = false;
+    visibleDirty_   = true;
+}
+
+const std::vector<Entity*>& Application::GetVisibleEntities()
+{
+    if (visibleDirty_)
+        CullRenderables();
+    return visibleEntities_;
+}
+
+SceneBVH& Application::GetSceneBVH()
+{
+    if (sceneBVHDirty_)
+        SyncSceneBVH();
+    return sceneBVH_;
+}
+
+void Application::SyncSceneBVH()
+{
+    sceneBVHDirty_ = false;
+    
+    // Entities whose transform, mesh and mesh positions are as they were are skipped without
+    // touching their bounds, moved ones refit their branch of the tree
+    for (const auto& entity : entities_)
+    {
+        EntitySlot& slot = entitySlots_[entity->handle_.index];
+        const Mesh* mesh = entity->IsEnabled() ? entity->mesh : nullptr;
+        if (!mesh)
+        {
+            if (slot.bvhMesh)
+                sceneBVH_.Remove(entity.get());
+            slot.bvhMesh = nullptr;
+            continue;
+        }
+
+        const Transform& transform      = entity->transform;
+        const uint32     meshGeneration = mesh->GetStreamGeneration(VertexStream::Position);
+        if (slot.bvhMesh == mesh && slot.bvhMeshGeneration == meshGeneration && !transform.IsDirty() && slot.bvhTransformVersion == transform.GetVersion())
+            continue;
+
+        const BoundingBox bounds = mesh->GetBoundingBox().Transformed(transform.GetWorldMatrix());
+        if (slot.bvhMesh)
+            sceneBVH_.SetBounds(entity.get(), bounds);
+        else
+            sceneBVH_.Insert(entity.get(), bounds);
+        slot.bvhMesh             = mesh;
+        slot.bvhMeshGeneration   = meshGeneration;
+        slot.bvhTransformVersion = transform.GetVersion();  // Current now that the matrix was read
+    }
+    sceneBVH_.Update();
+}
+
+void Application::CullRenderables()
+{
+    visibleDirty_ = false;
+    
+    // World bounds are rebuilt every time, transforms move freely between frames
+    renderables_.clear();
+    culling_.Clear();
+    culling_.Reserve(entities_.size());
+    for (const auto& entity : entities_)
+    {
+        if (!entity->mesh || !entity->IsEnabled()) continue;
+        
+        renderables_.push_back(entity.get());
+        if (cullingEnabled_)
+            culling_.Add(entity->mesh->GetBoundingBox().Transformed(entity->transform.GetWorldMatrix()));
+    }
+    
+    if (!cullingEnabled_)
+    {
+        visibleEntities_ = renderables_;
+        return;
+    }
+    
+    culling_.Cull(cullingFrustum_, visibleSlots_);
+    visibleEntities_.clear();
+    for (uint32 slot : visibleSlots_)
+        visibleEntities_.push_back(renderables_[slot]);
 }
 
 // ============================================================================
@@ -191,7 +356,7 @@ void Application::ProcessInput()
         if (OnKeyEvent) OnKeyEvent(key, true);
         
         // Run behaviours that handle key events
-        RunBehaviourEvent(6, [key](Behaviour* b) { b->OnKeyPressed(key); });    
+        RunBehaviourEvent<Behaviour::KeyEvents>([key](Behaviour* b) { b->OnKeyPressed(key); });
     }
 
     for (KeyCode key : input_->GetKeysJustReleased()) 
@@ -200,7 +365,7 @@ void Application::ProcessInput()
         if (OnKeyEvent) OnKeyEvent(key, false);
         
         // Run behaviours that handle key events
-        RunBehaviourEvent(6, [key](Behaviour* b) { b->OnKeyReleased(key); });
+        RunBehaviourEvent<Behaviour::KeyEvents>([key](Behaviour* b) { b->OnKeyReleased(key); });
     }
     
     // Fire mouse button events - only for buttons that actually changed! (efficient!)
@@ -210,7 +375,7 @@ void Application::ProcessInput()
         if (OnMouseButtonEvent) OnMouseButtonEvent(button, true);
         
         // Run behaviours that handle mouse button events
-        RunBehaviourEvent(7, [button](Behaviour* b) { b->OnMouseButtonPressed(button); });
+        RunBehaviourEvent<Behaviour::MouseButtonEvents>([button](Behaviour* b) { b->OnMouseButtonPressed(button); });
     }
     
     for (MouseButton button : input_->GetMouseButtonsJustReleased()) 
@@ -219,7 +384,7 @@ void Application::ProcessInput()
         if (OnMouseButtonEvent) OnMouseButtonEvent(button, false);
         
         // Run behaviours that handle mouse button events
-        RunBehaviourEvent(7, [button](Behaviour* b) { b->OnMouseButtonReleased(button); });
+        RunBehaviourEvent<Behaviour::MouseButtonEvents>([button](Behaviour* b) { b->OnMouseButtonReleased(button); });
     }
     
     // Fire mouse moved event
@@ -232,7 +397,7 @@ void Application::ProcessInput()
         if (OnMouseMoveEvent) OnMouseMoveEvent(position, delta);
         
         // Run behaviours that handle mouse move events
-        RunBehaviourEvent(8, [position, delta](Behaviour* b) { b->OnMouseMoved(position, delta); });
+        RunBehaviourEvent<Behaviour::MouseMoveEvents>([position, delta](Behaviour* b) { b->OnMouseMoved(position, delta); });
     }
     
     // Fire mouse scrolled event
@@ -243,7 +408,7 @@ void Application::ProcessInput()
         if (OnMouseScrollEvent) OnMouseScrollEvent(scroll);
         
         // Run behaviours that handle mouse scroll events
-        RunBehaviourEvent(9, [scroll](Behaviour* b) { b->OnMouseScrolled(scroll); });
+        RunBehaviourEvent<Behaviour::MouseScrollEvents>([scroll](Behaviour* b) { b->OnMouseScrolled(scroll); });
     }
     
     // Reset scroll after event is fired (scroll is per-frame)
@@ -253,13 +418,15 @@ void Application::ProcessInput()
 void Application::EarlyUpdate() 
 {
     // Run behaviours that handle early update
-    RunBehaviourEvent(0, [this](Behaviour* b) { b->OnEarlyUpdate(deltaTime_); });
+    const float deltaTime = deltaTime_;
+    RunBehaviourUpdate<Behaviour::EarlyUpdate>([deltaTime](Behaviour* b) { b->OnEarlyUpdate(deltaTime); });
 }
 
 void Application::Update() 
 {
     // Run behaviours that handle update
-    RunBehaviourEvent(1, [this](Behaviour* b) { b->OnUpdate(deltaTime_); });
+    const float deltaTime = deltaTime_;
+    RunBehaviourUpdate<Behaviour::Update>([deltaTime](Behaviour* b) { b->OnUpdate(deltaTime); });
     
     // Call user update
     OnUpdate(deltaTime_);
@@ -268,50 +435,74 @@ void Application::Update()
 void Application::LateUpdate() 
 {
     // Run behaviours that handle late update
-    RunBehaviourEvent(2, [this](Behaviour* b) { b->OnLateUpdate(deltaTime_); });
+    const float deltaTime = deltaTime_;
+    RunBehaviourUpdate<Behaviour::LateUpdate>([deltaTime](Behaviour* b) { b->OnLateUpdate(deltaTime); });
 }
 
 void Application::PreRender() 
 {
     // Run behaviours that handle pre-render
-    RunBehaviourEvent(3, [](Behaviour* b) { b->OnPreRender(); });
+    RunBehaviourEvent<Behaviour::PreRender>([](Behaviour* b) { b->OnPreRender(); });
 }
 
 void Application::Render() 
 {
+    // Transforms may have moved since the last cull
+    visibleDirty_ = true;
+    
     // Run behaviours that handle render
-    RunBehaviourEvent(4, [](Behaviour* b) { b->OnRender(); });
+    RunBehaviourEvent<Behaviour::Render>([](Behaviour* b) { b->OnRender(); });
     
     // Call user render
     OnRender();
+    
+    // Issue everything submitted this phase, sorted and batched
+    renderQueue_->Flush(*renderDevice_);
 }
 
 void Application::PostRender() 
 {
     // Run behaviours that handle post-render
-    RunBehaviourEvent(5, [](Behaviour* b) { b->OnPostRender(); });
+    RunBehaviourEvent<Behaviour::PostRender>([](Behaviour* b) { b->OnPostRender(); });
 }
 
 void Application::ProcessDestroyQueue() 
 {
+    // Nothing runs behaviours any more this frame
+    behavioursToDestroy_.clear();
+
     if (entitiesToDestroy_.empty()) return;
     
-    for (Entity* entity : entitiesToDestroy_) 
+    // Constant time per entity: slot lookup, one hole per event list, swap with the last entity
+    for (EntityHandle handle : entitiesToDestroy_) 
     {
-        auto it = std::find_if(entities_.begin(), entities_.end(), [entity](const UniquePtr<Entity>& ptr) { return ptr.get() == entity; });
+        Entity* entity = GetEntity(handle);
+        if (!entity) continue;  // Queued twice
         
-        if (it != entities_.end()) 
+        // Unregister all behaviours from event lists before destroying
+        for (const auto& behaviour : entity->behaviours_) 
+            UnregisterBehaviourFromEvents(behaviour.get());
+        
+        sceneBVH_.Remove(entity);
+        entity->Destroy();
+        
+        EntitySlot& slot = entitySlots_[handle.index];
+        slot.bvhMesh = nullptr;
+        if (slot.position != entities_.size() - 1)
         {
-            // Unregister all behaviours from event lists before destroying
-            for (const auto& behaviour : (*it)->behaviours_) 
-                UnregisterBehaviourFromEvents(behaviour.get());
-            
-            (*it)->Destroy();
-            entities_.erase(it);
+            entities_[slot.position] = std::move(entities_.back());
+            entitySlots_[entities_[slot.position]->handle_.index].position = slot.position;
         }
+        entities_.pop_back();
+        
+        ++slot.generation;
+        freeEntitySlots_.push_back(handle.index);
     }
     
     entitiesToDestroy_.clear();
+    visibleEntities_.clear();
+    renderables_.clear();
+    visibleDirty_ = true;
 }
 
 void Application::RegisterBehaviourForEvents(Behaviour* behaviour) 
@@ -319,66 +510,64 @@ void Application::RegisterBehaviourForEvents(Behaviour* behaviour)
     // Register behaviour for each event it handles
     for (uint32 i = 0; i < Behaviour::MaxEventFlags; ++i) 
     {  // We have 10 event types
-        if (behaviour->HasEvent(1 << i)) 
+        if (behaviour->HasEvent(1 << i) && behaviour->eventSlots_[i] == Behaviour::NoEventSlot) 
         {
+            behaviour->eventSlots_[i] = static_cast<uint32>(behaviourEventLists_[i].size());
             behaviourEventLists_[i].push_back(behaviour);
             behaviourEventListsDirty_[i] = true;  // Needs sorting
+            if (i < UpdateEventCount)
+                updateSchedulesDirty_[i] = true;
         }
     }
 }
 
 void Application::UnregisterBehaviourFromEvents(Behaviour* behaviour) 
 {
-    // Remove behaviour from all event lists
-    for (auto& pair : behaviourEventLists_) 
+    // Remove behaviour from the event lists it is in, straight to its slot. Nulling keeps the
+    // others in order (and in place, should a list be running)
+    for (uint32 i = 0; i < Behaviour::MaxEventFlags; ++i) 
     {
-        auto& list = pair.second;
-        list.erase(std::remove(list.begin(), list.end(), behaviour), list.end());
+        uint32& slot = behaviour->eventSlots_[i];
+        if (slot == Behaviour::NoEventSlot)
+            continue;
+        
+        behaviourEventLists_[i][slot] = nullptr;
+        slot = Behaviour::NoEventSlot;
+        ++behaviourEventListHoles_[i];
+        if (i < UpdateEventCount)
+            updateSchedulesDirty_[i] = true;
     }
 }
 
-void Application::RunBehaviourEvent(uint32 eventId, std::function<void(Behaviour*)> callback) {
-    // Check if events are enabled for certain event types
-    if (!eventsEnabled_) 
-    {
-        // These events can be disabled (useful for pausing)
-        switch (eventId) 
-        {
-        case 0:  // EarlyUpdate
-        case 1:  // Update
-        case 2:  // LateUpdate
-        case 6:  // KeyEvents
-        case 7:  // MouseButtonEvents
-        case 8:  // MouseMoveEvents
-        case 9:  // MouseScrollEvents
-            return;
-        default:
-            break;
-        }
-    }
+void Application::QueueBehaviourDestruction(UniquePtr<Behaviour> behaviour)
+{
+    // Out of the event lists, and skipped by the schedules that were built with it until they are rebuilt
+    UnregisterBehaviourFromEvents(behaviour.get());
+    behaviour->SetEnabled(false);
+    behavioursToDestroy_.push_back(std::move(behaviour));
+}
+
+bool Application::PrepareBehaviourEventList(uint32 eventId)
+{
+    if (behaviourEventListHoles_[eventId] == 0 && !behaviourEventListsDirty_[eventId])
+        return false;
     
-    // Sort if needed
-    if (behaviourEventListsDirty_[eventId]) 
+    auto& list = behaviourEventLists_[eventId];
+    if (behaviourEventListHoles_[eventId] > 0)
     {
-        auto& list = behaviourEventLists_[eventId];
-        std::sort(list.begin(), list.end(), [](Behaviour* a, Behaviour* b) { return a->GetExecutionOrder() < b->GetExecutionOrder(); });
-        behaviourEventListsDirty_[eventId] = false;
+        list.erase(std::remove(list.begin(), list.end(), nullptr), list.end());
+        behaviourEventListHoles_[eventId] = 0;
     }
-    
-    // Run callbacks on behaviours that handle this event
-    auto& behaviourList = behaviourEventLists_[eventId];
-    size_t originalSize = behaviourList.size();
-    
-    for (auto* behaviour : behaviourList) 
+    if (behaviourEventListsDirty_[eventId])
     {
-        if (behaviour->IsEnabled())
-            callback(behaviour);
+        std::stable_sort(list.begin(), list.end(), [](Behaviour* a, Behaviour* b) { return a->GetExecutionOrder() < b->GetExecutionOrder(); });
+        behaviourEventListsDirty_[eventId] = false;
     }
     
-    // If list size changed during iteration, something was added/removed
-    // (shouldn't happen with deferred destruction, but check anyway)
-    if (behaviourList.size() != originalSize)
-        behaviourEventListsDirty_[eventId] = true;
+    // Everyone may have moved
+    for (uint32 i = 0, count = static_cast<uint32>(list.size()); i < count; ++i)
+        list[i]->eventSlots_[eventId] = i;
+    return true;
 }
 
 } // namespace TLETC
\ No newline at end of file
@@ -0,0 +1,177 @@
+#include "TLETC/Core/BVH.h"
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+
+namespace TLETC {
+
+static constexpr uint32 s_binCount      = 16;
+static constexpr float  s_traversalCost = 1.0f;  // Relative to testing one primitive
+
+// Half the surface area, the factor of two cancels out of every SAH comparison
+static float HalfArea(const Vec3& min, const Vec3& max)
+{
+    const Vec3 d = max - min;
+    return d.x * d.y + d.y * d.z + d.z * d.x;
+}
+
+struct BinBounds
+{
+    Vec3   min   = Vec3(std::numeric_limits<float>::max());
+    Vec3   max   = Vec3(std::numeric_limits<float>::lowest());
+    uint32 count = 0;
+
+    void Grow(const Vec3& lo, const Vec3& hi)
+    {
+        min = glm::min(min, lo);
+        max = glm::max(max, hi);
+    }
+    float Area() const { return count ? HalfArea(min, max) : 0.0f; }
+};
+
+static void FitNode(BVHNode& node, std::span<const BoundingBox> bounds, const uint32* order)
+{
+    BinBounds fit;
+    for (uint32 i = 0; i < node.count; ++i)
+        fit.Grow(bounds[order[i]].min, bounds[order[i]].max);
+    node.min = fit.min;
+    node.max = fit.max;
+}
+
+void BuildBVH(std::span<const BoundingBox> bounds, uint32 maxLeafSize, std::vector<BVHNode>& nodes, std::vector<uint32>& order)
+{
+    const uint32 primitiveCount = static_cast<uint32>(bounds.size());
+    nodes.clear();
+    order.resize(primitiveCount);
+    std::iota(order.begin(), order.end(), 0u);
+    if (primitiveCount == 0) return;
+
+    std::vector<Vec3> centroids(primitiveCount);
+    for (uint32 i = 0; i < primitiveCount; ++i)
+        centroids[i] = bounds[i].GetCenter();
+
+    // A binary tree over n leaves has at most 2n - 1 nodes, so nodes never reallocates mid-build
+    nodes.reserve(2 * primitiveCount - 1);
+    nodes.push_back(BVHNode{ Vec3(0.0f), 0, Vec3(0.0f), primitiveCount });
+    FitNode(nodes[0], bounds, order.data());
+
+    std::vector<uint32> stack = { 0 };
+    while (!stack.empty())
+    {
+        BVHNode& node = nodes[stack.back()];
+        stack.pop_back();
+        if (node.count <= 1) continue;
+
+        uint32* first = order.data() + node.leftFirst;
+        uint32* last  = first + node.count;
+
+        // Bin by centroid, the box spanned by the primitives themselves is too loose a range
+        BinBounds centroidBounds;
+        for (uint32* p = first; p != last; ++p)
+            centroidBounds.Grow(centroids[*p], centroids[*p]);
+
+        int   bestAxis = -1;
+        int   bestBin  = 0;
+        float bestCost = std::numeric_limits<float>::max();
+        for (int axis = 0; axis < 3; ++axis)
+        {
+            const float lo     = centroidBounds.min[axis];
+            const float extent = centroidBounds.max[axis] - lo;
+            if (extent <= 0.0f) continue;
+
+            const float scale = s_binCount / extent;
+            BinBounds bins[s_binCount];
+            for (uint32* p = first; p != last; ++p)
+            {
+                const uint32 bin = std::min(s_binCount - 1, static_cast<uint32>((centroids[*p][axis] - lo) * scale));
+                bins[bin].Grow(bounds[*p].min, bounds[*p].max);
+                ++bins[bin].count;
+            }
+
+            // Sweep from both ends: cost of splitting after bin i is left area * count + right area * count
+            float     leftCost[s_binCount - 1];
+            BinBounds sweep;
+            for (uint32 i = 0; i < s_binCount - 1; ++i)
+            {
+                if (bins[i].count) { sweep.Grow(bins[i].min, bins[i].max); sweep.count += bins[i].count; }
+                leftCost[i] = sweep.Area() * sweep.count;
+            }
+            sweep = BinBounds();
+            for (uint32 i = s_binCount - 1; i > 0; --i)
+            {
+                if (bins[i].count) { sweep.Grow(bins[i].min, bins[i].max); sweep.count += bins[i].count; }
+                const float cost = leftCost[i - 1] + sweep.Area() * sweep.count;
+                if (cost < bestCost)
+                {
+                    bestCost = cost;
+                    bestAxis = axis;
+                    bestBin  = static_cast<int>(i);
+                }
+            }
+        }
+
+        const float area      = HalfArea(node.min, node.max);
+        const float leafCost  = static_cast<float>(node.count) * area;
+        const float splitCost = s_traversalCost * area + bestCost;
+        if (node.count <= maxLeafSize && (bestAxis < 0 || splitCost >= leafCost)) continue;
+
+        uint32* middle = first;
+        if (bestAxis >= 0)
+        {
+            const float lo    = centroidBounds.min[bestAxis];
+            const float scale = s_binCount / (centroidBounds.max[bestAxis] - lo);
+            middle = std::partition(first, last, [&](uint32 p) {
+                return static_cast<int>(std::min(s_binCount - 1, static_cast<uint32>((centroids[p][bestAxis] - lo) * scale))) < bestBin;
+            });
+        }
+        // Every centroid in one spot: any split is as good as another
+        if (middle == first || middle == last)
+            middle = first + node.count / 2;
+
+        const uint32 leftCount = static_cast<uint32>(middle - first);
+        const uint32 start     = node.leftFirst;
+        const uint32 left      = static_cast<uint32>(nodes.size());
+        nodes.push_back(BVHNode{ Vec3(0.0f), start, Vec3(0.0f), leftCount });
+        nodes.push_back(BVHNode{ Vec3(0.0f), start + leftCount, Vec3(0.0f), node.count - leftCount });
+        FitNode(nodes[left], bounds, first);
+        FitNode(nodes[left + 1], bounds, middle);
+
+        node.leftFirst = left;
+        node.count     = 0;
+        stack.push_back(left);
+        stack.push_back(left + 1);
+    }
+}
+
+void RefitBVH(std::span<const BoundingBox> bounds, std::span<const uint32> order, std::vector<BVHNode>& nodes)
+{
+    // Children are always created after their parent, so a reverse sweep sees them first
+    for (size_t i = nodes.size(); i-- > 0;)
+    {
+        BVHNode& node = nodes[i];
+        if (node.IsLeaf())
+        {
+            FitNode(node, bounds, order.data() + node.leftFirst);
+            continue;
+        }
+        const BVHNode& left  = nodes[node.leftFirst];
+        const BVHNode& right = nodes[node.leftFirst + 1];
+        node.min = glm::min(left.min, right.min);
+        node.max = glm::max(left.max, right.max);
+    }
+}
+
+float GetBVHCost(std::span<const BVHNode> nodes)
+{
+    if (nodes.empty()) return 0.0f;
+
+    float cost = 0.0f;
+    for (const BVHNode& node : nodes)
+        cost += HalfArea(node.min, node.max) * (node.IsLeaf() ? static_cast<float>(node.count) : s_traversalCost);
+
+    const float rootArea = HalfArea(nodes[0].min, nodes[0].max);
+    return rootArea > 0.0f ? cost / rootArea : 0.0f;
+}
+
+} // namespace TLETC
@@ -0,0 +1,367 @@
+#include "TLETC/Core/JobSystem.h"
+
+#include <cstdint>
+
+namespace TLETC
+{
+
+namespace
+{
+
+// Which system's deque the current thread owns, if any
+thread_local const JobSystem* s_queueOwner = nullptr;
+thread_local uint32           s_queueIndex = 0;
+
+// Finished jobs are kept per thread for reuse, so starting one rarely allocates
+constexpr size_t s_maxCachedJobs = 4096;
+
+// Idle workers look around this many times before going to sleep
+constexpr int s_idleSpins = 64;
+
+} // namespace
+
+// ============================================================================
+// Chase-Lev work-stealing deque (Le, Pop, Cohen, Zappa Nardelli 2013)
+// ============================================================================
+
+class JobSystem::Deque
+{
+public:
+    static constexpr int64_t Capacity = 4096;
+
+    Deque() : top_(0), bottom_(0)
+    {
+        for (auto& slot : slots_)
+            slot.store(nullptr, std::memory_order_relaxed);
+    }
+
+    // Owner only. False when full
+    bool Push(Job* job)
+    {
+        const int64_t bottom = bottom_.load(std::memory_order_relaxed);
+        const int64_t top    = top_.load(std::memory_order_acquire);
+        if (bottom - top >= Capacity)
+            return false;
+
+        slots_[bottom & (Capacity - 1)].store(job, std::memory_order_relaxed);
+        bottom_.store(bottom + 1, std::memory_order_release);  // Publishes the job to thieves
+        return true;
+    }
+
+    // Owner only, newest first
+    Job* Pop()
+    {
+        const int64_t bottom = bottom_.load(std::memory_order_relaxed) - 1;
+        bottom_.store(bottom, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t top = top_.load(std::memory_order_relaxed);
+
+        if (top > bottom)
+        {
+            bottom_.store(bottom + 1, std::memory_order_relaxed);
+            return nullptr;
+        }
+
+        Job* job = slots_[bottom & (Capacity - 1)].load(std::memory_order_relaxed);
+        if (top == bottom)
+        {
+            // Last one, a thief may be after it too
+            if (!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                job = nullptr;
+            bottom_.store(bottom + 1, std::memory_order_relaxed);
+        }
+        return job;
+    }
+
+    // Any thread, oldest first
+    Job* Steal()
+    {
+        int64_t top = top_.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const int64_t bottom = bottom_.load(std::memory_order_acquire);
+        if (top >= bottom)
+            return nullptr;
+
+        Job* job = slots_[top & (Capacity - 1)].load(std::memory_order_relaxed);
+        if (!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+            return nullptr;
+        return job;
+    }
+
+private:
+    // Thieves and the owner work opposite ends, keep them off each other's cache line
+    alignas(64) std::atomic<int64_t> top_;
+    alignas(64) std::atomic<int64_t> bottom_;
+    alignas(64) std::atomic<Job*>    slots_[Capacity];
+};
+
+// ============================================================================
+// Job allocation
+// ============================================================================
+
+namespace
+{
+
+// Raw job-sized blocks, jobs are trivially destructible
+struct JobCache
+{
+    std::vector<void*> free;
+
+    ~JobCache()
+    {
+        for (void* memory : free)
+            ::operator delete(memory);
+    }
+};
+
+thread_local JobCache s_jobCache;
+
+} // namespace
+
+JobSystem::Job* JobSystem::AllocateJob()
+{
+    static_assert(std::is_trivially_destructible_v<Job>);
+
+    void* memory;
+    if (s_jobCache.free.empty())
+    {
+        memory = ::operator new(sizeof(Job));
+    }
+    else
+    {
+        memory = s_jobCache.free.back();
+        s_jobCache.free.pop_back();
+    }
+    return new (memory) Job;
+}
+
+void JobSystem::FreeJob(Job* job)
+{
+    // Jobs end up on whichever thread ran them, each thread recycles what it finished
+    if (s_jobCache.free.size() < s_maxCachedJobs)
+        s_jobCache.free.push_back(job);
+    else
+        ::operator delete(job);
+}
+
+// ============================================================================
+// JobSystem
+// ============================================================================
+
+JobSystem::JobSystem()
+    : queuedJobs_(0)
+    , sleepingWorkers_(0)
+    , running_(false)
+{
+}
+
+JobSystem::~JobSystem()
+{
+    Shutdown();
+}
+
+bool JobSystem::Initialize(uint32 workerCount)
+{
+    if (IsInitialized())
+        return true;
+
+    if (workerCount == 0)
+        workerCount = std::max(1u, std::thread::hardware_concurrency()) - 1;
+    if (workerCount == 0)
+        return true;  // One hardware thread, everything runs on the caller
+
+    queues_.clear();
+    for (uint32 i = 0; i <= workerCount; ++i)
+        queues_.push_back(MakeUnique<Deque>());
+
+    s_queueOwner = this;
+    s_queueIndex = 0;
+    running_.store(true);
+
+    workers_.reserve(workerCount);
+    for (uint32 i = 1; i <= workerCount; ++i)
+        workers_.emplace_back(&JobSystem::WorkerLoop, this, i);
+    return true;
+}
+
+void JobSystem::Shutdown()
+{
+    if (!IsInitialized())
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex_);
+        running_.store(false);
+    }
+    wake_.notify_all();
+    for (std::thread& worker : workers_)
+        worker.join();
+    workers_.clear();
+
+    // Anything left would otherwise never finish its counter
+    while (Job* job = FindJob(s_queueOwner == this ? s_queueIndex : static_cast<uint32>(queues_.size())))
+        Execute(job);
+
+    queues_.clear();
+    if (s_queueOwner == this)
+        s_queueOwner = nullptr;
+}
+
+void JobSystem::Wait(JobCounter& counter)
+{
+    const uint32 queueIndex = s_queueOwner == this ? s_queueIndex : static_cast<uint32>(queues_.size());
+    while (!counter.IsDone())
+    {
+        if (Job* job = FindJob(queueIndex))
+            Execute(job);
+        else
+            std::this_thread::yield();
+    }
+}
+
+void JobSystem::Submit(Job* job, JobCounter* dependency)
+{
+    if (dependency && !dependency->IsDone())
+    {
+        std::lock_guard<std::mutex> lock(dependency->mutex_);
+        if (!dependency->IsDone())
+        {
+            dependency->waiters_.push_back(job);
+            return;
+        }
+    }
+    Push(job);
+}
+
+void JobSystem::Push(Job* job)
+{
+    if (!IsInitialized())
+    {
+        Execute(job);
+        return;
+    }
+
+    if (s_queueOwner == this)
+    {
+        if (!queues_[s_queueIndex]->Push(job))
+        {
+            Execute(job);  // Deque full, no point queueing more
+            return;
+        }
+    }
+    else
+    {
+        std::lock_guard<std::mutex> lock(externalMutex_);
+        externalJobs_.push_back(job);
+    }
+
+    queuedJobs_.fetch_add(1);
+    if (sleepingWorkers_.load() > 0)
+    {
+        // Taking the lock makes sure a worker about to sleep sees the new job first
+        { std::lock_guard<std::mutex> lock(sleepMutex_); }
+        wake_.notify_one();
+    }
+}
+
+JobSystem::Job* JobSystem::FindJob(uint32 queueIndex)
+{
+    const uint32 queueCount = static_cast<uint32>(queues_.size());
+    if (queueCount == 0)
+        return nullptr;
+
+    Job* job = nullptr;
+    if (queueIndex < queueCount)
+        job = queues_[queueIndex]->Pop();
+
+    if (!job)
+    {
+        std::unique_lock<std::mutex> lock(externalMutex_, std::try_to_lock);
+        if (lock.owns_lock() && !externalJobs_.empty())
+        {
+            job = externalJobs_.back();
+            externalJobs_.pop_back();
+        }
+    }
+
+    // Steal, starting from the next queue over so thieves spread out
+    for (uint32 i = 1; !job && i <= queueCount; ++i)
+    {
+        const uint32 victim = (queueIndex + i) % queueCount;
+        if (victim != queueIndex)
+            job = queues_[victim]->Steal();
+    }
+
+    if (job)
+        queuedJobs_.fetch_sub(1);
+    return job;
+}
+
+void JobSystem::Execute(Job* job)
+{
+    JobCounter* counter = job->counter;
+    job->run(*job);
+    FreeJob(job);
+
+    if (counter)
+        Finish(*counter);
+}
+
+void JobSystem::Finish(JobCounter& counter)
+{
+    // Not the last one: nobody can be done waiting yet, no lock needed
+    uint32 pending = counter.pending_.load(std::memory_order_relaxed);
+    while (pending > 1)
+    {
+        if (counter.pending_.compare_exchange_weak(pending, pending - 1, std::memory_order_acq_rel, std::memory_order_relaxed))
+            return;
+    }
+
+    // Possibly the last one: release the parked dependents under the lock, after which
+    // the counter is never touched again (its owner may destroy it the moment it reads zero)
+    std::vector<Job*> released;
+    {
+        std::lock_guard<std::mutex> lock(counter.mutex_);
+        if (counter.pending_.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            released.swap(counter.waiters_);
+    }
+    for (Job* job : released)
+        Push(job);
+}
+
+void JobSystem::WorkerLoop(uint32 queueIndex)
+{
+    s_queueOwner = this;
+    s_queueIndex = queueIndex;
+
+    int idle = 0;
+    while (running_.load(std::memory_order_relaxed))
+    {
+        if (Job* job = FindJob(queueIndex))
+        {
+            Execute(job);
+            idle = 0;
+            continue;
+        }
+
+        if (++idle < s_idleSpins)
+        {
+            std::this_thread::yield();
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(sleepMutex_);
+        sleepingWorkers_.fetch_add(1);
+        wake_.wait(lock, [this]() { return queuedJobs_.load() > 0 || !running_.load(); });
+        sleepingWorkers_.fetch_sub(1);
+        idle = 0;
+    }
+}
+
+JobCounter::~JobCounter()
+{
+    // A Finish on another thread may still be releasing the lock
+    std::lock_guard<std::mutex> lock(mutex_);
+}
+
+} // namespace TLETC
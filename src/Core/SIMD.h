@@ -0,0 +1,14 @@
+#pragma once
+
+// Which vector instruction set the library's SIMD paths are compiled for, picked from the
+// target flags: AVX when TLETC_ENABLE_AVX is on, SSE2 on any x86-64 (or x86 with SSE2), and
+// plain scalar code everywhere else. Private to the library, for .cpp files only.
+
+#if defined(__AVX__)
+    #include <immintrin.h>
+    #define TLETC_SIMD_AVX 1
+    #define TLETC_SIMD_SSE 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define TLETC_SIMD_SSE 1
+#endif
@@ -0,0 +1,223 @@
+#include "GLGeometryPool.h"
+#include <glad/gl.h>
+#include <algorithm>
+#include <iostream>
+
+namespace TLETC {
+
+static constexpr uint32 s_vertexBinding = 0;
+
+// A buffer of exactly size bytes, or 0. Checked through the buffer's own size rather than
+// glGetError, which would report (and swallow) whatever error other code left pending
+static uint32 CreateBuffer(size_t size)
+{
+    uint32 buffer = 0;
+    glCreateBuffers(1, &buffer);
+    glNamedBufferData(buffer, static_cast<GLsizeiptr>(size), nullptr, GL_STATIC_DRAW);
+    
+    GLint64 allocated = 0;
+    glGetNamedBufferParameteri64v(buffer, GL_BUFFER_SIZE, &allocated);
+    if (static_cast<size_t>(allocated) != size)
+    {
+        glDeleteBuffers(1, &buffer);
+        return 0;
+    }
+    return buffer;
+}
+
+GLGeometryPool::GLGeometryPool()
+    : vao_(0), vertexBuffer_(0), indexBuffer_(0), stride_(0), indexSize_(sizeof(uint32))
+    , minVertexCapacity_(0), minIndexCapacity_(0), instanceBuffer_(0), instanceOffset_(0)
+{
+}
+
+GLGeometryPool::~GLGeometryPool()
+{
+    Destroy();
+}
+
+bool GLGeometryPool::Create(uint32 stride, uint32 indexSize, size_t vertexCapacity, size_t indexCapacity)
+{
+    Destroy();
+    stride_    = stride;
+    indexSize_ = indexSize;
+    
+    vertexBuffer_ = CreateBuffer(vertexCapacity * stride);
+    indexBuffer_  = CreateBuffer(indexCapacity * indexSize_);
+    if (!vertexBuffer_ || !indexBuffer_)
+    {
+        std::cerr << "Failed to create geometry pool buffers" << std::endl;
+        Destroy();
+        return false;
+    }
+    vertices_.Reset(vertexCapacity);
+    indices_.Reset(indexCapacity);
+    minVertexCapacity_ = vertexCapacity;
+    minIndexCapacity_  = indexCapacity;
+    
+    glCreateVertexArrays(1, &vao_);
+    glVertexArrayVertexBuffer(vao_, s_vertexBinding, vertexBuffer_, 0, stride_);
+    glVertexArrayElementBuffer(vao_, indexBuffer_);
+    return true;
+}
+
+void GLGeometryPool::Destroy()
+{
+    if (vao_)
+        glDeleteVertexArrays(1, &vao_);
+    if (vertexBuffer_)
+        glDeleteBuffers(1, &vertexBuffer_);
+    if (indexBuffer_)
+        glDeleteBuffers(1, &indexBuffer_);
+    
+    vao_            = 0;
+    vertexBuffer_   = 0;
+    indexBuffer_    = 0;
+    instanceBuffer_ = 0;
+    instanceOffset_ = 0;
+    vertices_.Reset(0);
+    indices_.Reset(0);
+}
+
+bool GLGeometryPool::Allocate(size_t vertexCount, size_t indexCount, Range& range)
+{
+    if (!vao_) return false;
+    
+    const uint32 vertexBuffer = vertexBuffer_;
+    const uint32 indexBuffer  = indexBuffer_;
+    if (!Reserve(vertices_, vertexBuffer_, stride_, vertexCount)) return false;
+    if (!Reserve(indices_, indexBuffer_, indexSize_, indexCount)) return false;
+    
+    vertices_.Allocate(vertexCount, range.firstVertex);
+    indices_.Allocate(indexCount, range.firstIndex);
+    range.vertexCount = vertexCount;
+    range.indexCount  = indexCount;
+    
+    // Growing replaced the buffers the VAO points at
+    if (vertexBuffer_ != vertexBuffer)
+        glVertexArrayVertexBuffer(vao_, s_vertexBinding, vertexBuffer_, 0, stride_);
+    if (indexBuffer_ != indexBuffer)
+        glVertexArrayElementBuffer(vao_, indexBuffer_);
+    return true;
+}
+
+bool GLGeometryPool::Reserve(RangeAllocator& allocator, uint32& buffer, size_t elementSize, size_t count)
+{
+    if (count == 0 || allocator.GetLargestFree() >= count) return true;
+    
+    // Fragmented or full - double until the request fits at the end
+    const size_t oldCapacity = allocator.GetCapacity();
+    size_t capacity = std::max<size_t>(oldCapacity, 1);
+    while (capacity - oldCapacity < count)
+        capacity *= 2;
+    
+    const uint32 grown = CreateBuffer(capacity * elementSize);
+    if (!grown)
+    {
+        std::cerr << "Failed to grow geometry pool to " << capacity * elementSize << " bytes" << std::endl;
+        return false;
+    }
+    
+    // Copied on the GPU, the old buffer is released once the copy is done with it
+    glCopyNamedBufferSubData(buffer, grown, 0, 0, oldCapacity * elementSize);
+    glDeleteBuffers(1, &buffer);
+    buffer = grown;
+    
+    allocator.Grow(capacity);
+    return true;
+}
+
+void GLGeometryPool::Free(const Range& range)
+{
+    vertices_.Free(range.firstVertex, range.vertexCount);
+    indices_.Free(range.firstIndex, range.indexCount);
+}
+
+bool GLGeometryPool::IsUnderused() const
+{
+    const bool shrinkable = vertices_.GetCapacity() > minVertexCapacity_ || indices_.GetCapacity() > minIndexCapacity_;
+    return shrinkable && GetUsedBytes() * 4 < GetBytes();
+}
+
+// Smallest doubling of the minimum with room for twice what is used
+static size_t RepackedCapacity(size_t used, size_t minimum)
+{
+    size_t capacity = std::max<size_t>(minimum, 1);
+    while (capacity < used * 2)
+        capacity *= 2;
+    return capacity;
+}
+
+bool GLGeometryPool::Repack(std::span<Range* const> ranges)
+{
+    if (!vao_) return false;
+    
+    const size_t vertexCapacity = RepackedCapacity(vertices_.GetUsed(), minVertexCapacity_);
+    const size_t indexCapacity  = RepackedCapacity(indices_.GetUsed(), minIndexCapacity_);
+    
+    const uint32 vertexBuffer = CreateBuffer(vertexCapacity * stride_);
+    const uint32 indexBuffer  = CreateBuffer(indexCapacity * indexSize_);
+    if (!vertexBuffer || !indexBuffer)
+    {
+        std::cerr << "Failed to repack geometry pool" << std::endl;
+        glDeleteBuffers(1, &vertexBuffer);
+        glDeleteBuffers(1, &indexBuffer);
+        return false;
+    }
+    
+    // Fresh allocators hand the ranges out back to back, copied over on the GPU
+    vertices_.Reset(vertexCapacity);
+    indices_.Reset(indexCapacity);
+    for (Range* range : ranges)
+    {
+        size_t firstVertex = 0;
+        size_t firstIndex  = 0;
+        vertices_.Allocate(range->vertexCount, firstVertex);
+        indices_.Allocate(range->indexCount, firstIndex);
+        if (range->vertexCount > 0)
+            glCopyNamedBufferSubData(vertexBuffer_, vertexBuffer, range->firstVertex * stride_, firstVertex * stride_, range->vertexCount * stride_);
+        if (range->indexCount > 0)
+            glCopyNamedBufferSubData(indexBuffer_, indexBuffer, range->firstIndex * indexSize_, firstIndex * indexSize_, range->indexCount * indexSize_);
+        range->firstVertex = firstVertex;
+        range->firstIndex  = firstIndex;
+    }
+    
+    glDeleteBuffers(1, &vertexBuffer_);
+    glDeleteBuffers(1, &indexBuffer_);
+    vertexBuffer_ = vertexBuffer;
+    indexBuffer_  = indexBuffer;
+    glVertexArrayVertexBuffer(vao_, s_vertexBinding, vertexBuffer_, 0, stride_);
+    glVertexArrayElementBuffer(vao_, indexBuffer_);
+    return true;
+}
+
+void GLGeometryPool::WriteVertices(size_t firstVertex, const void* data, size_t size)
+{
+    glNamedBufferSubData(vertexBuffer_, firstVertex * stride_, size, data);
+}
+
+void GLGeometryPool::WriteIndices(size_t firstIndex, const void* data, size_t size)
+{
+    glNamedBufferSubData(indexBuffer_, firstIndex * indexSize_, size, data);
+}
+
+void GLGeometryPool::BindInstanceBuffer(uint32 binding, uint32 buffer, size_t offset, uint32 stride)
+{
+    if (instanceBuffer_ == buffer && instanceOffset_ == offset) return;
+    
+    glVertexArrayVertexBuffer(vao_, binding, buffer, offset, stride);
+    instanceBuffer_ = buffer;
+    instanceOffset_ = offset;
+}
+
+size_t GLGeometryPool::GetBytes() const
+{
+    return vertices_.GetCapacity() * stride_ + indices_.GetCapacity() * indexSize_;
+}
+
+size_t GLGeometryPool::GetUsedBytes() const
+{
+    return vertices_.GetUsed() * stride_ + indices_.GetUsed() * indexSize_;
+}
+
+} // namespace TLETC
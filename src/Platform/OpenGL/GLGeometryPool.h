@@ -0,0 +1,95 @@
+#pragma once
+
+#include "TLETC/Core/Types.h"
+#include "TLETC/Rendering/RangeAllocator.h"
+
+#include <span>
+
+namespace TLETC {
+
+/**
+ * GLGeometryPool - Shared vertex and index buffers for every mesh of one vertex format and index type
+ *
+ * Meshes get a range of vertices and a range of indices (16 or 32-bit, one size per pool)
+ * out of two large buffers,
+ * and all of them are drawn through the pool's single VAO: indices stay relative to the
+ * mesh and the draw's base vertex points at its range. Switching meshes is then just a
+ * different offset, which is what lets one glMultiDrawElementsIndirect cover many meshes.
+ *
+ * Running out of room moves to buffers twice the size (copied on the GPU). Offsets are
+ * in vertices and indices, so they stay valid, only the buffer names change. Freeing never
+ * shrinks the buffers by itself; once the pool is mostly empty, Repack moves what is left
+ * into smaller ones (and hands out new offsets).
+ *
+ * The VAO is edited through direct state access and never bound here, so it does not
+ * disturb the device's bound-VAO cache. Attribute formats are set up by the device.
+ *
+ * usage : GLGeometryPool::Range range;
+ *         if (pool.Allocate(vertexCount, indexCount, range))
+ *             pool.WriteVertices(range.firstVertex, vertices.data(), vertices.size());
+ */
+class GLGeometryPool
+{
+public:
+    struct Range
+    {
+        size_t firstVertex = 0;
+        size_t vertexCount = 0;
+        size_t firstIndex  = 0;
+        size_t indexCount  = 0;
+    };
+    
+    GLGeometryPool();
+    ~GLGeometryPool();
+    
+    GLGeometryPool(const GLGeometryPool&)            = delete;
+    GLGeometryPool& operator=(const GLGeometryPool&) = delete;
+    
+    bool Create(uint32 stride, uint32 indexSize, size_t vertexCapacity, size_t indexCapacity);
+    void Destroy();
+    
+    // Grows the buffers if needed, false only if that fails
+    bool Allocate(size_t vertexCount, size_t indexCount, Range& range);
+    void Free(const Range& range);
+    
+    // Under a quarter of the memory in use, and larger than the pool was created
+    bool IsUnderused() const;
+    // Packs every live range (all of them, updated in place) into buffers with room for twice
+    // what they use, no smaller than the pool was created. False if the new buffers fail
+    bool Repack(std::span<Range* const> ranges);
+    
+    // Offsets in vertices / indices from the start of the pool, sizes in bytes. Indices are
+    // GetIndexSize() bytes each
+    void WriteVertices(size_t firstVertex, const void* data, size_t size);
+    void WriteIndices(size_t firstIndex, const void* data, size_t size);
+    
+    // Per-instance binding of the shared VAO, skipped if it already points there
+    void BindInstanceBuffer(uint32 binding, uint32 buffer, size_t offset, uint32 stride);
+    
+    uint32 GetVertexArray() const    { return vao_; }
+    uint32 GetVertexBuffer() const   { return vertexBuffer_; }
+    uint32 GetIndexBuffer() const    { return indexBuffer_; }
+    uint32 GetStride() const         { return stride_; }
+    uint32 GetIndexSize() const      { return indexSize_; }
+    size_t GetVertexCapacity() const { return vertices_.GetCapacity(); }
+    size_t GetIndexCapacity() const  { return indices_.GetCapacity(); }
+    size_t GetBytes() const;     // Allocated GPU memory, used or not
+    size_t GetUsedBytes() const;
+
+private:
+    bool Reserve(RangeAllocator& allocator, uint32& buffer, size_t elementSize, size_t count);
+    
+    uint32         vao_;
+    uint32         vertexBuffer_;
+    uint32         indexBuffer_;
+    uint32         stride_;
+    uint32         indexSize_;
+    RangeAllocator vertices_;
+    RangeAllocator indices_;
+    size_t         minVertexCapacity_;  // As created, Repack doesn't go below
+    size_t         minIndexCapacity_;
+    uint32         instanceBuffer_;  // What the instance binding points at
+    size_t         instanceOffset_;
+};
+
+} // namespace TLETC
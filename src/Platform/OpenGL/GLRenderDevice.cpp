@@ -1,13 +1,71 @@
 #include "GLRenderDevice.h"
+#include "GLFrustumCull.h"
 #include <glad/gl.h>
 #include <GLFW/glfw3.h>
 #include <glm/gtc/type_ptr.hpp>
+#include <algorithm>
+#include <cstring>
 #include <iostream>
+#include <numeric>
 #include <sstream>
 
 namespace TLETC {
 
-GLRenderDevice::GLRenderDevice() : currentShader_(), initialized_(false)
+static constexpr UniformID s_modelUniform("u_model");
+static constexpr UniformID s_positionScaleUniform("u_positionScale");
+static constexpr UniformID s_positionOffsetUniform("u_positionOffset");
+static constexpr UniformID s_cullCommandStrideUniform("u_commandStride");
+
+static constexpr uint32 s_instanceAttribLocation = 4;   // mat4 takes locations 4, 5, 6 and 7
+static constexpr uint32 s_instanceBinding        = 4;   // Past the per-attribute bindings 0-3
+static constexpr uint32 s_objectIndexBinding     = 5;
+static constexpr size_t s_streamFrameSize        = 4 * 1024 * 1024;  // Per frame, grows on demand
+static constexpr size_t s_objectFrameSize        = 4 * 1024 * 1024;  // 32k objects per frame, grows on demand
+static constexpr size_t s_poolVertexCapacity     = 1 << 16;          // Per geometry pool, grows on demand
+static constexpr size_t s_poolIndexCapacity      = 1 << 18;
+static constexpr uint32 s_poolNarrowIndices      = 1u << 31;         // Pool key bit, above every VertexCompression flag
+
+// Command layouts read by glMultiDraw*Indirect
+struct DrawElementsIndirectCommand
+{
+    uint32 count;
+    uint32 instanceCount;
+    uint32 firstIndex;
+    int32  baseVertex;
+    uint32 baseInstance;
+};
+
+struct DrawArraysIndirectCommand
+{
+    uint32 count;
+    uint32 instanceCount;
+    uint32 first;
+    uint32 baseInstance;
+};
+
+// Sphere around a box, center + radius
+static Vec4 GetBoundingSphere(const BoundingBox& bounds)
+{
+    return Vec4(bounds.GetCenter(), length(bounds.GetSize()) * 0.5f);
+}
+
+// Model and normal matrix per transform, returns the entry after the last one written
+static ObjectData* WriteObjects(ObjectData* objects, std::span<const Mat4> transforms)
+{
+    for (const Mat4& transform : transforms)
+    {
+        objects->model  = transform;
+        objects->normal = Mat4(transpose(inverse(Mat3(transform))));
+        ++objects;
+    }
+    return objects;
+}
+
+GLRenderDevice::GLRenderDevice() 
+    : lastProgramUniforms_(nullptr), lastProgram_(0), meshMemoryBudget_(0), ownedMeshBytes_(0), frameIndex_(0), uniformBufferAlignment_(256)
+    , objectBinding_(0), objectBindingOffset_(0), objectIndexBuffer_(0), objectIndexCapacity_(0)
+    , gpuCulling_(false), cullProgram_(), cullOutputBuffer_(0), cullOutputSize_(0), storageBufferAlignment_(256)
+    , currentShader_(), initialized_(false)
 {
 }
 
@@ -37,6 +95,41 @@ bool GLRenderDevice::Initialize()
     glCullFace(GL_BACK);
     glFrontFace(GL_CCW);
     
+    // Mirror it in the state cache
+    state_ = StateCache();
+    state_.depthTest = true;
+    state_.culling   = true;
+    GLint viewport[4];
+    glGetIntegerv(GL_VIEWPORT, viewport);
+    for (int i = 0; i < 4; ++i)
+        state_.viewport[i] = static_cast<uint32>(viewport[i]);
+    
+    GLint uniformAlignment = 0;
+    glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &uniformAlignment);
+    if (uniformAlignment > 0)
+        uniformBufferAlignment_ = static_cast<size_t>(uniformAlignment);
+    
+    GLint storageAlignment = 0;
+    glGetIntegerv(GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT, &storageAlignment);
+    if (storageAlignment > 0)
+        storageBufferAlignment_ = static_cast<size_t>(storageAlignment);
+    
+    // Per-frame streaming memory (instances, dynamic data, frame uniforms). Both buffers bind
+    // frame regions as UBO/SSBO ranges, so regions start at either offset alignment
+    const size_t frameAlignment = std::lcm(uniformBufferAlignment_, storageBufferAlignment_);
+    if (!streamBuffer_.Create(s_streamFrameSize, frameAlignment))
+        return false;
+    
+    // Per-object data, indexed by base instance
+    if (!objectBuffer_.Create(s_objectFrameSize, std::lcm(frameAlignment, sizeof(ObjectData))))
+        return false;
+    objectBinding_       = 0;
+    objectBindingOffset_ = 0;
+    EnsureObjectIndexCapacity();
+    
+    // GPU culling stays unavailable (EnableGpuCulling does nothing) if this fails to build
+    cullProgram_ = CreateComputeProgram(CreateShader(ShaderType::Compute, s_frustumCullSource));
+    
     initialized_ = true;
     return true;
 }
@@ -47,30 +140,50 @@ void GLRenderDevice::Shutdown()
         return;
     
     // Clean up mesh cache
-    for (auto& pair : meshCache_) 
-    {
-        glDeleteVertexArrays(1, &pair.second.vao);
-        DestroyBuffer(pair.second.posVBO);
-        DestroyBuffer(pair.second.nrmVBO);
-        DestroyBuffer(pair.second.uvsVBO);
-        DestroyBuffer(pair.second.clrVBO);
-        if (pair.second.ibo.IsValid())
-            DestroyBuffer(pair.second.ibo);
-    }
-    meshCache_.clear();
+    while (!meshLRU_.empty())
+        ReleaseMeshData(meshLRU_.back());
+    BindVertexArray(0);
+    geometryPools_.clear();
+    UpdateMeshBytesResident();
+    
+    streamBuffer_.Destroy();
+    objectBuffer_.Destroy();
+    glDeleteBuffers(1, &objectIndexBuffer_);
+    objectIndexBuffer_   = 0;
+    objectIndexCapacity_ = 0;
+    
+    DestroyShader(cullProgram_);
+    cullProgram_.Reset();
+    glDeleteBuffers(1, &cullOutputBuffer_);
+    cullOutputBuffer_ = 0;
+    cullOutputSize_   = 0;
     
     initialized_ = false;
 }
 
 void GLRenderDevice::BeginFrame() 
 {
-    // Nothing specific needed for OpenGL begin frame
+    ResetStats();
+    ++frameIndex_;
+    
+    // Reuses the region written three frames ago, waits only if the GPU is still on it
+    if (streamBuffer_.BeginFrame())
+        ++stats_.streamStalls;
+    if (objectBuffer_.BeginFrame())
+        ++stats_.streamStalls;
+    
+    // Free the GPU copies of meshes that no longer exist
+    destroyedMeshes_.clear();
+    Mesh::CollectDestroyed(destroyedMeshes_);
+    for (uint32 meshID : destroyedMeshes_)
+        ReleaseMeshData(meshID);
 }
 
 void GLRenderDevice::EndFrame() 
 {
-    // Nothing specific needed for OpenGL end frame
-    // Actual swap buffers is handled by the window system
+    // Fence this frame's stream region. Actual swap buffers is handled by the window system
+    streamBuffer_.EndFrame();
+    objectBuffer_.EndFrame();
 }
 
 void GLRenderDevice::Clear(const Vec4& color) 
@@ -92,6 +205,9 @@ BufferHandle GLRenderDevice::CreateVertexBuffer(const void* data, size_t size, B
 
 BufferHandle GLRenderDevice::CreateIndexBuffer(const void* data, size_t size, BufferUsage usage) 
 {
+    // The element binding is VAO state, keep it away from mesh VAOs
+    BindVertexArray(0);
+    
     uint32 ibo;
     glGenBuffers(1, &ibo);
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ibo);
@@ -118,6 +234,71 @@ void GLRenderDevice::DestroyBuffer(BufferHandle buffer)
     glDeleteBuffers(1, &id);
 }
 
+BufferHandle GLRenderDevice::CreateUniformBuffer(const void* data, size_t size, BufferUsage usage)
+{
+    uint32 ubo;
+    glGenBuffers(1, &ubo);
+    glBindBuffer(GL_UNIFORM_BUFFER, ubo);
+    glBufferData(GL_UNIFORM_BUFFER, size, data, GetGLUsage(usage));
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    
+    return BufferHandle(ubo);
+}
+
+void GLRenderDevice::BindUniformBuffer(uint32 slot, BufferHandle buffer, size_t offset, size_t size)
+{
+    if (!buffer.IsValid()) 
+    {
+        glBindBufferBase(GL_UNIFORM_BUFFER, slot, 0);
+        return;
+    }
+    
+    if (size == 0)
+        glBindBufferBase(GL_UNIFORM_BUFFER, slot, buffer.GetID());
+    else
+        glBindBufferRange(GL_UNIFORM_BUFFER, slot, buffer.GetID(), offset, size);
+}
+
+void GLRenderDevice::BindUniformBlock(ShaderHandle shader, std::string_view blockName, uint32 slot)
+{
+    if (!shader.IsValid()) return;
+    
+    const std::string name(blockName);
+    const GLuint blockIndex = glGetUniformBlockIndex(shader.GetID(), name.c_str());
+    if (blockIndex != GL_INVALID_INDEX)
+        glUniformBlockBinding(shader.GetID(), blockIndex, slot);
+}
+
+void GLRenderDevice::SetFrameData(const Mat4& view, const Mat4& projection, float time, float deltaTime)
+{
+    // Straight into this frame's stream region, then every program sees it through the slot
+    const StreamAllocation allocation = AllocateStream(sizeof(FrameData), uniformBufferAlignment_);
+    if (!allocation.IsValid()) return;
+    
+    FrameData* frameData      = static_cast<FrameData*>(allocation.data);
+    frameData->view           = view;
+    frameData->projection     = projection;
+    frameData->viewProjection = projection * view;
+    frameData->time           = Vec4(time, deltaTime, 0.0f, 0.0f);
+    
+    BindUniformBuffer(FrameData::Slot, allocation.buffer, allocation.offset, sizeof(FrameData));
+}
+
+StreamAllocation GLRenderDevice::AllocateStream(size_t size, size_t alignment)
+{
+    const GLStreamBuffer::Allocation allocation = streamBuffer_.Allocate(size, alignment);
+    if (!allocation.IsValid()) return StreamAllocation();
+    
+    stats_.streamBytes += allocation.size;
+    
+    StreamAllocation result;
+    result.buffer = BufferHandle(allocation.buffer);
+    result.offset = allocation.offset;
+    result.data   = allocation.data;
+    result.size   = allocation.size;
+    return result;
+}
+
 ShaderHandle GLRenderDevice::CreateShader(ShaderType type, const std::string& source) 
 {
     uint32 shader = glCreateShader(GetGLShaderType(type));
@@ -167,6 +348,8 @@ ShaderHandle GLRenderDevice::CreateShaderProgram(ShaderHandle vertexShader, Shad
     glDeleteShader(vertexShader.GetID());
     glDeleteShader(fragmentShader.GetID());
     
+    CacheProgramUniforms(program);
+    
     return ShaderHandle(program);
 }
 
@@ -197,6 +380,8 @@ ShaderHandle GLRenderDevice::CreateShaderProgram(ShaderHandle vertexShader, Shad
     glDeleteShader(geometryShader.GetID());
     glDeleteShader(fragmentShader.GetID());
     
+    CacheProgramUniforms(program);
+    
     return ShaderHandle(program);
 }
 
@@ -230,6 +415,8 @@ ShaderHandle GLRenderDevice::CreateShaderProgram(ShaderHandle vertexShader, Shad
     glDeleteShader(tessEvalShader.GetID());
     glDeleteShader(fragmentShader.GetID());
     
+    CacheProgramUniforms(program);
+    
     return ShaderHandle(program);
 }
 
@@ -264,6 +451,8 @@ ShaderHandle GLRenderDevice::CreateShaderProgram(ShaderHandle vertexShader, Shad
     glDeleteShader(geometryShader.GetID());
     glDeleteShader(fragmentShader.GetID());
     
+    CacheProgramUniforms(program);
+    
     return ShaderHandle(program);
 }
 
@@ -291,60 +480,66 @@ ShaderHandle GLRenderDevice::CreateComputeProgram(ShaderHandle computeShader)
     // Shader can be deleted after linking
     glDeleteShader(computeShader.GetID());
     
+    CacheProgramUniforms(program);
+    
     return ShaderHandle(program);
 }
 
 void GLRenderDevice::DestroyShader(ShaderHandle shader) 
 {
     if (!shader.IsValid()) return;
+    
+    if (currentShader_ == shader)
+        UseShader(ShaderHandle());
+    
+    programUniforms_.erase(shader.GetID());
+    if (lastProgram_ == shader.GetID())
+    {
+        lastProgram_         = 0;
+        lastProgramUniforms_ = nullptr;
+    }
+    
     glDeleteProgram(shader.GetID());
 }
 
 void GLRenderDevice::UseShader(ShaderHandle shader) 
 {
-    if (shader.IsValid()) 
-    {
+    currentShader_ = shader;
+    if (ChangeState(state_.program, shader.GetID()))
         glUseProgram(shader.GetID());
-        currentShader_ = shader;
-    } 
-    else 
-    {
-        glUseProgram(0);
-        currentShader_ = ShaderHandle();
-    }
 }
 
-void GLRenderDevice::SetUniformInt(ShaderHandle shader, const std::string& name, int value) 
+void GLRenderDevice::SetUniformInt(ShaderHandle shader, UniformID id, int value) 
 {
-    int location = GetUniformLocation(shader, name);
+    int location = GetUniformLocation(shader, id);
     if (location >= 0)
         glUniform1i(location, value);
 }
 
-void GLRenderDevice::SetUniformFloat(ShaderHandle shader, const std::string& name, float value) 
+void GLRenderDevice::SetUniformFloat(ShaderHandle shader, UniformID id, float value) 
 {
-    int location = GetUniformLocation(shader, name);
+    int location = GetUniformLocation(shader, id);
     if (location >= 0)
         glUniform1f(location, value);
 }
 
-void GLRenderDevice::SetUniformVec3(ShaderHandle shader, const std::string& name, const Vec3& value) 
+void GLRenderDevice::SetUniformVec3(ShaderHandle shader, UniformID id, const Vec3& value) 
 {
-    int location = GetUniformLocation(shader, name);
+    int location = GetUniformLocation(shader, id);
     if (location >= 0)
         glUniform3fv(location, 1, glm::value_ptr(value));
 }
 
-void GLRenderDevice::SetUniformVec4(ShaderHandle shader, const std::string& name, const Vec4& value) 
+void GLRenderDevice::SetUniformVec4(ShaderHandle shader, UniformID id, const Vec4& value) 
 {
-    int location = GetUniformLocation(shader, name);
+    int location = GetUniformLocation(shader, id);
     if (location >= 0)
         glUniform4fv(location, 1, glm::value_ptr(value));
 }
 
-void GLRenderDevice::SetUniformMat4(ShaderHandle shader, const std::string& name, const Mat4& value) 
+void GLRenderDevice::SetUniformMat4(ShaderHandle shader, UniformID id, const Mat4& value) 
 {
-    int location = GetUniformLocation(shader, name);
+    int location = GetUniformLocation(shader, id);
     if (location >= 0)
         glUniformMatrix4fv(location, 1, GL_FALSE, glm::value_ptr(value));
 }
@@ -353,82 +548,763 @@ void GLRenderDevice::DrawMesh(const Mesh& mesh, const Mat4& transform, Primitive
 {
     if (mesh.IsEmpty()) return;
     
-    // Check if we have this mesh cached
-    auto it = meshCache_.find(&mesh);
+    MeshData& meshData = GetMeshData(mesh, primitiveType);
+    
+    // Only shaders that predate the object buffer declare u_model, for the rest this is a miss
+    if (currentShader_.IsValid())
+        SetUniformMat4(currentShader_, s_modelUniform, transform);
+    
+    DrawObjects(meshData, primitiveType, std::span<const Mat4>(&transform, 1));
+}
+
+void GLRenderDevice::DrawMeshInstanced(const Mesh& mesh, std::span<const Mat4> transforms, PrimitiveType primitiveType)
+{
+    if (mesh.IsEmpty() || transforms.empty()) return;
+    
+    MeshData& meshData = GetMeshData(mesh, primitiveType);
+    DrawObjects(meshData, primitiveType, transforms);
+}
+
+void GLRenderDevice::DrawMeshBatch(std::span<const MeshBatch> batches, PrimitiveType primitiveType)
+{
+    // Resolve every mesh up front, so uploads happen before anything is drawn.
+    // Entries drawn this frame are never evicted, the pointers stay valid
+    batchMeshes_.clear();
+    size_t objectCount = 0;
+    for (const MeshBatch& batch : batches)
+    {
+        if (!batch.mesh || batch.mesh->IsEmpty() || batch.transforms.empty())
+        {
+            batchMeshes_.push_back(nullptr);
+            continue;
+        }
+        batchMeshes_.push_back(&GetMeshData(*batch.mesh, primitiveType));
+        objectCount += batch.transforms.size();
+    }
+    if (objectCount == 0) return;
+    
+    // One contiguous run of objects, in batch order
+    uint32 firstObject = 0;
+    ObjectData* objects = AllocateObjects(objectCount, firstObject);
+    if (!objects) return;
+    for (const MeshBatch& batch : batches)
+    {
+        if (batch.mesh && !batch.mesh->IsEmpty())
+            objects = WriteObjects(objects, batch.transforms);
+    }
+    
+    // Culled runs rebind the object storage to their compacted copy
+    const uint32 objectBuffer       = objectBinding_;
+    const size_t objectBufferOffset = objectBindingOffset_;
+    const size_t objectBufferSize   = objectBuffer_.GetFrameSize();
+    
+    const uint32 mode = GetGLPrimitiveType(primitiveType);
+    uint32 object = firstObject;
+    size_t i = 0;
+    while (i < batches.size())
+    {
+        MeshData* meshData = batchMeshes_[i];
+        if (!meshData)
+        {
+            ++i;
+            continue;
+        }
+        
+        // Meshes with their own VAO are drawn one by one
+        if (!meshData->pool)
+        {
+            const uint32 count = static_cast<uint32>(batches[i].transforms.size());
+            BindObjectStorage(objectBuffer, objectBufferOffset, objectBufferSize);
+            DrawObjectRange(*meshData, primitiveType, object, count);
+            object += count;
+            ++i;
+            continue;
+        }
+        
+        // The run of meshes from the same pool becomes one multi-draw (so one index type)
+        GLGeometryPool* pool    = meshData->pool;
+        const bool      indexed = meshData->indexCount > 0;
+        size_t end      = i;
+        size_t commands = 0;
+        while (end < batches.size())
+        {
+            const MeshData* next = batchMeshes_[end];
+            if (next && (next->pool != pool || (next->indexCount > 0) != indexed)) break;
+            if (next) ++commands;
+            ++end;
+        }
+        
+        // The cull pass reads and writes the commands as storage, which has its own alignment
+        const bool   cull        = gpuCulling_ && cullProgram_.IsValid();
+        const size_t commandSize = indexed ? sizeof(DrawElementsIndirectCommand) : sizeof(DrawArraysIndirectCommand);
+        const GLStreamBuffer::Allocation allocation = streamBuffer_.Allocate(commands * commandSize, cull ? storageBufferAlignment_ : sizeof(uint32));
+        if (!allocation.IsValid()) return;
+        stats_.streamBytes += allocation.size;
+        
+        CullRun cullRun = { objectBuffer, objectBufferOffset, static_cast<uint32>(commands), static_cast<uint32>(commandSize / sizeof(uint32)), {}, allocation };
+        Vec4* bounds = nullptr;
+        if (cull)
+        {
+            cullRun.bounds = streamBuffer_.Allocate(commands * sizeof(Vec4), storageBufferAlignment_);
+            if (!cullRun.bounds.IsValid()) return;
+            stats_.streamBytes += cullRun.bounds.size;
+            bounds = static_cast<Vec4*>(cullRun.bounds.data);
+        }
+        
+        // Built straight into the mapped stream buffer the GPU reads them from.
+        // The cull pass lowers the instance counts to what survives
+        DrawElementsIndirectCommand* elements = static_cast<DrawElementsIndirectCommand*>(allocation.data);
+        DrawArraysIndirectCommand*   arrays   = static_cast<DrawArraysIndirectCommand*>(allocation.data);
+        uint32 command = 0;
+        for (; i < end; ++i)
+        {
+            const MeshData* entry = batchMeshes_[i];
+            if (!entry) continue;
+            
+            const GLGeometryPool::Range& range = entry->poolRange;
+            const uint32 instanceCount = static_cast<uint32>(batches[i].transforms.size());
+            if (indexed)
+                *elements++ = { entry->indexCount, instanceCount, static_cast<uint32>(range.firstIndex), static_cast<int32>(range.firstVertex), object };
+            else
+                *arrays++   = { static_cast<uint32>(entry->vertexCount), instanceCount, static_cast<uint32>(range.firstVertex), object };
+            
+            if (cull)
+                bounds[command] = entry->boundingSphere;
+            object += instanceCount;
+            ++command;
+        }
+        
+        if (cull)
+        {
+            CullObjects(cullRun);
+            BindObjectStorage(cullOutputBuffer_, 0, cullOutputSize_);
+        }
+        else
+        {
+            BindObjectStorage(objectBuffer, objectBufferOffset, objectBufferSize);
+        }
+        
+        SetMeshUniforms(*meshData);
+        BindVertexArray(pool->GetVertexArray());
+        BindObjectData(*meshData);
+        if (ChangeState(state_.indirect, allocation.buffer))
+            glBindBuffer(GL_DRAW_INDIRECT_BUFFER, allocation.buffer);
+        
+        const void* offset = reinterpret_cast<const void*>(allocation.offset);
+        if (indexed)
+            glMultiDrawElementsIndirect(mode, meshData->indexType, offset, static_cast<GLsizei>(commands), 0);
+        else
+            glMultiDrawArraysIndirect(mode, offset, static_cast<GLsizei>(commands), 0);
+        ++stats_.drawCalls;
+        stats_.indirectCommands += static_cast<uint32>(commands);
+    }
+}
+
+void GLRenderDevice::DrawObjects(MeshData& meshData, PrimitiveType primitiveType, std::span<const Mat4> transforms)
+{
+    uint32 firstObject = 0;
+    if (!WriteObjectData(transforms, firstObject)) return;
+    
+    DrawObjectRange(meshData, primitiveType, firstObject, static_cast<uint32>(transforms.size()));
+}
+
+void GLRenderDevice::DrawObjectRange(MeshData& meshData, PrimitiveType primitiveType, uint32 firstObject, uint32 objectCount)
+{
+    SetMeshUniforms(meshData);
+    
+    // Draw the mesh - the VAO stays bound, the next draw usually wants it again (pooled
+    // meshes all share one). The base instance selects this draw's objects, every
+    // instance reads its own; base vertex and first index select the pool range
+    BindVertexArray(meshData.vao);
+    BindObjectData(meshData);
+    
+    const GLGeometryPool::Range& range = meshData.poolRange;
+    const GLsizei instanceCount = static_cast<GLsizei>(objectCount);
+    if (meshData.indexCount > 0)
+    {
+        const size_t indexSize = meshData.indexType == GL_UNSIGNED_SHORT ? sizeof(uint16) : sizeof(uint32);
+        const void*  indices   = reinterpret_cast<const void*>(range.firstIndex * indexSize);
+        glDrawElementsInstancedBaseVertexBaseInstance(GetGLPrimitiveType(primitiveType), meshData.indexCount, meshData.indexType, indices, instanceCount, static_cast<GLint>(range.firstVertex), firstObject);
+    }
+    else
+    {
+        glDrawArraysInstancedBaseInstance(GetGLPrimitiveType(primitiveType), static_cast<GLint>(range.firstVertex), static_cast<GLsizei>(meshData.vertexCount), instanceCount, firstObject);
+    }
+    ++stats_.drawCalls;
+}
+
+bool GLRenderDevice::WriteObjectData(std::span<const Mat4> transforms, uint32& firstObject)
+{
+    ObjectData* objects = AllocateObjects(transforms.size(), firstObject);
+    if (!objects) return false;
+    
+    WriteObjects(objects, transforms);
+    return true;
+}
+
+ObjectData* GLRenderDevice::AllocateObjects(size_t count, uint32& firstObject)
+{
+    const size_t frameSize = objectBuffer_.GetFrameSize();
+    const GLStreamBuffer::Allocation allocation = objectBuffer_.Allocate(count * sizeof(ObjectData), sizeof(ObjectData));
+    if (!allocation.IsValid()) return nullptr;
+    
+    // Outgrown - more objects per frame need more indices
+    if (objectBuffer_.GetFrameSize() != frameSize)
+        EnsureObjectIndexCapacity();
+    
+    stats_.streamBytes += allocation.size;
+    
+    // One binding covers the whole frame region, it only moves with the frame (or on growth)
+    const size_t frameOffset = objectBuffer_.GetFrameOffset();
+    BindObjectStorage(allocation.buffer, frameOffset, objectBuffer_.GetFrameSize());
+    
+    firstObject = static_cast<uint32>((allocation.offset - frameOffset) / sizeof(ObjectData));
+    return static_cast<ObjectData*>(allocation.data);
+}
+
+void GLRenderDevice::BindObjectStorage(uint32 buffer, size_t offset, size_t size)
+{
+    if (objectBinding_ == buffer && objectBindingOffset_ == offset) return;
+    
+    objectBinding_       = buffer;
+    objectBindingOffset_ = offset;
+    glBindBufferRange(GL_SHADER_STORAGE_BUFFER, ObjectData::Slot, buffer, offset, size);
+}
+
+void GLRenderDevice::CullObjects(const CullRun& run)
+{
+    // The output holds a frame's worth of objects at the same indices as the input
+    const size_t frameSize = objectBuffer_.GetFrameSize();
+    if (cullOutputSize_ < frameSize)
+    {
+        glDeleteBuffers(1, &cullOutputBuffer_);
+        glCreateBuffers(1, &cullOutputBuffer_);
+        glNamedBufferStorage(cullOutputBuffer_, frameSize, nullptr, 0);
+        cullOutputSize_ = frameSize;
+    }
+    
+    // Through the state cache, the caller's shader goes back on before the draw
+    if (ChangeState(state_.program, cullProgram_.GetID()))
+        glUseProgram(cullProgram_.GetID());
+    SetUniformInt(cullProgram_, s_cullCommandStrideUniform, static_cast<int>(run.commandStride));
+    
+    glBindBufferRange(GL_SHADER_STORAGE_BUFFER, 1, run.objectBuffer, run.objectOffset, frameSize);
+    glBindBufferRange(GL_SHADER_STORAGE_BUFFER, 2, run.bounds.buffer, run.bounds.offset, run.bounds.size);
+    glBindBufferRange(GL_SHADER_STORAGE_BUFFER, 3, run.commands.buffer, run.commands.offset, run.commands.size);
+    glBindBufferRange(GL_SHADER_STORAGE_BUFFER, 4, cullOutputBuffer_, 0, cullOutputSize_);
+    
+    // A work group per command, each compacts its own objects
+    DispatchCompute(run.commandCount, 1, 1);
+    
+    // The draw reads the counts as commands and the objects as storage and attributes
+    glMemoryBarrier(GL_COMMAND_BARRIER_BIT | GL_SHADER_STORAGE_BARRIER_BIT | GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT);
+    
+    if (ChangeState(state_.program, currentShader_.GetID()))
+        glUseProgram(currentShader_.GetID());
+}
+
+void GLRenderDevice::EnableGpuCulling(bool enable)
+{
+    gpuCulling_ = enable;
+}
+
+void GLRenderDevice::SetupObjectAttributes(uint32 vao)
+{
+    // Per-instance model matrix, one vec4 column per location, read from the ObjectData
+    // entries of the frame (the binding follows the object buffer, see BindObjectData)
+    for (uint32 column = 0; column < 4; ++column)
+    {
+        const uint32 location = s_instanceAttribLocation + column;
+        glEnableVertexArrayAttrib(vao, location);
+        glVertexArrayAttribFormat(vao, location, 4, GL_FLOAT, GL_FALSE, column * sizeof(Vec4));
+        glVertexArrayAttribBinding(vao, location, s_instanceBinding);
+    }
+    glVertexArrayBindingDivisor(vao, s_instanceBinding, 1);
+    glVertexArrayVertexBuffer(vao, s_instanceBinding, objectBuffer_.GetBuffer(), 0, sizeof(ObjectData));
+    
+    // Object index - base instance + instance, for shaders indexing the object storage buffer
+    glEnableVertexArrayAttrib(vao, ObjectData::IndexLocation);
+    glVertexArrayAttribIFormat(vao, ObjectData::IndexLocation, 1, GL_UNSIGNED_INT, 0);
+    glVertexArrayAttribBinding(vao, ObjectData::IndexLocation, s_objectIndexBinding);
+    glVertexArrayBindingDivisor(vao, s_objectIndexBinding, 1);
+    glVertexArrayVertexBuffer(vao, s_objectIndexBinding, objectIndexBuffer_, 0, sizeof(uint32));
+}
+
+void GLRenderDevice::BindObjectData(MeshData& meshData)
+{
+    // Model matrices as instance attributes, read from the same entries (VAO state).
+    // The pool tracks its shared VAO itself
+    if (meshData.pool)
+    {
+        meshData.pool->BindInstanceBuffer(s_instanceBinding, objectBinding_, objectBindingOffset_, sizeof(ObjectData));
+        return;
+    }
+    if (meshData.objectBuffer == objectBinding_ && meshData.objectOffset == objectBindingOffset_) return;
+    
+    glVertexArrayVertexBuffer(meshData.vao, s_instanceBinding, objectBinding_, objectBindingOffset_, sizeof(ObjectData));
+    meshData.objectBuffer = objectBinding_;
+    meshData.objectOffset = objectBindingOffset_;
+}
+
+void GLRenderDevice::EnsureObjectIndexCapacity()
+{
+    const size_t capacity = objectBuffer_.GetFrameSize() / sizeof(ObjectData);
+    if (capacity <= objectIndexCapacity_) return;
+    
+    std::vector<uint32> indices(capacity);
+    for (size_t i = 0; i < capacity; ++i)
+        indices[i] = static_cast<uint32>(i);
+    
+    if (objectIndexBuffer_)
+        glDeleteBuffers(1, &objectIndexBuffer_);
+    glGenBuffers(1, &objectIndexBuffer_);
+    glBindBuffer(GL_ARRAY_BUFFER, objectIndexBuffer_);
+    glBufferData(GL_ARRAY_BUFFER, indices.size() * sizeof(uint32), indices.data(), GL_STATIC_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    objectIndexCapacity_ = capacity;
+    
+    // Every existing VAO still points at the old one
+    for (auto& pair : meshCache_)
+    {
+        if (!pair.second.pool)
+            glVertexArrayVertexBuffer(pair.second.vao, s_objectIndexBinding, objectIndexBuffer_, 0, sizeof(uint32));
+    }
+    for (auto& pair : geometryPools_)
+        glVertexArrayVertexBuffer(pair.second->GetVertexArray(), s_objectIndexBinding, objectIndexBuffer_, 0, sizeof(uint32));
+}
+
+GLRenderDevice::MeshData& GLRenderDevice::GetMeshData(const Mesh& mesh, PrimitiveType primitiveType)
+{
+    if (primitiveType == PrimitiveType::Patches) 
+        glPatchParameteri(GL_PATCH_VERTICES, 3); // each patch has 3 vertices (triangle)
+    
+    // Changes to the format or to the buffer sizes need new buffers and a new VAO,
+    // anything else is written into the existing ones
+    auto it = meshCache_.find(mesh.GetID());
+    if (it != meshCache_.end())
+    {
+        MeshData& cached = it->second;
+        if (cached.formatGeneration != mesh.GetFormatGeneration() || 
+            cached.vertexCount      != mesh.GetVertexCount()      || 
+            cached.indexCount       != mesh.GetIndexCount())
+        {
+            ReleaseMeshData(mesh.GetID());
+            it = meshCache_.end();
+        }
+        else
+        {
+            UpdateMeshData(mesh, cached);
+        }
+    }
+    
     if (it == meshCache_.end()) 
     {
-        // Create VAO for this mesh
         MeshData meshData;
-        glGenVertexArrays(1, &meshData.vao);
-        glBindVertexArray(meshData.vao);
-
-        if (primitiveType == PrimitiveType::Patches) 
-            glPatchParameteri(GL_PATCH_VERTICES, 3); // each patch has 3 vertices (triangle)
+        CreateMeshData(mesh, meshData);
+        meshLRU_.push_front(mesh.GetID());
+        meshData.lruPosition = meshLRU_.begin();
+        
+        ++stats_.meshesResident;
+        if (!meshData.pool)
+            ownedMeshBytes_ += meshData.bytes;
+        UpdateMeshBytesResident();  // The pool may have grown
+        
+        it = meshCache_.emplace(mesh.GetID(), meshData).first;
+        mesh.MarkResident();
+    }
+    else
+    {
+        meshLRU_.splice(meshLRU_.begin(), meshLRU_, it->second.lruPosition);
+    }
+    it->second.lastUsedFrame = frameIndex_;
+    
+    // Entries drawn this frame are never evicted, so the reference stays valid
+    EnforceMeshBudget();
+    return it->second;
+}
 
-        const std::vector<Vec3>& positions = mesh.GetVertexPositions();
-        const std::vector<Vec3>& normals   = mesh.GetVertexNormals();
-        const std::vector<Vec2>& uvs       = mesh.GetVertexUVs();
-        const std::vector<Vec4>& colors    = mesh.GetVertexColors();
+void GLRenderDevice::CreateMeshData(const Mesh& mesh, MeshData& meshData)
+{
+    const VertexFormat format = VertexFormat::Create(mesh.GetVertexCompression());
+    
+    // Quantized positions are stored inside the bounds, the shader maps them back
+    const BoundingBox bounds = format.HasQuantizedPositions() ? mesh.CalculateBoundingBox() : BoundingBox(Vec3(0.0f), Vec3(1.0f));
+    meshData.positionScale      = bounds.GetSize();
+    meshData.positionOffset     = bounds.min;
+    meshData.quantizedPositions = format.HasQuantizedPositions();
+    meshData.boundingSphere = GetBoundingSphere(format.HasQuantizedPositions() ? bounds : mesh.CalculateBoundingBox());
+    meshData.pool           = nullptr;
+    meshData.poolRange      = GLGeometryPool::Range();
+    meshData.vboCount       = 0;
+    meshData.ibo            = BufferHandle();
+    meshData.indexCount     = static_cast<uint32>(mesh.GetIndexCount());
+    meshData.indexType      = mesh.IsIndexed() && SelectIndexType(mesh.GetVertexCount()) == IndexType::UInt16 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
+    
+    // Into the shared pool of the index type - indices stay relative to the mesh (so 16 bits
+    // are enough for its own vertices), the draw adds the base vertex. Falls back to own
+    // buffers if the pool cannot grow
+    if (UsesGeometryPool(mesh))
+    {
+        GLGeometryPool& pool = GetGeometryPool(mesh.GetVertexCompression(), meshData.indexType);
+        if (pool.Allocate(mesh.GetVertexCount(), meshData.indexCount, meshData.poolRange))
+        {
+            const std::vector<uint8> vertices = PackVertices(mesh, format, bounds);
+            pool.WriteVertices(meshData.poolRange.firstVertex, vertices.data(), vertices.size());
+            if (meshData.indexType == GL_UNSIGNED_SHORT)
+            {
+                const std::vector<uint16> narrowed = NarrowIndices(mesh.GetIndices());
+                pool.WriteIndices(meshData.poolRange.firstIndex, narrowed.data(), narrowed.size() * sizeof(uint16));
+            }
+            else if (meshData.indexCount > 0)
+            {
+                pool.WriteIndices(meshData.poolRange.firstIndex, mesh.GetIndices().data(), meshData.indexCount * sizeof(uint32));
+            }
+            
+            meshData.pool         = &pool;
+            meshData.vao          = pool.GetVertexArray();
+            meshData.objectBuffer = 0;
+            meshData.objectOffset = 0;
+        }
+    }
+    
+    if (!meshData.pool)
+        CreateMeshBuffers(mesh, format, bounds, meshData);
+    
+    // Remember what was uploaded
+    meshData.vertexCount      = mesh.GetVertexCount();
+    meshData.formatGeneration = mesh.GetFormatGeneration();
+    meshData.indexGeneration  = mesh.GetIndexGeneration();
+    for (size_t s = 0; s < meshData.streamGenerations.size(); ++s)
+        meshData.streamGenerations[s] = mesh.GetStreamGeneration(static_cast<VertexStream>(s));
+    
+    // Split streams add up to the interleaved stride
+    meshData.bytes  = meshData.vertexCount * format.GetStride();
+    meshData.bytes += meshData.indexCount * (meshData.indexType == GL_UNSIGNED_SHORT ? sizeof(uint16) : sizeof(uint32));
+    
+    ++stats_.meshUploads;
+    stats_.meshUploadBytes += meshData.bytes;
+    
+    // Everything is current, earlier edits are already in the buffers
+    mesh.ClearDirtyRanges();
+}
 
-        meshData.posVBO = CreateVertexBuffer(positions.data(), positions.size() * sizeof(Vec3), BufferUsage::Static);
-        meshData.nrmVBO = CreateVertexBuffer(normals.data(), normals.size() * sizeof(Vec3), BufferUsage::Static);
-        meshData.uvsVBO = CreateVertexBuffer(uvs.data(), uvs.size() * sizeof(Vec2), BufferUsage::Static);
-        meshData.clrVBO = CreateVertexBuffer(colors.data(), colors.size() * sizeof(Vec4), BufferUsage::Static);
+void GLRenderDevice::CreateMeshBuffers(const Mesh& mesh, const VertexFormat& format, const BoundingBox& bounds, MeshData& meshData)
+{
+    // Pack the SoA streams into one strided buffer, or one buffer per stream
+    const auto& attributes = format.GetAttributes();
+    const bool interleaved = mesh.GetVertexLayout() == VertexLayout::Interleaved;
+    
+    if (interleaved)
+    {
+        const std::vector<uint8> vertices = PackVertices(mesh, format, bounds);
+        meshData.vbos[0]  = CreateVertexBuffer(vertices.data(), vertices.size(), BufferUsage::Static);
+        meshData.vboCount = 1;
+    }
+    else
+    {
+        for (size_t i = 0; i < attributes.size(); ++i)
+        {
+            const std::vector<uint8> stream = PackVertices(mesh, format.Extract(i), bounds);
+            meshData.vbos[i] = CreateVertexBuffer(stream.data(), stream.size(), BufferUsage::Static);
+        }
+        meshData.vboCount = static_cast<uint32>(attributes.size());
+    }
+    
+    // Create and upload index buffer if mesh is indexed (before the VAO is bound),
+    // narrowed to 16 bits when every vertex is addressable with them
+    if (mesh.IsIndexed()) 
+    {
+        const auto& indices = mesh.GetIndices();
+        if (meshData.indexType == GL_UNSIGNED_SHORT)
+        {
+            const std::vector<uint16> narrowed = NarrowIndices(indices);
+            meshData.ibo = CreateIndexBuffer(narrowed.data(), narrowed.size() * sizeof(uint16), BufferUsage::Static);
+        }
+        else
+        {
+            meshData.ibo = CreateIndexBuffer(indices.data(), indices.size() * sizeof(uint32), BufferUsage::Static);
+        }
+    }
+    
+    // Create VAO for this mesh
+    glGenVertexArrays(1, &meshData.vao);
+    BindVertexArray(meshData.vao);
+    
+    // Vertex attributes (locations 0-3)
+    for (size_t i = 0; i < attributes.size(); ++i)
+    {
+        const VertexAttribute& attribute = attributes[i];
+        const BufferHandle vbo    = interleaved ? meshData.vbos[0] : meshData.vbos[i];
+        const GLsizei      stride = interleaved ? format.GetStride() : VertexFormat::GetTypeSize(attribute.type) * attribute.components;
+        const size_t       offset = interleaved ? attribute.offset : 0;
         
-        // Position attribute (location = 0)
-        glBindBuffer(GL_ARRAY_BUFFER, meshData.posVBO.GetID());
-        glEnableVertexAttribArray(0);
-        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 0, nullptr);
+        glBindBuffer(GL_ARRAY_BUFFER, vbo.GetID());
+        glEnableVertexAttribArray(attribute.location);
+        glVertexAttribPointer(attribute.location, attribute.components, GetGLAttribType(attribute.type), attribute.normalized ? GL_TRUE : GL_FALSE, stride, reinterpret_cast<const void*>(offset));
+    }
+    
+    if (meshData.ibo.IsValid())
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, meshData.ibo.GetID());
+    
+    SetupObjectAttributes(meshData.vao);
+    meshData.objectBuffer = 0;
+    meshData.objectOffset = 0;
+}
+
+GLGeometryPool& GLRenderDevice::GetGeometryPool(uint32 compression, uint32 indexType)
+{
+    const bool narrow = indexType == GL_UNSIGNED_SHORT;
+    UniquePtr<GLGeometryPool>& pool = geometryPools_[narrow ? compression | s_poolNarrowIndices : compression];
+    if (pool) return *pool;
+    
+    // A failed Create leaves a pool that refuses every allocation, meshes then get their own buffers
+    pool = MakeUnique<GLGeometryPool>();
+    const VertexFormat format = VertexFormat::Create(compression);
+    if (!pool->Create(format.GetStride(), narrow ? sizeof(uint16) : sizeof(uint32), s_poolVertexCapacity, s_poolIndexCapacity))
+        return *pool;
+    
+    // Same attributes as a per-mesh interleaved VAO, all read through binding 0
+    const uint32 vao = pool->GetVertexArray();
+    for (const VertexAttribute& attribute : format.GetAttributes())
+    {
+        glEnableVertexArrayAttrib(vao, attribute.location);
+        glVertexArrayAttribFormat(vao, attribute.location, attribute.components, GetGLAttribType(attribute.type), attribute.normalized ? GL_TRUE : GL_FALSE, attribute.offset);
+        glVertexArrayAttribBinding(vao, attribute.location, 0);
+    }
+    SetupObjectAttributes(vao);
+    return *pool;
+}
+
+void GLRenderDevice::RepackGeometryPool(GLGeometryPool& pool)
+{
+    // The pool moves every range, its meshes pick up the new offsets
+    std::vector<GLGeometryPool::Range*> ranges;
+    for (auto& pair : meshCache_)
+    {
+        if (pair.second.pool == &pool)
+            ranges.push_back(&pair.second.poolRange);
+    }
+    
+    if (pool.Repack(ranges))
+        UpdateMeshBytesResident();
+}
+
+bool GLRenderDevice::UsesGeometryPool(const Mesh& mesh)
+{
+    // Quantized positions decode with per-mesh bounds, which one multi-draw cannot vary
+    return mesh.GetVertexLayout() == VertexLayout::Interleaved &&
+           !(mesh.GetVertexCompression() & VertexCompression::QuantizedPositions);
+}
+
+void GLRenderDevice::UpdateMeshData(const Mesh& mesh, MeshData& meshData)
+{
+    const VertexFormat format = VertexFormat::Create(mesh.GetVertexCompression());
+    const auto& attributes    = format.GetAttributes();
+    const bool interleaved    = mesh.GetVertexLayout() == VertexLayout::Interleaved;
+    const size_t vertexCount  = meshData.vertexCount;
+    
+    // Vertices each stream needs re-sent, clamped to the buffer. A changed stream
+    // without a range (someone else cleared it) is sent whole
+    std::array<DirtyRange, 4> ranges = {};
+    DirtyRange vertexRange;
+    for (size_t s = 0; s < ranges.size(); ++s)
+    {
+        const VertexStream stream = static_cast<VertexStream>(s);
+        if (meshData.streamGenerations[s] == mesh.GetStreamGeneration(stream)) continue;
         
-        // Normal attribute (location = 1)
-        glBindBuffer(GL_ARRAY_BUFFER, meshData.nrmVBO.GetID());
-        glEnableVertexAttribArray(1);
-        glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 0, nullptr);
+        DirtyRange range = mesh.GetDirtyRange(stream);
+        if (range.IsEmpty()) range.Add(0, vertexCount);
+        range.end = std::min(range.end, vertexCount);
         
-        // UV attribute (location = 2)
-        glBindBuffer(GL_ARRAY_BUFFER, meshData.uvsVBO.GetID());
-        glEnableVertexAttribArray(2);
-        glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, 0, nullptr);
+        ranges[s] = range;
+        if (!range.IsEmpty()) vertexRange.Add(range.begin, range.end - range.begin);
+        meshData.streamGenerations[s] = mesh.GetStreamGeneration(stream);
+    }
+    
+    if (!vertexRange.IsEmpty())
+    {
+        // Moved positions may move the quantization bounds, then every position is stale
+        BoundingBox bounds(meshData.positionOffset, meshData.positionOffset + meshData.positionScale);
+        DirtyRange& positionRange = ranges[static_cast<size_t>(VertexStream::Position)];
+        if (format.HasQuantizedPositions() && !positionRange.IsEmpty())
+        {
+            const BoundingBox newBounds = mesh.CalculateBoundingBox();
+            if (newBounds.min != bounds.min || newBounds.max != bounds.max)
+            {
+                bounds                  = newBounds;
+                meshData.positionScale  = bounds.GetSize();
+                meshData.positionOffset = bounds.min;
+                positionRange           = DirtyRange{ 0, vertexCount };
+                vertexRange.Add(0, vertexCount);
+            }
+        }
         
-        // Color attribute (location = 3)
-        glBindBuffer(GL_ARRAY_BUFFER, meshData.clrVBO.GetID());
-        glEnableVertexAttribArray(3);
-        glVertexAttribPointer(3, 4, GL_FLOAT, GL_FALSE, 0, nullptr);
+        // Moved positions move the culling bounds (quantized ones are current by now)
+        if (!positionRange.IsEmpty())
+            meshData.boundingSphere = GetBoundingSphere(format.HasQuantizedPositions() ? bounds : mesh.CalculateBoundingBox());
         
-        // Create and upload index buffer if mesh is indexed
-        if (mesh.IsIndexed()) 
+        if (interleaved)
         {
-            const auto& indices = mesh.GetIndices();
-            meshData.ibo = CreateIndexBuffer(indices.data(), indices.size() * sizeof(uint32), BufferUsage::Static);
-            meshData.indexCount = static_cast<uint32>(indices.size());
-            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, meshData.ibo.GetID());
+            // Whole vertices, every attribute of the touched range
+            const size_t count = vertexRange.end - vertexRange.begin;
+            const std::vector<uint8> vertices = PackVertices(mesh, format, bounds, vertexRange.begin, count);
+            const BufferHandle buffer = meshData.pool ? BufferHandle(meshData.pool->GetVertexBuffer()) : meshData.vbos[0];
+            UploadMeshBuffer(buffer, (meshData.poolRange.firstVertex + vertexRange.begin) * format.GetStride(), vertices.data(), vertices.size());
         }
-        else 
+        else
         {
-            meshData.indexCount = 0;
+            // Only the streams that changed, only where they changed
+            for (size_t i = 0; i < attributes.size(); ++i)
+            {
+                const DirtyRange& range = ranges[static_cast<size_t>(attributes[i].stream)];
+                if (range.IsEmpty()) continue;
+                
+                const VertexFormat streamFormat = format.Extract(i);
+                const std::vector<uint8> stream = PackVertices(mesh, streamFormat, bounds, range.begin, range.end - range.begin);
+                UploadMeshBuffer(meshData.vbos[i], range.begin * streamFormat.GetStride(), stream.data(), stream.size());
+            }
         }
+    }
+    
+    if (meshData.indexGeneration != mesh.GetIndexGeneration() && meshData.indexCount > 0)
+    {
+        DirtyRange range = mesh.GetIndexDirtyRange();
+        if (range.IsEmpty()) range.Add(0, meshData.indexCount);
+        range.end = std::min<size_t>(range.end, meshData.indexCount);
         
-        glBindVertexArray(0);
-        
-        // Cache it
-        meshCache_[&mesh] = meshData;
-        it = meshCache_.find(&mesh);
+        if (!range.IsEmpty())
+        {
+            const std::span<const uint32> indices = std::span<const uint32>(mesh.GetIndices()).subspan(range.begin, range.end - range.begin);
+            const BufferHandle buffer = meshData.pool ? BufferHandle(meshData.pool->GetIndexBuffer()) : meshData.ibo;
+            const size_t       first  = meshData.poolRange.firstIndex + range.begin;
+            if (meshData.indexType == GL_UNSIGNED_SHORT)
+            {
+                const std::vector<uint16> narrowed = NarrowIndices(indices);
+                UploadMeshBuffer(buffer, first * sizeof(uint16), narrowed.data(), narrowed.size() * sizeof(uint16));
+            }
+            else
+            {
+                UploadMeshBuffer(buffer, first * sizeof(uint32), indices.data(), indices.size_bytes());
+            }
+        }
     }
+    meshData.indexGeneration = mesh.GetIndexGeneration();
     
-    // Set transform uniform if we have a current shader
-    if (currentShader_.IsValid())
-        SetUniformMat4(currentShader_, "u_model", transform);
+    mesh.ClearDirtyRanges();
+}
+
+void GLRenderDevice::UploadMeshBuffer(BufferHandle buffer, size_t offset, const void* data, size_t size)
+{
+    // Sizes never change here (that rebuilds the mesh), so the storage is written in place.
+    // The copy target keeps index buffers away from whatever VAO is bound
+    glBindBuffer(GL_COPY_WRITE_BUFFER, buffer.GetID());
+    glBufferSubData(GL_COPY_WRITE_BUFFER, offset, size, data);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
     
-    // Draw the mesh
-    const MeshData& meshData = it->second;
-    glBindVertexArray(meshData.vao);
+    ++stats_.meshUploads;
+    stats_.meshUploadBytes += size;
+}
+
+void GLRenderDevice::ReleaseMeshData(uint32 meshID)
+{
+    auto it = meshCache_.find(meshID);
+    if (it == meshCache_.end()) return;
     
-    if (meshData.indexCount > 0)
-        glDrawElements(GetGLPrimitiveType(primitiveType), meshData.indexCount, GL_UNSIGNED_INT, nullptr);
+    MeshData& meshData = it->second;
+    if (meshData.pool)
+    {
+        // The range is reused by the next mesh that fits, the VAO stays with the pool.
+        // The memory stays too, until the pool is repacked
+        meshData.pool->Free(meshData.poolRange);
+    }
     else
-        glDrawArrays(GetGLPrimitiveType(primitiveType), 0, static_cast<GLsizei>(mesh.GetVertexCount()));
+    {
+        if (state_.vao == meshData.vao)
+            BindVertexArray(0);
+        
+        glDeleteVertexArrays(1, &meshData.vao);
+        for (uint32 i = 0; i < meshData.vboCount; ++i)
+            DestroyBuffer(meshData.vbos[i]);
+        if (meshData.ibo.IsValid())
+            DestroyBuffer(meshData.ibo);
+        ownedMeshBytes_ -= meshData.bytes;
+    }
+    
+    --stats_.meshesResident;
+    
+    meshLRU_.erase(meshData.lruPosition);
+    meshCache_.erase(it);
+    UpdateMeshBytesResident();
+}
+
+void GLRenderDevice::UpdateMeshBytesResident()
+{
+    size_t bytes = ownedMeshBytes_;
+    for (const auto& pair : geometryPools_)
+        bytes += pair.second->GetBytes();
+    stats_.meshBytesResident = bytes;
+}
+
+void GLRenderDevice::EnforceMeshBudget()
+{
+    if (meshMemoryBudget_ == 0) return;
+    
+    // Least recently drawn first; meshes drawn this frame stay even if that overshoots.
+    // Evicting from a pool frees nothing until the pool is repacked, which it is once mostly empty
+    while (stats_.meshBytesResident > meshMemoryBudget_ && !meshLRU_.empty())
+    {
+        const uint32 meshID = meshLRU_.back();
+        const MeshData& meshData = meshCache_.find(meshID)->second;
+        if (meshData.lastUsedFrame == frameIndex_) break;
+        
+        GLGeometryPool* pool = meshData.pool;
+        ReleaseMeshData(meshID);
+        ++stats_.meshEvictions;
+        
+        if (pool && pool->IsUnderused())
+            RepackGeometryPool(*pool);
+    }
+}
+
+void GLRenderDevice::SetMeshMemoryBudget(size_t bytes)
+{
+    meshMemoryBudget_ = bytes;
+    EnforceMeshBudget();
+}
+
+void GLRenderDevice::ResetStats()
+{
+    // Residency is a running total, not a per-frame count
+    RenderStats stats;
+    stats.meshesResident    = stats_.meshesResident;
+    stats.meshBytesResident = stats_.meshBytesResident;
+    stats_ = stats;
+}
+
+void GLRenderDevice::SetMeshUniforms(const MeshData& meshData)
+{
+    // Only shaders that decode quantized positions declare these, and a program keeps what it
+    // was given: float meshes (identity) after float meshes send nothing, nor do runs of one mesh
+    ProgramUniforms* uniforms = FindProgramUniforms(currentShader_);
+    if (!uniforms || uniforms->positionScaleLocation < 0) return;
+    if (!meshData.quantizedPositions && uniforms->positionScale == Vec3(1.0f) && uniforms->positionOffset == Vec3(0.0f)) return;
     
-    glBindVertexArray(0);
+    if (uniforms->positionScale != meshData.positionScale)
+    {
+        glUniform3fv(uniforms->positionScaleLocation, 1, glm::value_ptr(meshData.positionScale));
+        uniforms->positionScale = meshData.positionScale;
+    }
+    if (uniforms->positionOffsetLocation >= 0 && uniforms->positionOffset != meshData.positionOffset)
+    {
+        glUniform3fv(uniforms->positionOffsetLocation, 1, glm::value_ptr(meshData.positionOffset));
+        uniforms->positionOffset = meshData.positionOffset;
+    }
+}
+
+void GLRenderDevice::BindVertexArray(uint32 vao)
+{
+    if (ChangeState(state_.vao, vao))
+        glBindVertexArray(vao);
 }
 
 void GLRenderDevice::DrawIndexed(BufferHandle vertexBuffer, BufferHandle indexBuffer, uint32 indexCount, PrimitiveType primitiveType)
@@ -437,10 +1313,12 @@ void GLRenderDevice::DrawIndexed(BufferHandle vertexBuffer, BufferHandle indexBu
     
     // This is a lower-level draw call, requires manual VAO setup
     // For now, we'll mainly use DrawMesh
+    BindVertexArray(0);
     glBindBuffer(GL_ARRAY_BUFFER, vertexBuffer.GetID());
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexBuffer.GetID());
     
     glDrawElements(GetGLPrimitiveType(primitiveType), indexCount, GL_UNSIGNED_INT, nullptr);
+    ++stats_.drawCalls;
     
     glBindBuffer(GL_ARRAY_BUFFER, 0);
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
@@ -448,11 +1326,14 @@ void GLRenderDevice::DrawIndexed(BufferHandle vertexBuffer, BufferHandle indexBu
 
 void GLRenderDevice::SetViewport(uint32 x, uint32 y, uint32 width, uint32 height) 
 {
-    glViewport(x, y, width, height);
+    if (ChangeState(state_.viewport, { x, y, width, height }))
+        glViewport(x, y, width, height);
 }
 
 void GLRenderDevice::EnableDepthTest(bool enable) 
 {
+    if (!ChangeState(state_.depthTest, enable)) return;
+    
     if (enable)
         glEnable(GL_DEPTH_TEST);
     else 
@@ -461,6 +1342,8 @@ void GLRenderDevice::EnableDepthTest(bool enable)
 
 void GLRenderDevice::EnableBlending(bool enable)
 {
+    if (!ChangeState(state_.blending, enable)) return;
+    
     if (enable) 
     {
         glEnable(GL_BLEND);
@@ -474,6 +1357,8 @@ void GLRenderDevice::EnableBlending(bool enable)
 
 void GLRenderDevice::EnableCulling(bool enable) 
 {
+    if (!ChangeState(state_.culling, enable)) return;
+    
     if (enable) 
         glEnable(GL_CULL_FACE);
     else 
@@ -482,6 +1367,8 @@ void GLRenderDevice::EnableCulling(bool enable)
 
 void GLRenderDevice::SetWireframeMode(bool enable) 
 {
+    if (!ChangeState(state_.wireframe, enable)) return;
+    
     if (enable)
         glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
     else
@@ -563,11 +1450,109 @@ uint32 GLRenderDevice::GetGLPrimitiveType(PrimitiveType type)
     }
 }
 
-int GLRenderDevice::GetUniformLocation(ShaderHandle shader, const std::string& name) 
+uint32 GLRenderDevice::GetGLAttribType(VertexAttribType type)
+{
+    switch (type)
+    {
+        case VertexAttribType::Float32: return GL_FLOAT;
+        case VertexAttribType::Float16: return GL_HALF_FLOAT;
+        case VertexAttribType::Int16:   return GL_SHORT;
+        case VertexAttribType::UInt16:  return GL_UNSIGNED_SHORT;
+        case VertexAttribType::UInt8:   return GL_UNSIGNED_BYTE;
+        default: return GL_FLOAT;
+    }
+}
+
+GLRenderDevice::ProgramUniforms* GLRenderDevice::FindProgramUniforms(ShaderHandle shader)
 {
     if (!shader.IsValid()) 
+        return nullptr;
+    
+    if (shader.GetID() != lastProgram_)
+    {
+        auto it = programUniforms_.find(shader.GetID());
+        if (it == programUniforms_.end())
+            return nullptr;
+        
+        lastProgram_         = shader.GetID();
+        lastProgramUniforms_ = &it->second;
+    }
+    return lastProgramUniforms_;
+}
+
+int GLRenderDevice::GetUniformLocation(ShaderHandle shader, UniformID id) 
+{
+    const ProgramUniforms* uniforms = FindProgramUniforms(shader);
+    if (!uniforms)
         return -1;
-    return glGetUniformLocation(shader.GetID(), name.c_str());
+    
+    auto it = uniforms->locations.find(id.GetHash());
+    return it != uniforms->locations.end() ? it->second : -1;
+}
+
+void GLRenderDevice::CacheProgramUniforms(uint32 program)
+{
+    // Linking again resets every value, so start over
+    ProgramUniforms& uniforms = programUniforms_[program];
+    uniforms = ProgramUniforms();
+    
+    GLint uniformCount = 0;
+    GLint maxNameLength = 0;
+    glGetProgramiv(program, GL_ACTIVE_UNIFORMS, &uniformCount);
+    glGetProgramiv(program, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxNameLength);
+    
+    std::string name(static_cast<size_t>(maxNameLength) + 16, '\0');
+    
+    auto addLocation = [&](std::string_view uniformName, int location) 
+    {
+        auto [it, inserted] = uniforms.locations.emplace(UniformID::Hash(uniformName), location);
+        if (!inserted && it->second != location)
+            std::cerr << "Uniform name hash collision on '" << uniformName << "' in program " << program << std::endl;
+    };
+    
+    for (GLint i = 0; i < uniformCount; ++i) 
+    {
+        GLsizei length = 0;
+        GLint   size   = 0;
+        GLenum  type   = 0;
+        glGetActiveUniform(program, static_cast<GLuint>(i), maxNameLength, &length, &size, &type, name.data());
+        
+        std::string_view uniformName(name.data(), static_cast<size_t>(length));
+        int location = glGetUniformLocation(program, name.c_str());
+        if (location < 0)
+            continue; // Lives in a uniform block, not settable by location
+        
+        addLocation(uniformName, location);
+        
+        // Arrays are reported as "name[0]" - also register "name" and every element
+        if (uniformName.size() > 3 && uniformName.substr(uniformName.size() - 3) == "[0]") 
+        {
+            std::string baseName(uniformName.substr(0, uniformName.size() - 3));
+            addLocation(baseName, location);
+            
+            for (GLint element = 1; element < size; ++element) 
+            {
+                std::string elementName = baseName + "[" + std::to_string(element) + "]";
+                int elementLocation = glGetUniformLocation(program, elementName.c_str());
+                if (elementLocation >= 0)
+                    addLocation(elementName, elementLocation);
+            }
+        }
+    }
+    
+    auto locationOf = [&uniforms](UniformID id) {
+        auto it = uniforms.locations.find(id.GetHash());
+        return it != uniforms.locations.end() ? it->second : -1;
+    };
+    uniforms.positionScaleLocation  = locationOf(s_positionScaleUniform);
+    uniforms.positionOffsetLocation = locationOf(s_positionOffsetUniform);
+    
+    // The map may have been touched - drop the lookup shortcut
+    lastProgram_         = 0;
+    lastProgramUniforms_ = nullptr;
+    
+    // Standard blocks go to their fixed slots, so no program needs per-frame setup
+    BindUniformBlock(ShaderHandle(program), FrameData::BlockName, FrameData::Slot);
 }
 
 } // namespace TLETC
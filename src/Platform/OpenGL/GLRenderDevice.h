@@ -1,7 +1,12 @@
 #pragma once
 
 #include "TLETC/Rendering/RenderDevice.h"
+#include "GLGeometryPool.h"
+#include "GLStreamBuffer.h"
+#include <array>
+#include <list>
 #include <unordered_map>
+#include <vector>
 
 namespace TLETC {
 
@@ -28,6 +33,13 @@ public:
     BufferHandle CreateIndexBuffer(const void* data, size_t size, BufferUsage usage) override;
     void UpdateBuffer(BufferHandle buffer, const void* data, size_t size, size_t offset = 0) override;
     void DestroyBuffer(BufferHandle buffer) override;
+    StreamAllocation AllocateStream(size_t size, size_t alignment = 16) override;
+    
+    // Uniform buffers
+    BufferHandle CreateUniformBuffer(const void* data, size_t size, BufferUsage usage) override;
+    void BindUniformBuffer(uint32 slot, BufferHandle buffer, size_t offset = 0, size_t size = 0) override;
+    void BindUniformBlock(ShaderHandle shader, std::string_view blockName, uint32 slot) override;
+    void SetFrameData(const Mat4& view, const Mat4& projection, float time, float deltaTime = 0.0f) override;
     
     // Shader operations
     ShaderHandle CreateShader(ShaderType type, const std::string& source) override;
@@ -51,14 +63,21 @@ public:
     void UseShader(ShaderHandle shader) override;
     
     // Shader uniforms
-    void SetUniformInt(ShaderHandle shader, const std::string& name, int value) override;
-    void SetUniformFloat(ShaderHandle shader, const std::string& name, float value) override;
-    void SetUniformVec3(ShaderHandle shader, const std::string& name, const Vec3& value) override;
-    void SetUniformVec4(ShaderHandle shader, const std::string& name, const Vec4& value) override;
-    void SetUniformMat4(ShaderHandle shader, const std::string& name, const Mat4& value) override;
+    using RenderDevice::SetUniformInt;
+    using RenderDevice::SetUniformFloat;
+    using RenderDevice::SetUniformVec3;
+    using RenderDevice::SetUniformVec4;
+    using RenderDevice::SetUniformMat4;
+    void SetUniformInt(ShaderHandle shader, UniformID id, int value) override;
+    void SetUniformFloat(ShaderHandle shader, UniformID id, float value) override;
+    void SetUniformVec3(ShaderHandle shader, UniformID id, const Vec3& value) override;
+    void SetUniformVec4(ShaderHandle shader, UniformID id, const Vec4& value) override;
+    void SetUniformMat4(ShaderHandle shader, UniformID id, const Mat4& value) override;
     
     // Mesh rendering
     void DrawMesh(const Mesh& mesh, const Mat4& transform, PrimitiveType primitiveType = PrimitiveType::Triangles) override;
+    void DrawMeshInstanced(const Mesh& mesh, std::span<const Mat4> transforms, PrimitiveType primitiveType = PrimitiveType::Triangles) override;
+    void DrawMeshBatch(std::span<const MeshBatch> batches, PrimitiveType primitiveType = PrimitiveType::Triangles) override;
     void DrawIndexed(BufferHandle vertexBuffer, BufferHandle indexBuffer, uint32 indexCount, PrimitiveType primitiveType = PrimitiveType::Triangles) override;
     
     // Compute shader operations
@@ -74,31 +93,179 @@ public:
     void EnableBlending(bool enable) override;
     void EnableCulling(bool enable) override;
     void SetWireframeMode(bool enable) override;
+    void EnableGpuCulling(bool enable) override;
+    
+    // Statistics
+    const RenderStats& GetStats() const override { return stats_; }
+    void ResetStats() override;
+    
+    // Mesh residency
+    void   SetMeshMemoryBudget(size_t bytes) override;
+    size_t GetMeshMemoryBudget() const override { return meshMemoryBudget_; }
     
     // Query
     const int   GetMaxTessLevel() const override;
     const char* GetRendererName() const override;
     const char* GetAPIVersion() const override;
+    size_t      GetUniformBufferAlignment() const override { return uniformBufferAlignment_; }
     
 private:
     // Helper functions
     uint32 GetGLUsage(BufferUsage usage);
     uint32 GetGLShaderType(ShaderType type);
     uint32 GetGLPrimitiveType(PrimitiveType type);
-    int    GetUniformLocation(ShaderHandle shader, const std::string& name);
+    uint32 GetGLAttribType(VertexAttribType type);
+    int    GetUniformLocation(ShaderHandle shader, UniformID id);
+    
+    // Uniform reflection cache - every active uniform of a program, enumerated once at link time
+    struct ProgramUniforms {
+        std::unordered_map<uint32, int> locations; // UniformID hash -> location
+        
+        // Position dequantization, declared only by shaders that decode quantized positions.
+        // Values as last set on the program (GL starts them at zero), so draws only send changes
+        int  positionScaleLocation  = -1;
+        int  positionOffsetLocation = -1;
+        Vec3 positionScale          = Vec3(0.0f);
+        Vec3 positionOffset         = Vec3(0.0f);
+    };
+    void             CacheProgramUniforms(uint32 program);
+    ProgramUniforms* FindProgramUniforms(ShaderHandle shader);
     
-    // Mesh VAO cache - stores VAO for each mesh to avoid recreating
+    std::unordered_map<uint32, ProgramUniforms> programUniforms_;
+    ProgramUniforms*                            lastProgramUniforms_; // Most programs see runs of uniform sets
+    uint32                                      lastProgram_;
+    
+    // Mesh residency cache - GPU copies keyed by Mesh ID, kept in sync through the
+    // mesh's generation counters and evicted least recently drawn first.
+    // Interleaved float-position meshes live in the geometry pool of their format and
+    // index type and share its VAO, the rest own their buffers and VAO
     struct MeshData {
         uint32 vao;
-        BufferHandle posVBO, nrmVBO, uvsVBO, clrVBO;
+        std::array<BufferHandle, 4> vbos;     // One interleaved buffer, or one per stream
+        uint32                      vboCount;
+        GLGeometryPool*             pool;       // Null if the mesh owns its buffers
+        GLGeometryPool::Range       poolRange;  // All zero if it does
+        Vec3                        positionScale;  // Dequantization, identity for float positions
+        Vec3                        positionOffset;
+        bool                        quantizedPositions;
+        Vec4                        boundingSphere; // Local center + radius, for GPU culling
         BufferHandle ibo;
         uint32 indexCount;
+        uint32 indexType;       // GL_UNSIGNED_SHORT whenever the vertex count allows
+        
+        // What the buffers were uploaded from
+        size_t                vertexCount;
+        uint32                formatGeneration;
+        std::array<uint32, 4> streamGenerations;
+        uint32                indexGeneration;
+        
+        size_t                     bytes;         // Vertex + index buffer memory
+        uint64                     lastUsedFrame;
+        uint32                     objectBuffer;  // Object storage the instance binding points at
+        size_t                     objectOffset;
+        std::list<uint32>::iterator lruPosition;
     };
-    std::unordered_map<const Mesh*, MeshData> meshCache_;
+    std::unordered_map<uint32, MeshData> meshCache_;
+    std::list<uint32>                    meshLRU_;          // Mesh IDs, most recently drawn first
+    std::vector<uint32>                  destroyedMeshes_;  // Scratch for Mesh::CollectDestroyed
+    size_t                               meshMemoryBudget_;
+    size_t                               ownedMeshBytes_;   // Buffers of meshes outside the pools
+    uint64                               frameIndex_;
+    
+    MeshData& GetMeshData(const Mesh& mesh, PrimitiveType primitiveType);
+    void CreateMeshData(const Mesh& mesh, MeshData& meshData);
+    void CreateMeshBuffers(const Mesh& mesh, const VertexFormat& format, const BoundingBox& bounds, MeshData& meshData);
+    void UpdateMeshData(const Mesh& mesh, MeshData& meshData);
+    void ReleaseMeshData(uint32 meshID);
+    void EnforceMeshBudget();
+    void UpdateMeshBytesResident();  // Owned buffers plus every pool at its capacity
+    void UploadMeshBuffer(BufferHandle buffer, size_t offset, const void* data, size_t size);
+    void SetMeshUniforms(const MeshData& meshData);
+    
+    // Shared vertex storage, one pool per vertex compression and index type. Meshes whose
+    // indices narrow to 16 bits keep them narrow in a pool of their own
+    std::unordered_map<uint32, UniquePtr<GLGeometryPool>> geometryPools_;
+    GLGeometryPool& GetGeometryPool(uint32 compression, uint32 indexType);
+    void            RepackGeometryPool(GLGeometryPool& pool);
+    static bool UsesGeometryPool(const Mesh& mesh);
+    
+    size_t uniformBufferAlignment_;
+    
+    // Persistently mapped ring buffer for everything written per frame
+    GLStreamBuffer streamBuffer_;
+    
+    // Per-object data of the frame - its own ring, so one storage binding of the frame's
+    // region covers every object and the base instance is a plain index into it
+    GLStreamBuffer objectBuffer_;
+    uint32         objectBinding_;        // Buffer currently bound to ObjectData::Slot
+    size_t         objectBindingOffset_;
+    uint32         objectIndexBuffer_;    // 0, 1, 2, ... read per instance at ObjectData::IndexLocation
+    size_t         objectIndexCapacity_;
+    
+    // Room for count ObjectData entries, firstObject receives the index of the first
+    ObjectData* AllocateObjects(size_t count, uint32& firstObject);
+    void BindObjectStorage(uint32 buffer, size_t offset, size_t size);
+    bool WriteObjectData(std::span<const Mat4> transforms, uint32& firstObject);
+    void SetupObjectAttributes(uint32 vao);
+    void BindObjectData(MeshData& meshData);
+    void EnsureObjectIndexCapacity();
+    void DrawObjects(MeshData& meshData, PrimitiveType primitiveType, std::span<const Mat4> transforms);
+    void DrawObjectRange(MeshData& meshData, PrimitiveType primitiveType, uint32 firstObject, uint32 objectCount);
+    
+    // Scratch for DrawMeshBatch
+    std::vector<MeshData*> batchMeshes_;
+    
+    // GPU frustum culling - a compute pass per pooled run lowers the instance counts of its
+    // indirect commands and compacts the visible objects, in order, into cullOutputBuffer_
+    struct CullRun {
+        uint32                     objectBuffer;   // Frame region the objects were written to
+        size_t                     objectOffset;
+        uint32                     commandCount;
+        uint32                     commandStride;  // In uint32s
+        GLStreamBuffer::Allocation bounds;         // Bounding sphere per command
+        GLStreamBuffer::Allocation commands;
+    };
+    void CullObjects(const CullRun& run);
+    
+    bool         gpuCulling_;
+    ShaderHandle cullProgram_;
+    uint32       cullOutputBuffer_;
+    size_t       cullOutputSize_;
+    size_t       storageBufferAlignment_;
     
     // Current state
     ShaderHandle currentShader_;
     
+    // Shadow copy of the GL state we set, so redundant calls never reach the driver.
+    // Only valid as long as all state goes through this device.
+    struct StateCache {
+        uint32                 program   = 0;
+        uint32                 vao       = 0;
+        uint32                 indirect  = 0;  // GL_DRAW_INDIRECT_BUFFER
+        bool                   depthTest = false;
+        bool                   blending  = false;
+        bool                   culling   = false;
+        bool                   wireframe = false;
+        std::array<uint32, 4>  viewport  = {};
+    };
+    StateCache  state_;
+    RenderStats stats_;
+    
+    // Returns true (and records the new value) if the state actually changes
+    template<typename T>
+    bool ChangeState(T& cached, const T& value)
+    {
+        if (cached == value)
+        {
+            ++stats_.stateChangesSkipped;
+            return false;
+        }
+        cached = value;
+        ++stats_.stateChangesIssued;
+        return true;
+    }
+    void BindVertexArray(uint32 vao);
+    
     // Track if initialized
     bool initialized_;
 };
@@ -0,0 +1,160 @@
+#include "GLStreamBuffer.h"
+#include <glad/gl.h>
+#include <algorithm>
+#include <numeric>
+#include <iostream>
+
+namespace TLETC {
+
+static constexpr GLuint64 s_fenceTimeout = 1000000; // 1 ms per wait, retried until signalled
+
+GLStreamBuffer::GLStreamBuffer() : buffer_(0), mapped_(nullptr), frameSize_(0), frameAlignment_(MinFrameAlignment), head_(0), region_(0), fences_{}
+{
+}
+
+GLStreamBuffer::~GLStreamBuffer()
+{
+    Destroy();
+}
+
+static size_t RoundUp(size_t size, size_t alignment)
+{
+    return (size + alignment - 1) / alignment * alignment;
+}
+
+bool GLStreamBuffer::Create(size_t frameSize, size_t frameAlignment)
+{
+    Destroy();
+    region_         = 0;
+    frameAlignment_ = std::lcm(std::max<size_t>(frameAlignment, 1), MinFrameAlignment);
+    return CreateStorage(RoundUp(frameSize, frameAlignment_));
+}
+
+bool GLStreamBuffer::CreateStorage(size_t frameSize)
+{
+    const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+    const size_t     size  = frameSize * FrameCount;
+    
+    glGenBuffers(1, &buffer_);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, buffer_);
+    glBufferStorage(GL_COPY_WRITE_BUFFER, size, nullptr, flags);
+    mapped_ = static_cast<uint8*>(glMapBufferRange(GL_COPY_WRITE_BUFFER, 0, size, flags));
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+    
+    if (!mapped_)
+    {
+        std::cerr << "Failed to map stream buffer (" << size << " bytes)" << std::endl;
+        glDeleteBuffers(1, &buffer_);
+        buffer_ = 0;
+        return false;
+    }
+    
+    frameSize_ = frameSize;
+    head_      = 0;
+    return true;
+}
+
+void GLStreamBuffer::Destroy()
+{
+    DeleteFences();
+    
+    // Deleting a buffer unmaps it, and GL defers the delete until the GPU is done with it
+    if (!retired_.empty())
+        glDeleteBuffers(static_cast<GLsizei>(retired_.size()), retired_.data());
+    retired_.clear();
+    
+    if (buffer_)
+        glDeleteBuffers(1, &buffer_);
+    buffer_    = 0;
+    mapped_    = nullptr;
+    frameSize_ = 0;
+    head_      = 0;
+}
+
+bool GLStreamBuffer::BeginFrame()
+{
+    if (!retired_.empty())
+    {
+        glDeleteBuffers(static_cast<GLsizei>(retired_.size()), retired_.data());
+        retired_.clear();
+    }
+    
+    region_ = (region_ + 1) % FrameCount;
+    head_   = 0;
+    return WaitForRegion(region_);
+}
+
+void GLStreamBuffer::EndFrame()
+{
+    if (!buffer_) return;
+    
+    void*& fence = fences_[region_];
+    if (fence) glDeleteSync(static_cast<GLsync>(fence));
+    fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+}
+
+GLStreamBuffer::Allocation GLStreamBuffer::Allocate(size_t size, size_t alignment)
+{
+    if (!buffer_ || size == 0) return Allocation();
+    
+    size_t offset = RoundUp(head_, alignment);
+    if (offset + size > frameSize_)
+    {
+        // Outgrown - keep the old storage alive for this frame and start over in a bigger one.
+        // Its fences guard storage that is going away, the new buffer has nothing in flight.
+        // Rounded so the regions after the first start aligned too
+        const size_t frameSize = RoundUp(std::max(frameSize_ * 2, size + alignment), std::lcm(frameAlignment_, alignment));
+        const uint32 old       = buffer_;
+        uint8* const oldMapped = mapped_;
+        
+        if (!CreateStorage(frameSize))
+        {
+            buffer_ = old;
+            mapped_ = oldMapped;
+            return Allocation();
+        }
+        DeleteFences();
+        retired_.push_back(old);
+        offset = 0;
+    }
+    
+    head_ = offset + size;
+    
+    Allocation allocation;
+    allocation.buffer = buffer_;
+    allocation.offset = region_ * frameSize_ + offset;
+    allocation.data   = mapped_ + allocation.offset;
+    allocation.size   = size;
+    return allocation;
+}
+
+void GLStreamBuffer::DeleteFences()
+{
+    for (void*& fence : fences_)
+    {
+        if (fence) glDeleteSync(static_cast<GLsync>(fence));
+        fence = nullptr;
+    }
+}
+
+bool GLStreamBuffer::WaitForRegion(uint32 region)
+{
+    void*& fence = fences_[region];
+    if (!fence) return false;
+    
+    bool waited = false;
+    GLenum result = glClientWaitSync(static_cast<GLsync>(fence), GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+    while (result == GL_TIMEOUT_EXPIRED)
+    {
+        waited = true;
+        result = glClientWaitSync(static_cast<GLsync>(fence), GL_SYNC_FLUSH_COMMANDS_BIT, s_fenceTimeout);
+    }
+    if (result == GL_WAIT_FAILED)
+        std::cerr << "Stream buffer fence wait failed" << std::endl;
+    
+    glDeleteSync(static_cast<GLsync>(fence));
+    fence = nullptr;
+    return waited;
+}
+
+} // namespace TLETC
@@ -0,0 +1,77 @@
+#pragma once
+
+#include "TLETC/Core/Types.h"
+
+#include <array>
+#include <vector>
+
+namespace TLETC {
+
+/**
+ * GLStreamBuffer - Persistently mapped ring buffer for data written once per frame
+ *
+ * One immutable buffer (glBufferStorage, mapped PERSISTENT | COHERENT) split into
+ * three frame-sized regions. A frame sub-allocates linearly from its region and writes
+ * straight into GPU-visible memory; EndFrame fences the region and BeginFrame only
+ * waits if the GPU is still reading the region it is about to reuse, three frames later.
+ *
+ * A frame that runs out of room moves to a buffer twice the size. The old buffer stays
+ * mapped until the next BeginFrame, so pointers handed out earlier in the frame stay valid.
+ * Frame sizes stay multiples of the frame alignment given to Create, so every region starts
+ * where a buffer range may be bound (UBO/SSBO offset alignment, at least 256 bytes).
+ *
+ * usage : GLStreamBuffer::Allocation a = stream.Allocate(sizeof(Mat4) * count, sizeof(Mat4));
+ *         std::memcpy(a.data, matrices, a.size);
+ *         glBindVertexBuffer(binding, a.buffer, a.offset, sizeof(Mat4));
+ */
+class GLStreamBuffer
+{
+public:
+    static constexpr uint32 FrameCount = 3;
+    
+    struct Allocation
+    {
+        uint32 buffer = 0;
+        size_t offset = 0;        // Bytes from the start of buffer
+        void*  data   = nullptr;  // Write-only, coherent
+        size_t size   = 0;
+        
+        bool IsValid() const { return data != nullptr; }
+    };
+    
+    GLStreamBuffer();
+    ~GLStreamBuffer();
+    
+    static constexpr size_t MinFrameAlignment = 256;
+
+    bool Create(size_t frameSize, size_t frameAlignment = MinFrameAlignment);
+    void Destroy();
+    
+    // Returns true if it had to wait for the GPU
+    bool BeginFrame();
+    void EndFrame();
+    
+    Allocation Allocate(size_t size, size_t alignment = 16);
+    
+    uint32 GetBuffer() const         { return buffer_; }
+    size_t GetFrameSize() const      { return frameSize_; }
+    size_t GetFrameAlignment() const { return frameAlignment_; }
+    size_t GetFrameOffset() const    { return region_ * frameSize_; } // Start of the current frame's region
+    size_t GetFrameUsage() const     { return head_; }
+    
+private:
+    bool CreateStorage(size_t frameSize);
+    void DeleteFences();
+    bool WaitForRegion(uint32 region);
+    
+    uint32                              buffer_;
+    uint8*                              mapped_;
+    size_t                              frameSize_;
+    size_t                              frameAlignment_;  // Every region starts at a multiple of this
+    size_t                              head_;      // Bytes used in the current region
+    uint32                              region_;
+    std::array<void*, FrameCount>       fences_;    // GLsync per region
+    std::vector<uint32>                 retired_;   // Outgrown buffers, deleted next frame
+};
+
+} // namespace TLETC
@@ -0,0 +1,100 @@
+#include "TLETC/Rendering/RangeAllocator.h"
+
+#include <algorithm>
+#include <cassert>
+#include <iterator>
+
+namespace TLETC
+{
+
+RangeAllocator::RangeAllocator(size_t capacity) : capacity_(0), used_(0)
+{
+    Reset(capacity);
+}
+
+void RangeAllocator::Reset(size_t capacity)
+{
+    free_.clear();
+    capacity_ = capacity;
+    used_     = 0;
+    if (capacity > 0)
+        free_.emplace(0, capacity);
+}
+
+bool RangeAllocator::Allocate(size_t size, size_t& offset)
+{
+    if (size == 0)
+    {
+        offset = 0;
+        return true;
+    }
+
+    // First fit keeps the low end dense, which is where new buffers are copied from on growth
+    for (auto it = free_.begin(); it != free_.end(); ++it)
+    {
+        if (it->second < size) continue;
+
+        offset = it->first;
+        const size_t remaining = it->second - size;
+        free_.erase(it);
+        if (remaining > 0)
+            free_.emplace(offset + size, remaining);
+
+        used_ += size;
+        return true;
+    }
+    return false;
+}
+
+void RangeAllocator::Free(size_t offset, size_t size)
+{
+    if (size == 0) return;
+    assert(offset + size <= capacity_ && size <= used_);
+    used_ -= size;
+
+    auto next = free_.lower_bound(offset);
+    assert(next == free_.end() || offset + size <= next->first);
+
+    // Merge with the free range right after
+    if (next != free_.end() && offset + size == next->first)
+    {
+        size += next->second;
+        next = free_.erase(next);
+    }
+
+    // And with the one right before
+    if (next != free_.begin())
+    {
+        auto prev = std::prev(next);
+        assert(prev->first + prev->second <= offset);
+        if (prev->first + prev->second == offset)
+        {
+            prev->second += size;
+            return;
+        }
+    }
+
+    free_.emplace_hint(next, offset, size);
+}
+
+void RangeAllocator::Grow(size_t capacity)
+{
+    if (capacity <= capacity_) return;
+
+    // The new tail is free, and joins a free range that ends at the old capacity
+    const size_t start = capacity_;
+    const size_t added = capacity - capacity_;
+    capacity_ = capacity;
+    used_    += added;
+    Free(start, added);
+}
+
+size_t RangeAllocator::GetLargestFree() const
+{
+    size_t largest = 0;
+    for (const auto& range : free_)
+        largest = std::max(largest, range.second);
+    return largest;
+}
+
+} // namespace TLETC
@@ -0,0 +1,122 @@
+#include "TLETC/Rendering/RenderQueue.h"
+
+#include <algorithm>
+#include <bit>
+
+namespace TLETC
+{
+
+static constexpr uint64 s_depthMask = 0xFFFFFF;
+
+RenderQueue::RenderQueue() : viewPosition_(0.0f)
+{
+}
+
+RenderQueue::~RenderQueue()
+{
+}
+
+uint64 RenderQueue::MakeSortKey(RenderPass pass, uint16 shader, uint16 mesh, float depth)
+{
+    // Non-negative floats order the same as their bit patterns, keep the top 24 bits
+    if (!(depth > 0.0f)) depth = 0.0f;
+    const uint64 depthBits = (std::bit_cast<uint32>(depth) >> 8) & s_depthMask;
+
+    uint64 key = static_cast<uint64>(pass) << 56;
+    if (pass == RenderPass::Transparent)
+    {
+        // Blending needs back to front, so distance outranks state
+        key |= (s_depthMask - depthBits) << 32;
+        key |= static_cast<uint64>(shader) << 16;
+        key |= static_cast<uint64>(mesh);
+    }
+    else
+    {
+        key |= static_cast<uint64>(shader) << 40;
+        key |= static_cast<uint64>(mesh) << 24;
+        key |= depthBits;
+    }
+    return key;
+}
+
+void RenderQueue::Submit(const Mesh& mesh, ShaderHandle shader, const Mat4& transform, RenderPass pass, PrimitiveType primitiveType)
+{
+    if (mesh.IsEmpty() || !shader.IsValid()) return;
+
+    const float depth = length(Vec3(transform[3]) - viewPosition_);
+    const uint64 key  = MakeSortKey(pass, static_cast<uint16>(shader.GetID()), GetMeshKey(&mesh), depth);
+
+    keys_.emplace_back(key, static_cast<uint32>(commands_.size()));
+    commands_.push_back({ &mesh, shader, primitiveType, transform });
+}
+
+void RenderQueue::Flush(RenderDevice& device)
+{
+    stats_ = Stats();
+    stats_.commands = static_cast<uint32>(commands_.size());
+    if (commands_.empty()) return;
+
+    // Submission index breaks ties, so equal keys keep their order
+    std::sort(keys_.begin(), keys_.end());
+
+    // Spans into instances_ stay valid as long as it never reallocates
+    instances_.clear();
+    instances_.reserve(commands_.size());
+
+    ShaderHandle currentShader;
+    size_t runStart = 0;
+    while (runStart < keys_.size())
+    {
+        const Command& first = commands_[keys_[runStart].second];
+
+        // Gather the run of identical shader + topology, one batch entry per mesh
+        batches_.clear();
+        size_t runEnd = runStart;
+        while (runEnd < keys_.size())
+        {
+            const Command& cmd = commands_[keys_[runEnd].second];
+            if (cmd.shader != first.shader || cmd.primitiveType != first.primitiveType)
+                break;
+
+            if (batches_.empty() || batches_.back().mesh != cmd.mesh)
+                batches_.push_back({ cmd.mesh, std::span<const Mat4>(instances_.data() + instances_.size(), 0) });
+
+            instances_.push_back(cmd.transform);
+            MeshBatch& batch = batches_.back();
+            batch.transforms = std::span<const Mat4>(batch.transforms.data(), batch.transforms.size() + 1);
+            ++runEnd;
+        }
+
+        if (first.shader != currentShader)
+        {
+            device.UseShader(first.shader);
+            currentShader = first.shader;
+            ++stats_.shaderChanges;
+        }
+
+        device.DrawMeshBatch(batches_, first.primitiveType);
+        ++stats_.drawCalls;
+        stats_.meshBatches += static_cast<uint32>(batches_.size());
+
+        runStart = runEnd;
+    }
+
+    Clear();
+}
+
+void RenderQueue::Clear()
+{
+    commands_.clear();
+    keys_.clear();
+    meshKeys_.clear();
+}
+
+uint16 RenderQueue::GetMeshKey(const Mesh* mesh)
+{
+    // Ids only need to group draws within one frame; past 64k meshes they wrap,
+    // which costs batching, never correctness (runs compare the real pointers)
+    auto it = meshKeys_.try_emplace(mesh, static_cast<uint16>(meshKeys_.size())).first;
+    return it->second;
+}
+
+} // namespace TLETC
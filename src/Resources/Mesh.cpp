@@ -1,16 +1,115 @@
 #include "TLETC/Resources/Mesh.h"
 
 #include <algorithm>
+#include <atomic>
+#include <mutex>
 
 namespace TLETC 
 {
 
+static std::atomic<uint32> s_nextMeshID{ 1 };
+static std::mutex          s_destroyedMutex;
+static std::vector<uint32> s_destroyedMeshes;
+
 Mesh::Mesh() 
+    : layout_(VertexLayout::Interleaved), compression_(VertexCompression::None)
+    , id_(s_nextMeshID++), generation_(0), streamGenerations_{}, indexGeneration_(0), formatGeneration_(0)
+    , resident_(false), boundsGeneration_(0), boundsValid_(false)
 { }
 
-Mesh::~Mesh() 
+Mesh::Mesh(const Mesh& other)
+    : positions_(other.positions_), normals_(other.normals_), uvs_(other.uvs_), colors_(other.colors_)
+    , indices_(other.indices_)
+    , layout_(other.layout_), compression_(other.compression_)
+    , id_(s_nextMeshID++), generation_(0), streamGenerations_{}, indexGeneration_(0), formatGeneration_(0)
+    , resident_(false), boundsGeneration_(0), boundsValid_(false)
 { }
 
+Mesh::Mesh(Mesh&& other) noexcept
+    : positions_(std::move(other.positions_)), normals_(std::move(other.normals_)), uvs_(std::move(other.uvs_)), colors_(std::move(other.colors_))
+    , indices_(std::move(other.indices_))
+    , layout_(other.layout_), compression_(other.compression_)
+    , id_(s_nextMeshID++), generation_(0), streamGenerations_{}, indexGeneration_(0), formatGeneration_(0)
+    , resident_(false), boundsGeneration_(0), boundsValid_(false)
+{
+    other.MarkAllDirty();
+}
+
+Mesh& Mesh::operator=(const Mesh& other)
+{
+    if (this == &other) return *this;
+    
+    positions_   = other.positions_;
+    normals_     = other.normals_;
+    uvs_         = other.uvs_;
+    colors_      = other.colors_;
+    indices_     = other.indices_;
+    layout_      = other.layout_;
+    compression_ = other.compression_;
+    MarkAllDirty();
+    return *this;
+}
+
+Mesh& Mesh::operator=(Mesh&& other) noexcept
+{
+    if (this == &other) return *this;
+    
+    positions_   = std::move(other.positions_);
+    normals_     = std::move(other.normals_);
+    uvs_         = std::move(other.uvs_);
+    colors_      = std::move(other.colors_);
+    indices_     = std::move(other.indices_);
+    layout_      = other.layout_;
+    compression_ = other.compression_;
+    MarkAllDirty();
+    other.MarkAllDirty();
+    return *this;
+}
+
+Mesh::~Mesh() 
+{
+    if (!resident_) return;
+    
+    std::lock_guard<std::mutex> lock(s_destroyedMutex);
+    s_destroyedMeshes.push_back(id_);
+}
+
+void Mesh::CollectDestroyed(std::vector<uint32>& ids)
+{
+    std::lock_guard<std::mutex> lock(s_destroyedMutex);
+    ids.insert(ids.end(), s_destroyedMeshes.begin(), s_destroyedMeshes.end());
+    s_destroyedMeshes.clear();
+}
+
+void Mesh::MarkDirty(VertexStream stream, size_t first, size_t count)
+{
+    ++streamGenerations_[static_cast<size_t>(stream)];
+    ++generation_;
+    dirtyRanges_[static_cast<size_t>(stream)].Add(first, count);
+}
+
+void Mesh::MarkIndicesDirty(size_t first, size_t count)
+{
+    ++indexGeneration_;
+    ++generation_;
+    indexDirtyRange_.Add(first, count);
+}
+
+void Mesh::MarkAllDirty()
+{
+    for (size_t s = 0; s < streamGenerations_.size(); ++s)
+        MarkDirty(static_cast<VertexStream>(s));
+    MarkIndicesDirty();
+    ++formatGeneration_;
+    ++generation_;
+}
+
+void Mesh::ClearDirtyRanges() const
+{
+    dirtyRanges_.fill(DirtyRange());
+    indexDirtyRange_ = DirtyRange();
+}
+
 
 void Mesh::AddVertex(const Vec3& position, const Vec3& normal, const Vec2& uv, const Vec4& color) 
 {
@@ -18,60 +117,75 @@ void Mesh::AddVertex(const Vec3& position, const Vec3& normal, const Vec2& uv, c
     normals_.push_back(normal);
     uvs_.push_back(uv);
     colors_.push_back(color);
+    
+    MarkDirty(VertexStream::Position);
+    MarkDirty(VertexStream::Normal);
+    MarkDirty(VertexStream::UV);
+    MarkDirty(VertexStream::Color);
 }
 
 void Mesh::SetVertexPosition(const size_t vId, const Vec3& position)
 {
     assert(vId < positions_.size());
+    MarkDirty(VertexStream::Position, vId, 1);
     positions_[vId] = position;
 }
 
 void Mesh::SetVertexNormal(const size_t vId, const Vec3& normal)
 {
     assert(vId < normals_.size());
+    MarkDirty(VertexStream::Normal, vId, 1);
     normals_[vId] = normal;
 }
 void Mesh::SetVertexUV(const size_t vId, const Vec2& uv)
 {
     assert(vId < uvs_.size());
+    MarkDirty(VertexStream::UV, vId, 1);
     uvs_[vId] = uv;
 }
 
 void Mesh::SetVertexColor(const size_t vId, const Vec4& color)
 {
     assert(vId < colors_.size());
+    MarkDirty(VertexStream::Color, vId, 1);
     colors_[vId] = color;
 }
 
 void Mesh::SetVertexPositions(const std::vector<Vec3>& positions)
 {
     positions_ = positions;
+    MarkDirty(VertexStream::Position);
 }
 
 void Mesh::SetVertexNormals(const std::vector<Vec3>& normals)
 {
     normals_ = normals;
+    MarkDirty(VertexStream::Normal);
 }
 
 void Mesh::SetVertexUVs(const std::vector<Vec2>& uvs)
 {
     uvs_ = uvs;
+    MarkDirty(VertexStream::UV);
 }
 
 void Mesh::SetVertexColors(const std::vector<Vec4>& colors)
 {
     colors_ = colors;
+    MarkDirty(VertexStream::Color);
 }
 
 
 void Mesh::AddIndex(uint32 index) 
 {
     indices_.push_back(index);
+    MarkIndicesDirty();
 }
 
 void Mesh::AddIndices(const std::vector<uint32>& indices)
 {
     indices_.insert(indices_.end(), indices.begin(), indices.end());
+    MarkIndicesDirty();
 }
 
 void Mesh::AddTriangle(uint32 i0, uint32 i1, uint32 i2) 
@@ -79,11 +193,13 @@ void Mesh::AddTriangle(uint32 i0, uint32 i1, uint32 i2)
     indices_.push_back(i0);
     indices_.push_back(i1);
     indices_.push_back(i2);
+    MarkIndicesDirty();
 }
 
 void Mesh::SetIndices(const std::vector<uint32>& indices) 
 {
     indices_ = indices;
+    MarkIndicesDirty();
 }
 
 void Mesh::Clear() 
@@ -93,6 +209,7 @@ void Mesh::Clear()
     uvs_.clear();
     colors_.clear();
     indices_.clear();
+    MarkAllDirty();
 }
 
 void Mesh::Reserve(size_t vertexCount, size_t indexCount) 
@@ -127,8 +244,22 @@ BoundingBox Mesh::CalculateBoundingBox() const
     return BoundingBox(min, max);
 }
 
+const BoundingBox& Mesh::GetBoundingBox() const
+{
+    const uint32 generation = GetStreamGeneration(VertexStream::Position);
+    if (!boundsValid_ || boundsGeneration_ != generation)
+    {
+        bounds_           = CalculateBoundingBox();
+        boundsGeneration_ = generation;
+        boundsValid_      = true;
+    }
+    return bounds_;
+}
+
 void Mesh::RecalculateNormals() 
 {
+    MarkDirty(VertexStream::Normal);
+    
     // Reset all normals to zero
     normals_.clear();
     normals_.resize(positions_.size(), glm::vec3(0.0f));
@@ -185,6 +316,9 @@ void Mesh::RecalculateTangents()
 
 void Mesh::Transform(const Mat4& transform) 
 {
+    MarkDirty(VertexStream::Position);
+    MarkDirty(VertexStream::Normal);
+    
     Mat3 normalMatrix = transpose(inverse(Mat3(transform)));
     for (size_t i = 0; i < positions_.size(); ++i) 
     {
@@ -196,12 +330,17 @@ void Mesh::Transform(const Mat4& transform)
 
 void Mesh::Translate(const Vec3& offset) 
 {
+    MarkDirty(VertexStream::Position);
+    
     for (size_t i = 0; i < positions_.size(); ++i)
         positions_[i] += offset;
 }
 
 void Mesh::Scale(const Vec3& scale) 
 {
+    MarkDirty(VertexStream::Position);
+    MarkDirty(VertexStream::Normal);
+    
     for (size_t i = 0; i < positions_.size(); ++i)
     {
         positions_[i].x *= scale.x;
@@ -215,6 +354,9 @@ void Mesh::Scale(const Vec3& scale)
 
 void Mesh::Rotate(const Quat& rotation) 
 {
+    MarkDirty(VertexStream::Position);
+    MarkDirty(VertexStream::Normal);
+    
     for (size_t i = 0; i < positions_.size(); ++i)
     {
         positions_[i] = rotation * positions_[i];
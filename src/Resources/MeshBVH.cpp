@@ -0,0 +1,350 @@
+#include "TLETC/Resources/MeshBVH.h"
+#include "TLETC/Resources/Mesh.h"
+#include "TLETC/Core/JobSystem.h"
+
+#include "Core/SIMD.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <limits>
+
+namespace TLETC {
+
+static constexpr uint32 s_maxLeafSize      = 4;  // One packet per leaf
+static constexpr uint32 s_fixedStackSize   = 64;
+static constexpr size_t s_minRaysPerJob    = 256;  // Smallest batch worth handing to another thread
+static constexpr float  s_miss             = std::numeric_limits<float>::max();
+
+MeshBVH::MeshBVH()
+    : triangleCount_(0), depth_(0), meshID_(0), positionGeneration_(0), indexGeneration_(0)
+{
+}
+
+MeshBVH::MeshBVH(const Mesh& mesh)
+    : MeshBVH()
+{
+    Build(mesh);
+}
+
+void MeshBVH::Clear()
+{
+    nodes_.clear();
+    packets_.clear();
+    triangleCount_ = 0;
+    depth_         = 0;
+    meshID_        = 0;
+}
+
+bool MeshBVH::Build(const Mesh& mesh)
+{
+    Clear();
+
+    const std::vector<Vec3>&   positions = mesh.GetVertexPositions();
+    const std::vector<uint32>& indices   = mesh.GetIndices();
+    const bool   indexed       = mesh.IsIndexed();
+    const size_t triangleCount = indexed ? indices.size() / 3 : positions.size() / 3;
+    if (triangleCount == 0) return false;
+
+    auto corner = [&](size_t triangle, size_t c) -> const Vec3& {
+        return positions[indexed ? indices[triangle * 3 + c] : triangle * 3 + c];
+    };
+
+    std::vector<BoundingBox> bounds(triangleCount);
+    for (size_t t = 0; t < triangleCount; ++t)
+    {
+        const Vec3& a = corner(t, 0);
+        const Vec3& b = corner(t, 1);
+        const Vec3& c = corner(t, 2);
+        bounds[t] = BoundingBox(glm::min(a, glm::min(b, c)), glm::max(a, glm::max(b, c)));
+    }
+
+    std::vector<uint32> order;
+    BuildBVH(bounds, s_maxLeafSize, nodes_, order);
+
+    // Transpose each leaf's triangles into a packet, unused lanes stay zero and can never be hit
+    for (BVHNode& node : nodes_)
+    {
+        if (!node.IsLeaf()) continue;
+
+        TrianglePacket packet = {};
+        for (uint32 lane = 0; lane < node.count; ++lane)
+        {
+            const uint32 triangle = order[node.leftFirst + lane];
+            const Vec3&  v0 = corner(triangle, 0);
+            const Vec3   e1 = corner(triangle, 1) - v0;
+            const Vec3   e2 = corner(triangle, 2) - v0;
+            packet.v0x[lane] = v0.x;  packet.v0y[lane] = v0.y;  packet.v0z[lane] = v0.z;
+            packet.e1x[lane] = e1.x;  packet.e1y[lane] = e1.y;  packet.e1z[lane] = e1.z;
+            packet.e2x[lane] = e2.x;  packet.e2y[lane] = e2.y;  packet.e2z[lane] = e2.z;
+            packet.triangles[lane] = triangle;
+        }
+        node.leftFirst = static_cast<uint32>(packets_.size());
+        packets_.push_back(packet);
+    }
+
+    // Depth bounds the traversal stack: every pop pushes at most two
+    std::vector<std::pair<uint32, uint32>> stack = { { 0u, 1u } };
+    while (!stack.empty())
+    {
+        const auto [index, depth] = stack.back();
+        stack.pop_back();
+        depth_ = std::max(depth_, depth);
+        if (!nodes_[index].IsLeaf())
+        {
+            stack.push_back({ nodes_[index].leftFirst, depth + 1 });
+            stack.push_back({ nodes_[index].leftFirst + 1, depth + 1 });
+        }
+    }
+
+    triangleCount_      = triangleCount;
+    meshID_             = mesh.GetID();
+    positionGeneration_ = mesh.GetStreamGeneration(VertexStream::Position);
+    indexGeneration_    = mesh.GetIndexGeneration();
+    return true;
+}
+
+bool MeshBVH::IsCurrent(const Mesh& mesh) const
+{
+    return IsBuilt() && meshID_ == mesh.GetID()
+        && positionGeneration_ == mesh.GetStreamGeneration(VertexStream::Position)
+        && indexGeneration_ == mesh.GetIndexGeneration();
+}
+
+size_t MeshBVH::GetMemoryUsage() const
+{
+    return nodes_.capacity() * sizeof(BVHNode) + packets_.capacity() * sizeof(TrianglePacket);
+}
+
+namespace {
+
+// Ray set up once per query for the box and triangle tests
+struct PreparedRay
+{
+    Vec3 origin;
+    Vec3 direction;
+    Vec3 inverse;
+#if defined(TLETC_SIMD_SSE)
+    __m128 origin4, inverse4;
+    __m128 ox, oy, oz, dx, dy, dz;
+#endif
+
+    explicit PreparedRay(const Ray& ray)
+        : origin(ray.origin), direction(ray.direction), inverse(1.0f / ray.direction)
+    {
+#if defined(TLETC_SIMD_SSE)
+        origin4  = _mm_setr_ps(origin.x, origin.y, origin.z, 0.0f);
+        inverse4 = _mm_setr_ps(inverse.x, inverse.y, inverse.z, 0.0f);
+        ox = _mm_set1_ps(origin.x);    oy = _mm_set1_ps(origin.y);    oz = _mm_set1_ps(origin.z);
+        dx = _mm_set1_ps(direction.x); dy = _mm_set1_ps(direction.y); dz = _mm_set1_ps(direction.z);
+#endif
+    }
+};
+
+#if defined(TLETC_SIMD_SSE)
+static inline float HorizontalMin(__m128 v)
+{
+    v = _mm_min_ps(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1)));
+    v = _mm_min_ps(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 0, 3, 2)));
+    return _mm_cvtss_f32(v);
+}
+
+static inline float HorizontalMax(__m128 v)
+{
+    v = _mm_max_ps(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1)));
+    v = _mm_max_ps(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 0, 3, 2)));
+    return _mm_cvtss_f32(v);
+}
+
+static inline __m128 Select(__m128 mask, __m128 a, __m128 b)
+{
+    return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+#endif
+
+// Where the ray enters the node's box, s_miss if it doesn't within [0, maxDistance]
+static inline float BoxEntry(const BVHNode& node, const PreparedRay& ray, float maxDistance)
+{
+#if defined(TLETC_SIMD_SSE)
+    // x, y, z in the first three lanes, the fourth holds leftFirst / count and is swapped for the [0, max] clamp
+    const __m128 xyz = _mm_castsi128_ps(_mm_setr_epi32(-1, -1, -1, 0));
+    const __m128 t0  = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(&node.min.x), ray.origin4), ray.inverse4);
+    const __m128 t1  = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(&node.max.x), ray.origin4), ray.inverse4);
+    const float enter = HorizontalMax(_mm_and_ps(_mm_min_ps(t0, t1), xyz));
+    const float exit  = HorizontalMin(Select(xyz, _mm_max_ps(t0, t1), _mm_set1_ps(maxDistance)));
+    return enter <= exit ? enter : s_miss;
+#else
+    const Vec3 t0 = (node.min - ray.origin) * ray.inverse;
+    const Vec3 t1 = (node.max - ray.origin) * ray.inverse;
+    const Vec3 tMin = glm::min(t0, t1);
+    const Vec3 tMax = glm::max(t0, t1);
+    const float enter = std::max(std::max(tMin.x, tMin.y), std::max(tMin.z, 0.0f));
+    const float exit  = std::min(std::min(tMax.x, tMax.y), std::min(tMax.z, maxDistance));
+    return enter <= exit ? enter : s_miss;
+#endif
+}
+
+} // namespace
+
+template<bool AnyHit>
+bool MeshBVH::Traverse(const Ray& ray, float maxDistance, MeshRaycastHit& hit) const
+{
+    hit = MeshRaycastHit();
+    if (nodes_.empty()) return false;
+
+    const PreparedRay r(ray);
+    float best = maxDistance;
+    if (BoxEntry(nodes_[0], r, best) == s_miss) return false;
+
+    struct Entry { uint32 node; float distance; };
+    Entry                 fixedStack[s_fixedStackSize];
+    std::vector<Entry>    heapStack;
+    Entry*                stack = fixedStack;
+    if (depth_ >= s_fixedStackSize)
+    {
+        heapStack.resize(depth_ + 1);
+        stack = heapStack.data();
+    }
+
+    size_t top = 0;
+    stack[top++] = { 0, 0.0f };
+    while (top > 0)
+    {
+        const Entry entry = stack[--top];
+        if (entry.distance > best) continue;
+        const BVHNode& node = nodes_[entry.node];
+
+        if (node.IsLeaf())
+        {
+            // Möller-Trumbore on all four lanes, double-sided
+            const TrianglePacket& p = packets_[node.leftFirst];
+#if defined(TLETC_SIMD_SSE)
+            const __m128 e1x = _mm_load_ps(p.e1x), e1y = _mm_load_ps(p.e1y), e1z = _mm_load_ps(p.e1z);
+            const __m128 e2x = _mm_load_ps(p.e2x), e2y = _mm_load_ps(p.e2y), e2z = _mm_load_ps(p.e2z);
+
+            const __m128 px  = _mm_sub_ps(_mm_mul_ps(r.dy, e2z), _mm_mul_ps(r.dz, e2y));
+            const __m128 py  = _mm_sub_ps(_mm_mul_ps(r.dz, e2x), _mm_mul_ps(r.dx, e2z));
+            const __m128 pz  = _mm_sub_ps(_mm_mul_ps(r.dx, e2y), _mm_mul_ps(r.dy, e2x));
+            const __m128 det = _mm_add_ps(_mm_add_ps(_mm_mul_ps(e1x, px), _mm_mul_ps(e1y, py)), _mm_mul_ps(e1z, pz));
+            const __m128 inv = _mm_div_ps(_mm_set1_ps(1.0f), det);
+
+            const __m128 tx = _mm_sub_ps(r.ox, _mm_load_ps(p.v0x));
+            const __m128 ty = _mm_sub_ps(r.oy, _mm_load_ps(p.v0y));
+            const __m128 tz = _mm_sub_ps(r.oz, _mm_load_ps(p.v0z));
+            const __m128 u  = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(tx, px), _mm_mul_ps(ty, py)), _mm_mul_ps(tz, pz)), inv);
+
+            const __m128 qx = _mm_sub_ps(_mm_mul_ps(ty, e1z), _mm_mul_ps(tz, e1y));
+            const __m128 qy = _mm_sub_ps(_mm_mul_ps(tz, e1x), _mm_mul_ps(tx, e1z));
+            const __m128 qz = _mm_sub_ps(_mm_mul_ps(tx, e1y), _mm_mul_ps(ty, e1x));
+            const __m128 v  = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(r.dx, qx), _mm_mul_ps(r.dy, qy)), _mm_mul_ps(r.dz, qz)), inv);
+            const __m128 t  = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(e2x, qx), _mm_mul_ps(e2y, qy)), _mm_mul_ps(e2z, qz)), inv);
+
+            // NaNs from a zero determinant fail every comparison, so degenerate and padding lanes drop out
+            const __m128 zero = _mm_setzero_ps();
+            __m128 mask = _mm_cmpneq_ps(det, zero);
+            mask = _mm_and_ps(mask, _mm_cmpge_ps(u, zero));
+            mask = _mm_and_ps(mask, _mm_cmpge_ps(v, zero));
+            mask = _mm_and_ps(mask, _mm_cmple_ps(_mm_add_ps(u, v), _mm_set1_ps(1.0f)));
+            mask = _mm_and_ps(mask, _mm_cmpge_ps(t, zero));
+            mask = _mm_and_ps(mask, _mm_cmple_ps(t, _mm_set1_ps(best)));
+
+            const int lanes = _mm_movemask_ps(mask);
+            if (lanes == 0) continue;
+
+            const __m128 candidates = Select(mask, t, _mm_set1_ps(s_miss));
+            const float  closest    = HorizontalMin(candidates);
+            const int    lane       = std::countr_zero(static_cast<uint32>(_mm_movemask_ps(_mm_cmpeq_ps(candidates, _mm_set1_ps(closest)))));
+
+            alignas(16) float us[4], vs[4];
+            _mm_store_ps(us, u);
+            _mm_store_ps(vs, v);
+            best             = closest;
+            hit.distance     = closest;
+            hit.triangle     = p.triangles[lane];
+            hit.barycentric  = Vec2(us[lane], vs[lane]);
+#else
+            bool found = false;
+            for (uint32 lane = 0; lane < node.count; ++lane)
+            {
+                const Vec3 e1(p.e1x[lane], p.e1y[lane], p.e1z[lane]);
+                const Vec3 e2(p.e2x[lane], p.e2y[lane], p.e2z[lane]);
+                const Vec3 pv  = glm::cross(r.direction, e2);
+                const float det = glm::dot(e1, pv);
+                if (det == 0.0f) continue;
+
+                const float inv = 1.0f / det;
+                const Vec3  tv  = r.origin - Vec3(p.v0x[lane], p.v0y[lane], p.v0z[lane]);
+                const float u   = glm::dot(tv, pv) * inv;
+                const Vec3  qv  = glm::cross(tv, e1);
+                const float v   = glm::dot(r.direction, qv) * inv;
+                const float t   = glm::dot(e2, qv) * inv;
+                if (u < 0.0f || v < 0.0f || u + v > 1.0f || t < 0.0f || t > best) continue;
+
+                best            = t;
+                hit.distance    = t;
+                hit.triangle    = p.triangles[lane];
+                hit.barycentric = Vec2(u, v);
+                found           = true;
+            }
+            if (!found) continue;
+#endif
+            if (AnyHit) return true;
+            continue;
+        }
+
+        // Nearer child on top, so the far one is often skipped once a hit is known
+        uint32 closer = node.leftFirst, further = node.leftFirst + 1;
+        float  tCloser  = BoxEntry(nodes_[closer], r, best);
+        float  tFurther = BoxEntry(nodes_[further], r, best);
+        if (tFurther < tCloser)
+        {
+            std::swap(closer, further);
+            std::swap(tCloser, tFurther);
+        }
+        if (tFurther != s_miss) stack[top++] = { further, tFurther };
+        if (tCloser != s_miss)  stack[top++] = { closer, tCloser };
+    }
+    return hit.IsHit();
+}
+
+bool MeshBVH::Raycast(const Ray& ray, float maxDistance, MeshRaycastHit& hit) const
+{
+    return Traverse<false>(ray, maxDistance, hit);
+}
+
+bool MeshBVH::Occluded(const Ray& ray, float maxDistance) const
+{
+    MeshRaycastHit hit;
+    return Traverse<true>(ray, maxDistance, hit);
+}
+
+void MeshBVH::Raycast(std::span<const Ray> rays, float maxDistance, std::span<MeshRaycastHit> hits, JobSystem* jobs) const
+{
+    auto trace = [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i)
+            Traverse<false>(rays[i], maxDistance, hits[i]);
+    };
+
+    const size_t count = std::min(rays.size(), hits.size());
+    if (jobs)
+        jobs->ParallelFor(count, s_minRaysPerJob, trace);
+    else
+        trace(0, count);
+}
+
+void MeshBVH::Occluded(std::span<const Ray> rays, float maxDistance, std::span<uint8> occluded, JobSystem* jobs) const
+{
+    auto trace = [&](size_t begin, size_t end) {
+        MeshRaycastHit hit;
+        for (size_t i = begin; i < end; ++i)
+            occluded[i] = Traverse<true>(rays[i], maxDistance, hit) ? 1 : 0;
+    };
+
+    const size_t count = std::min(rays.size(), occluded.size());
+    if (jobs)
+        jobs->ParallelFor(count, s_minRaysPerJob, trace);
+    else
+        trace(0, count);
+}
+
+} // namespace TLETC
@@ -0,0 +1,277 @@
+#include "TLETC/Resources/VertexLayout.h"
+#include "TLETC/Resources/Mesh.h"
+
+#include <glm/gtc/packing.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+
+namespace TLETC
+{
+
+VertexFormat& VertexFormat::Add(VertexStream stream, uint32 location, VertexAttribType type, uint32 components, bool normalized, VertexEncoding encoding)
+{
+    attributes_.push_back({ stream, location, type, components, normalized, stride_, encoding });
+    stride_ += GetTypeSize(type) * components;
+    return *this;
+}
+
+VertexFormat VertexFormat::Standard()
+{
+    return Create(VertexCompression::None);
+}
+
+VertexFormat VertexFormat::Create(uint32 compression)
+{
+    VertexFormat format;
+
+    // Position - 16-bit positions are padded to 4 components to keep 4-byte alignment
+    if (compression & VertexCompression::QuantizedPositions)
+        format.Add(VertexStream::Position, 0, VertexAttribType::UInt16, 4, true, VertexEncoding::Bounds);
+    else
+        format.Add(VertexStream::Position, 0, VertexAttribType::Float32, 3);
+
+    // Normal
+    if (compression & VertexCompression::OctahedralNormals)
+        format.Add(VertexStream::Normal, 1, VertexAttribType::Int16, 2, true, VertexEncoding::Octahedral);
+    else
+        format.Add(VertexStream::Normal, 1, VertexAttribType::Float32, 3);
+
+    // UV - half floats keep tiling UVs outside [0,1], so they win if both are asked for
+    if (compression & VertexCompression::HalfUVs)
+        format.Add(VertexStream::UV, 2, VertexAttribType::Float16, 2);
+    else if (compression & VertexCompression::Unorm16UVs)
+        format.Add(VertexStream::UV, 2, VertexAttribType::UInt16, 2, true);
+    else
+        format.Add(VertexStream::UV, 2, VertexAttribType::Float32, 2);
+
+    // Color
+    if (compression & VertexCompression::Unorm8Colors)
+        format.Add(VertexStream::Color, 3, VertexAttribType::UInt8, 4, true);
+    else
+        format.Add(VertexStream::Color, 3, VertexAttribType::Float32, 4);
+
+    return format;
+}
+
+bool VertexFormat::HasQuantizedPositions() const
+{
+    for (const VertexAttribute& attribute : attributes_)
+    {
+        if (attribute.encoding == VertexEncoding::Bounds)
+            return true;
+    }
+    return false;
+}
+
+VertexFormat VertexFormat::Extract(size_t attributeIndex) const
+{
+    const VertexAttribute& attribute = attributes_[attributeIndex];
+
+    VertexFormat format;
+    format.Add(attribute.stream, attribute.location, attribute.type, attribute.components, attribute.normalized, attribute.encoding);
+    return format;
+}
+
+uint32 VertexFormat::GetTypeSize(VertexAttribType type)
+{
+    switch (type)
+    {
+        case VertexAttribType::Float32: return 4;
+        case VertexAttribType::Float16: return 2;
+        case VertexAttribType::Int16:   return 2;
+        case VertexAttribType::UInt16:  return 2;
+        case VertexAttribType::UInt8:   return 1;
+        default: return 0;
+    }
+}
+
+IndexType SelectIndexType(size_t vertexCount)
+{
+    return vertexCount <= 65536 ? IndexType::UInt16 : IndexType::UInt32;
+}
+
+std::vector<uint16> NarrowIndices(std::span<const uint32> indices)
+{
+    std::vector<uint16> narrowed(indices.size());
+    for (size_t i = 0; i < indices.size(); ++i)
+    {
+        assert(indices[i] <= 0xFFFF);
+        narrowed[i] = static_cast<uint16>(indices[i]);
+    }
+    return narrowed;
+}
+
+Vec2 EncodeOctahedral(const Vec3& n)
+{
+    // Project onto the octahedron |x| + |y| + |z| = 1, then fold the lower half over the diagonals
+    const float l1 = std::abs(n.x) + std::abs(n.y) + std::abs(n.z);
+    if (l1 <= 0.0f) return Vec2(0.0f);
+
+    Vec2 e(n.x / l1, n.y / l1);
+    if (n.z < 0.0f)
+    {
+        const Vec2 folded((1.0f - std::abs(e.y)) * (e.x >= 0.0f ? 1.0f : -1.0f),
+                          (1.0f - std::abs(e.x)) * (e.y >= 0.0f ? 1.0f : -1.0f));
+        e = folded;
+    }
+    return e;
+}
+
+Vec3 DecodeOctahedral(const Vec2& e)
+{
+    Vec3 n(e.x, e.y, 1.0f - std::abs(e.x) - std::abs(e.y));
+    const float t = std::max(-n.z, 0.0f);
+    n.x += n.x >= 0.0f ? -t : t;
+    n.y += n.y >= 0.0f ? -t : t;
+    return normalize(n);
+}
+
+// Source components of a stream for one vertex, as floats
+static const float* GetStreamData(const Mesh& mesh, VertexStream stream, size_t vertex)
+{
+    switch (stream)
+    {
+        case VertexStream::Position: return &mesh.GetVertexPositions()[vertex].x;
+        case VertexStream::Normal:   return &mesh.GetVertexNormals()[vertex].x;
+        case VertexStream::UV:       return &mesh.GetVertexUVs()[vertex].x;
+        case VertexStream::Color:    return &mesh.GetVertexColors()[vertex].x;
+        default: return nullptr;
+    }
+}
+
+static size_t GetStreamSize(const Mesh& mesh, VertexStream stream)
+{
+    switch (stream)
+    {
+        case VertexStream::Position: return mesh.GetVertexPositions().size();
+        case VertexStream::Normal:   return mesh.GetVertexNormals().size();
+        case VertexStream::UV:       return mesh.GetVertexUVs().size();
+        case VertexStream::Color:    return mesh.GetVertexColors().size();
+        default: return 0;
+    }
+}
+
+static uint32 GetStreamComponents(VertexStream stream)
+{
+    switch (stream)
+    {
+        case VertexStream::UV:    return 2;
+        case VertexStream::Color: return 4;
+        default: return 3;
+    }
+}
+
+// Write one component in the attribute's storage type
+static void WriteComponent(uint8* dst, float value, VertexAttribType type, bool normalized)
+{
+    switch (type)
+    {
+        case VertexAttribType::Float32:
+        {
+            std::memcpy(dst, &value, sizeof(float));
+            break;
+        }
+        case VertexAttribType::Float16:
+        {
+            const uint16 half = glm::packHalf1x16(value);
+            std::memcpy(dst, &half, sizeof(uint16));
+            break;
+        }
+        case VertexAttribType::Int16:
+        {
+            const uint16 bits = normalized ? glm::packSnorm1x16(value) : static_cast<uint16>(static_cast<int16>(std::round(value)));
+            std::memcpy(dst, &bits, sizeof(uint16));
+            break;
+        }
+        case VertexAttribType::UInt16:
+        {
+            const uint16 bits = normalized ? glm::packUnorm1x16(value) : static_cast<uint16>(std::round(value));
+            std::memcpy(dst, &bits, sizeof(uint16));
+            break;
+        }
+        case VertexAttribType::UInt8:
+        {
+            *dst = normalized ? glm::packUnorm1x8(value) : static_cast<uint8>(std::round(value));
+            break;
+        }
+    }
+}
+
+std::vector<uint8> PackVertices(const Mesh& mesh, const VertexFormat& format)
+{
+    return PackVertices(mesh, format, format.HasQuantizedPositions() ? mesh.CalculateBoundingBox() : BoundingBox());
+}
+
+std::vector<uint8> PackVertices(const Mesh& mesh, const VertexFormat& format, const BoundingBox& bounds)
+{
+    return PackVertices(mesh, format, bounds, 0, mesh.GetVertexCount());
+}
+
+std::vector<uint8> PackVertices(const Mesh& mesh, const VertexFormat& format, const BoundingBox& bounds, size_t firstVertex, size_t vertexCount)
+{
+    const uint32 stride = format.GetStride();
+    const size_t end    = firstVertex + vertexCount;
+
+    // Flat boxes (planes) keep their zero extent at q = 0
+    const Vec3 extent    = bounds.GetSize();
+    const Vec3 invExtent = Vec3(extent.x > 0.0f ? 1.0f / extent.x : 0.0f,
+                                extent.y > 0.0f ? 1.0f / extent.y : 0.0f,
+                                extent.z > 0.0f ? 1.0f / extent.z : 0.0f);
+
+    // Streams shorter than the position stream leave their tail zeroed
+    std::vector<uint8> data(vertexCount * stride, 0);
+
+    for (const VertexAttribute& attribute : format.GetAttributes())
+    {
+        const size_t count    = std::min(end, GetStreamSize(mesh, attribute.stream));
+        const uint32 typeSize = VertexFormat::GetTypeSize(attribute.type);
+        const uint32 source   = std::min(attribute.components, GetStreamComponents(attribute.stream));
+
+        uint8* dst = data.data() + attribute.offset;
+        for (size_t v = firstVertex; v < count; ++v, dst += stride)
+        {
+            const float* src = GetStreamData(mesh, attribute.stream, v);
+
+            // Plain float copy, nothing to convert
+            if (attribute.type == VertexAttribType::Float32 && attribute.encoding == VertexEncoding::Direct)
+            {
+                std::memcpy(dst, src, source * sizeof(float));
+                continue;
+            }
+
+            float values[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+            switch (attribute.encoding)
+            {
+                case VertexEncoding::Octahedral:
+                {
+                    const Vec2 e = EncodeOctahedral(Vec3(src[0], src[1], src[2]));
+                    values[0] = e.x;
+                    values[1] = e.y;
+                    break;
+                }
+                case VertexEncoding::Bounds:
+                {
+                    for (uint32 c = 0; c < 3; ++c)
+                        values[c] = (src[c] - bounds.min[c]) * invExtent[c];
+                    break;
+                }
+                default:
+                {
+                    for (uint32 c = 0; c < source; ++c)
+                        values[c] = src[c];
+                    break;
+                }
+            }
+
+            for (uint32 c = 0; c < attribute.components; ++c)
+                WriteComponent(dst + c * typeSize, values[c], attribute.type, attribute.normalized);
+        }
+    }
+
+    return data;
+}
+
+} // namespace TLETC
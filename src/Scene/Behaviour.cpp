@@ -1,10 +1,16 @@
 #include "TLETC/Scene/Behaviour.h"
 #include "TLETC/Scene/Entity.h"
+#include "TLETC/Core/Application.h"
+
+#include <algorithm>
 
 namespace TLETC {
 
-Behaviour::Behaviour() : entity_(nullptr), enabled_(true), executionOrder_(0), eventFlags_(EventFlag::None)
+Behaviour::Behaviour() 
+    : entity_(nullptr), enabled_(true), executionOrder_(0), eventFlags_(EventFlag::None)
+    , reads_(DataFlag::NoData), writes_(DataFlag::NoData), accessDeclared_(false), threadSafe_(false)
 {
+    std::fill(std::begin(eventSlots_), std::end(eventSlots_), NoEventSlot);
 }
 
 Behaviour::~Behaviour() 
@@ -19,4 +25,20 @@ Input* Behaviour::GetInput() const
     return nullptr;
 }
 
+JobSystem* Behaviour::GetJobSystem() const
+{
+    if (entity_ && entity_->GetApplication()) {
+        return &entity_->GetApplication()->GetJobSystem();
+    }
+    return nullptr;
+}
+
+World* Behaviour::GetWorld() const
+{
+    if (entity_ && entity_->GetApplication()) {
+        return &entity_->GetApplication()->GetWorld();
+    }
+    return nullptr;
+}
+
 } // namespace TLETC
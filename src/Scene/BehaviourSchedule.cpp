@@ -0,0 +1,142 @@
+#include "TLETC/Scene/BehaviourSchedule.h"
+
+#include <algorithm>
+#include <functional>
+#include <numeric>
+
+namespace TLETC
+{
+
+namespace
+{
+
+// Entities share meshes, and a mesh fills its bounding box cache on first read, so two
+// behaviours touching MeshData can race even on different entities
+constexpr uint32 SharedData = Behaviour::MeshData;
+
+// One writes what the other reads or writes
+bool Conflicts(const Behaviour* a, const Behaviour* b)
+{
+    return (a->GetWrites() & (b->GetReads() | b->GetWrites())) != 0 || (b->GetWrites() & a->GetReads()) != 0;
+}
+
+} // namespace
+
+void BehaviourSchedule::Build(const std::vector<Behaviour*>& sorted)
+{
+    Clear();
+
+    std::vector<Behaviour*> threadSafe;
+    std::vector<Behaviour*> declared;
+    for (size_t begin = 0; begin < sorted.size();)
+    {
+        const uint16 order = sorted[begin]->GetExecutionOrder();
+
+        Batch batch;
+        batch.serialBegin = static_cast<uint32>(serial_.size());
+        batch.taskBegin   = static_cast<uint32>(taskStarts_.size());
+
+        threadSafe.clear();
+        declared.clear();
+        size_t end = begin;
+        for (; end < sorted.size() && sorted[end]->GetExecutionOrder() == order; ++end)
+        {
+            Behaviour* behaviour = sorted[end];
+            if (behaviour->IsThreadSafe())
+                threadSafe.push_back(behaviour);
+            else if (behaviour->HasDeclaredAccess())
+                declared.push_back(behaviour);
+            else
+                serial_.push_back(behaviour);
+        }
+        AddTasks(threadSafe, declared);
+
+        batch.serialEnd = static_cast<uint32>(serial_.size());
+        batch.taskEnd   = static_cast<uint32>(taskStarts_.size());
+        batches_.push_back(batch);
+        begin = end;
+    }
+
+    taskStarts_.push_back(static_cast<uint32>(parallel_.size()));
+}
+
+void BehaviourSchedule::Clear()
+{
+    batches_.clear();
+    serial_.clear();
+    parallel_.clear();
+    taskStarts_.clear();
+}
+
+void BehaviourSchedule::AddTasks(std::vector<Behaviour*>& threadSafe, std::vector<Behaviour*>& declared)
+{
+    for (Behaviour* behaviour : threadSafe)
+    {
+        taskStarts_.push_back(static_cast<uint32>(parallel_.size()));
+        parallel_.push_back(behaviour);
+    }
+
+    // Entity by entity, keeping list order within each
+    std::stable_sort(declared.begin(), declared.end(), [](Behaviour* a, Behaviour* b) {
+        return std::less<Entity*>()(a->GetEntity(), b->GetEntity());
+    });
+
+    // Groups joined by conflicts, each labelled by its first member. Conflicts are looked for
+    // between behaviours of one entity, except for shared data that every toucher is joined on
+    const size_t count = declared.size();
+    std::vector<uint32> groups(count);
+    std::iota(groups.begin(), groups.end(), 0u);
+    auto find = [&groups](uint32 i) {
+        while (groups[i] != i)
+            i = groups[i] = groups[groups[i]];
+        return i;
+    };
+    auto join = [&](uint32 a, uint32 b) {
+        a = find(a);
+        b = find(b);
+        if (a != b)
+            groups[std::max(a, b)] = std::min(a, b);
+    };
+
+    uint32 sharedFirst = static_cast<uint32>(count);
+    for (size_t begin = 0; begin < count;)
+    {
+        size_t end = begin + 1;
+        while (end < count && declared[end]->GetEntity() == declared[begin]->GetEntity())
+            ++end;
+
+        for (size_t a = begin; a < end; ++a)
+        {
+            for (size_t b = a + 1; b < end; ++b)
+            {
+                if (Conflicts(declared[a], declared[b]))
+                    join(static_cast<uint32>(a), static_cast<uint32>(b));
+            }
+
+            if ((declared[a]->GetReads() | declared[a]->GetWrites()) & SharedData)
+            {
+                if (sharedFirst == count)
+                    sharedFirst = static_cast<uint32>(a);
+                else
+                    join(sharedFirst, static_cast<uint32>(a));
+            }
+        }
+        begin = end;
+    }
+
+    // Members of a group follow one another, in declared order
+    std::vector<uint32> members(count);
+    std::iota(members.begin(), members.end(), 0u);
+    for (uint32 i = 0; i < count; ++i)
+        groups[i] = find(i);
+    std::stable_sort(members.begin(), members.end(), [&groups](uint32 a, uint32 b) { return groups[a] < groups[b]; });
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (i == 0 || groups[members[i]] != groups[members[i - 1]])
+            taskStarts_.push_back(static_cast<uint32>(parallel_.size()));
+        parallel_.push_back(declared[members[i]]);
+    }
+}
+
+} // namespace TLETC
@@ -0,0 +1,204 @@
+#include "TLETC/Scene/CullingSystem.h"
+
+#include "Core/SIMD.h"
+
+#include <bit>
+#include <cassert>
+#include <cmath>
+
+namespace TLETC {
+
+static constexpr size_t s_maxLanes = 8;
+
+// Plane components splatted once per Cull, |normal| is what the half-extents are scaled by
+struct CullPlanes
+{
+    float nx[Frustum::Count], ny[Frustum::Count], nz[Frustum::Count], w[Frustum::Count];
+    float ax[Frustum::Count], ay[Frustum::Count], az[Frustum::Count];
+};
+
+static CullPlanes SplitPlanes(const Frustum& frustum)
+{
+    CullPlanes p;
+    for (int i = 0; i < Frustum::Count; ++i)
+    {
+        const Vec4& plane = frustum.planes[i];
+        p.nx[i] = plane.x;
+        p.ny[i] = plane.y;
+        p.nz[i] = plane.z;
+        p.w[i]  = plane.w;
+        p.ax[i] = std::abs(plane.x);
+        p.ay[i] = std::abs(plane.y);
+        p.az[i] = std::abs(plane.z);
+    }
+    return p;
+}
+
+// Appends first + the index of every set bit of mask
+static uint32* AppendLanes(uint32* out, uint32 first, uint32 mask)
+{
+    while (mask)
+    {
+        *out++ = first + static_cast<uint32>(std::countr_zero(mask));
+        mask &= mask - 1;
+    }
+    return out;
+}
+
+CullingSystem::CullingSystem()
+    : count_(0)
+{
+}
+
+void CullingSystem::Clear()
+{
+    centerX_.clear(); centerY_.clear(); centerZ_.clear();
+    extentX_.clear(); extentY_.clear(); extentZ_.clear();
+    count_ = 0;
+}
+
+void CullingSystem::Reserve(size_t count)
+{
+    const size_t padded = (count + s_maxLanes - 1) / s_maxLanes * s_maxLanes;
+    for (std::vector<float>* array : { &centerX_, &centerY_, &centerZ_, &extentX_, &extentY_, &extentZ_ })
+        array->reserve(padded);
+}
+
+uint32 CullingSystem::Add(const BoundingBox& bounds)
+{
+    // Grow a whole group of lanes at a time, the padding is never reported as visible
+    if (count_ == centerX_.size())
+    {
+        const size_t padded = count_ + s_maxLanes;
+        for (std::vector<float>* array : { &centerX_, &centerY_, &centerZ_, &extentX_, &extentY_, &extentZ_ })
+            array->resize(padded, 0.0f);
+    }
+
+    const uint32 slot = static_cast<uint32>(count_++);
+    Set(slot, bounds);
+    return slot;
+}
+
+void CullingSystem::Set(uint32 slot, const BoundingBox& bounds)
+{
+    assert(slot < count_);
+    const Vec3 center  = bounds.GetCenter();
+    const Vec3 extents = bounds.GetSize() * 0.5f;
+    centerX_[slot] = center.x;  extentX_[slot] = extents.x;
+    centerY_[slot] = center.y;  extentY_[slot] = extents.y;
+    centerZ_[slot] = center.z;  extentZ_[slot] = extents.z;
+}
+
+BoundingBox CullingSystem::Get(uint32 slot) const
+{
+    assert(slot < count_);
+    const Vec3 center(centerX_[slot], centerY_[slot], centerZ_[slot]);
+    const Vec3 extents(extentX_[slot], extentY_[slot], extentZ_[slot]);
+    return BoundingBox(center - extents, center + extents);
+}
+
+uint32 CullingSystem::GetLaneCount()
+{
+#if defined(TLETC_SIMD_AVX)
+    return 8;
+#elif defined(TLETC_SIMD_SSE)
+    return 4;
+#else
+    return 1;
+#endif
+}
+
+size_t CullingSystem::Cull(const Frustum& frustum, std::vector<uint32>& visible) const
+{
+    // Written through a raw cursor and trimmed at the end, push_back per survivor is most of the cost otherwise
+    visible.resize(count_ + s_maxLanes);
+    uint32* out = visible.data();
+
+    const CullPlanes p = SplitPlanes(frustum);
+    const float* cx = centerX_.data();
+    const float* cy = centerY_.data();
+    const float* cz = centerZ_.data();
+    const float* ex = extentX_.data();
+    const float* ey = extentY_.data();
+    const float* ez = extentZ_.data();
+
+    // Same sums in the same order as Frustum::Intersects, so every path agrees with it exactly:
+    // a box is out once (n.c + |n|.e) + w < 0 for any plane
+#if defined(TLETC_SIMD_AVX)
+    __m256 nx[Frustum::Count], ny[Frustum::Count], nz[Frustum::Count], w[Frustum::Count];
+    __m256 ax[Frustum::Count], ay[Frustum::Count], az[Frustum::Count];
+    for (int i = 0; i < Frustum::Count; ++i)
+    {
+        nx[i] = _mm256_set1_ps(p.nx[i]); ny[i] = _mm256_set1_ps(p.ny[i]); nz[i] = _mm256_set1_ps(p.nz[i]);
+        ax[i] = _mm256_set1_ps(p.ax[i]); ay[i] = _mm256_set1_ps(p.ay[i]); az[i] = _mm256_set1_ps(p.az[i]);
+        w[i]  = _mm256_set1_ps(p.w[i]);
+    }
+    const __m256 zero = _mm256_setzero_ps();
+
+    for (size_t i = 0; i < count_; i += 8)
+    {
+        const __m256 x  = _mm256_loadu_ps(cx + i), y  = _mm256_loadu_ps(cy + i), z  = _mm256_loadu_ps(cz + i);
+        const __m256 hx = _mm256_loadu_ps(ex + i), hy = _mm256_loadu_ps(ey + i), hz = _mm256_loadu_ps(ez + i);
+
+        __m256 inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+        for (int k = 0; k < Frustum::Count; ++k)
+        {
+            const __m256 d = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(nx[k], x), _mm256_mul_ps(ny[k], y)), _mm256_mul_ps(nz[k], z));
+            const __m256 r = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(ax[k], hx), _mm256_mul_ps(ay[k], hy)), _mm256_mul_ps(az[k], hz));
+            inside = _mm256_and_ps(inside, _mm256_cmp_ps(_mm256_add_ps(_mm256_add_ps(d, r), w[k]), zero, _CMP_GE_OQ));
+        }
+
+        uint32 mask = static_cast<uint32>(_mm256_movemask_ps(inside));
+        if (count_ - i < 8)
+            mask &= (1u << (count_ - i)) - 1;
+        out = AppendLanes(out, static_cast<uint32>(i), mask);
+    }
+#elif defined(TLETC_SIMD_SSE)
+    __m128 nx[Frustum::Count], ny[Frustum::Count], nz[Frustum::Count], w[Frustum::Count];
+    __m128 ax[Frustum::Count], ay[Frustum::Count], az[Frustum::Count];
+    for (int i = 0; i < Frustum::Count; ++i)
+    {
+        nx[i] = _mm_set1_ps(p.nx[i]); ny[i] = _mm_set1_ps(p.ny[i]); nz[i] = _mm_set1_ps(p.nz[i]);
+        ax[i] = _mm_set1_ps(p.ax[i]); ay[i] = _mm_set1_ps(p.ay[i]); az[i] = _mm_set1_ps(p.az[i]);
+        w[i]  = _mm_set1_ps(p.w[i]);
+    }
+    const __m128 zero = _mm_setzero_ps();
+
+    for (size_t i = 0; i < count_; i += 4)
+    {
+        const __m128 x  = _mm_loadu_ps(cx + i), y  = _mm_loadu_ps(cy + i), z  = _mm_loadu_ps(cz + i);
+        const __m128 hx = _mm_loadu_ps(ex + i), hy = _mm_loadu_ps(ey + i), hz = _mm_loadu_ps(ez + i);
+
+        __m128 inside = _mm_cmpeq_ps(zero, zero);
+        for (int k = 0; k < Frustum::Count; ++k)
+        {
+            const __m128 d = _mm_add_ps(_mm_add_ps(_mm_mul_ps(nx[k], x), _mm_mul_ps(ny[k], y)), _mm_mul_ps(nz[k], z));
+            const __m128 r = _mm_add_ps(_mm_add_ps(_mm_mul_ps(ax[k], hx), _mm_mul_ps(ay[k], hy)), _mm_mul_ps(az[k], hz));
+            inside = _mm_and_ps(inside, _mm_cmpge_ps(_mm_add_ps(_mm_add_ps(d, r), w[k]), zero));
+        }
+
+        uint32 mask = static_cast<uint32>(_mm_movemask_ps(inside));
+        if (count_ - i < 4)
+            mask &= (1u << (count_ - i)) - 1;
+        out = AppendLanes(out, static_cast<uint32>(i), mask);
+    }
+#else
+    for (size_t i = 0; i < count_; ++i)
+    {
+        bool inside = true;
+        for (int k = 0; k < Frustum::Count && inside; ++k)
+        {
+            const float d = p.nx[k] * cx[i] + p.ny[k] * cy[i] + p.nz[k] * cz[i];
+            const float r = p.ax[k] * ex[i] + p.ay[k] * ey[i] + p.az[k] * ez[i];
+            inside = d + r + p.w[k] >= 0.0f;
+        }
+        if (inside)
+            *out++ = static_cast<uint32>(i);
+    }
+#endif
+
+    visible.resize(static_cast<size_t>(out - visible.data()));
+    return visible.size();
+}
+
+} // namespace TLETC
@@ -6,8 +6,9 @@
 
 namespace TLETC {
 
-Entity::Entity(const std::string& name)
-    : name(name)
+Entity::Entity(TransformSystem& transforms, const std::string& name)
+    : transform(transforms)
+    , name(name)
     , mesh(nullptr)
     , enabled_(true)
     , initialized_(false)
@@ -28,6 +29,11 @@ void Entity::RemoveBehaviour(Behaviour* behaviour)
     if (it != behaviours_.end()) 
     {
         (*it)->OnDestroy();
+
+        // The update schedules may still be running it (it may even be removing itself), so an
+        // application's behaviour lives on, disabled, until the end of the frame
+        if (application_)
+            application_->QueueBehaviourDestruction(std::move(*it));
         behaviours_.erase(it);
     }
 }
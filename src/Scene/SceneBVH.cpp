@@ -0,0 +1,310 @@
+#include "TLETC/Scene/SceneBVH.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace TLETC {
+
+static constexpr uint32 s_maxLeafSize = 4;
+static constexpr uint32 s_noParent    = ~0u;
+static constexpr size_t s_stackSize   = 64;  // Reserved up front, SAH trees are rarely deeper
+
+static bool Overlaps(const BVHNode& node, const BoundingBox& box)
+{
+    return node.min.x <= box.max.x && node.max.x >= box.min.x &&
+           node.min.y <= box.max.y && node.max.y >= box.min.y &&
+           node.min.z <= box.max.z && node.max.z >= box.min.z;
+}
+
+static bool Overlaps(const BoundingBox& a, const BoundingBox& b)
+{
+    return a.min.x <= b.max.x && a.max.x >= b.min.x &&
+           a.min.y <= b.max.y && a.max.y >= b.min.y &&
+           a.min.z <= b.max.z && a.max.z >= b.min.z;
+}
+
+// Slab test with the reciprocal direction hoisted out of the traversal
+static float RayEntry(const Vec3& min, const Vec3& max, const Vec3& origin, const Vec3& inverse, float maxDistance)
+{
+    const Vec3 t0 = (min - origin) * inverse;
+    const Vec3 t1 = (max - origin) * inverse;
+    const Vec3 tMin = glm::min(t0, t1);
+    const Vec3 tMax = glm::max(t0, t1);
+    const float enter = std::max(std::max(tMin.x, tMin.y), std::max(tMin.z, 0.0f));
+    const float exit  = std::min(std::min(tMax.x, tMax.y), std::min(tMax.z, maxDistance));
+    return enter <= exit ? enter : std::numeric_limits<float>::max();
+}
+
+SceneBVH::SceneBVH()
+    : builtCost_(0.0f), cost_(0.0f), rebuildThreshold_(1.5f), rebuildCount_(0), structureDirty_(false)
+{
+}
+
+void SceneBVH::Insert(Entity* entity, const BoundingBox& bounds)
+{
+    if (Contains(entity))
+    {
+        SetBounds(entity, bounds);
+        return;
+    }
+
+    items_.emplace(entity, static_cast<uint32>(entities_.size()));
+    entities_.push_back(entity);
+    bounds_.push_back(bounds);
+    itemLeaves_.push_back(s_noParent);
+    structureDirty_ = true;
+}
+
+void SceneBVH::SetBounds(Entity* entity, const BoundingBox& bounds)
+{
+    auto it = items_.find(entity);
+    if (it == items_.end()) return;
+
+    BoundingBox& current = bounds_[it->second];
+    if (current.min == bounds.min && current.max == bounds.max) return;
+
+    current = bounds;
+    if (!structureDirty_)
+        dirtyLeaves_.push_back(itemLeaves_[it->second]);
+}
+
+void SceneBVH::Remove(Entity* entity)
+{
+    auto it = items_.find(entity);
+    if (it == items_.end()) return;
+
+    // Swap the last item into the hole, the tree is rebuilt anyway
+    const uint32 item = it->second;
+    const uint32 last = static_cast<uint32>(entities_.size() - 1);
+    items_.erase(it);
+    if (item != last)
+    {
+        entities_[item]   = entities_[last];
+        bounds_[item]     = bounds_[last];
+        items_[entities_[item]] = item;
+    }
+    entities_.pop_back();
+    bounds_.pop_back();
+    itemLeaves_.pop_back();
+    structureDirty_ = true;
+}
+
+void SceneBVH::Clear()
+{
+    entities_.clear();
+    bounds_.clear();
+    itemLeaves_.clear();
+    items_.clear();
+    nodes_.clear();
+    parents_.clear();
+    order_.clear();
+    dirtyLeaves_.clear();
+    builtCost_      = 0.0f;
+    cost_           = 0.0f;
+    structureDirty_ = false;
+}
+
+void SceneBVH::Update()
+{
+    if (structureDirty_)
+    {
+        Rebuild();
+        return;
+    }
+    if (dirtyLeaves_.empty()) return;
+
+    // Refit from each moved leaf upwards, stopping where a node comes out the same
+    for (uint32 leaf : dirtyLeaves_)
+    {
+        BVHNode& node = nodes_[leaf];
+        BoundingBox fit = bounds_[order_[node.leftFirst]];
+        for (uint32 i = 1; i < node.count; ++i)
+        {
+            const BoundingBox& box = bounds_[order_[node.leftFirst + i]];
+            fit.min = glm::min(fit.min, box.min);
+            fit.max = glm::max(fit.max, box.max);
+        }
+        node.min = fit.min;
+        node.max = fit.max;
+
+        for (uint32 parent = parents_[leaf]; parent != s_noParent; parent = parents_[parent])
+        {
+            BVHNode&       p     = nodes_[parent];
+            const BVHNode& left  = nodes_[p.leftFirst];
+            const BVHNode& right = nodes_[p.leftFirst + 1];
+            const Vec3 min = glm::min(left.min, right.min);
+            const Vec3 max = glm::max(left.max, right.max);
+            if (min == p.min && max == p.max) break;
+            p.min = min;
+            p.max = max;
+        }
+    }
+    dirtyLeaves_.clear();
+
+    cost_ = GetBVHCost(nodes_);
+    if (cost_ > builtCost_ * rebuildThreshold_)
+        Rebuild();
+}
+
+void SceneBVH::Rebuild()
+{
+    BuildBVH(bounds_, s_maxLeafSize, nodes_, order_);
+
+    parents_.assign(nodes_.size(), s_noParent);
+    for (uint32 i = 0; i < nodes_.size(); ++i)
+    {
+        const BVHNode& node = nodes_[i];
+        if (node.IsLeaf())
+        {
+            for (uint32 j = 0; j < node.count; ++j)
+                itemLeaves_[order_[node.leftFirst + j]] = i;
+        }
+        else
+        {
+            parents_[node.leftFirst]     = i;
+            parents_[node.leftFirst + 1] = i;
+        }
+    }
+
+    builtCost_      = GetBVHCost(nodes_);
+    cost_           = builtCost_;
+    structureDirty_ = false;
+    dirtyLeaves_.clear();
+    ++rebuildCount_;
+}
+
+bool SceneBVH::Raycast(const Ray& ray, float maxDistance, SceneRaycastHit& hit) const
+{
+    if (nodes_.empty()) return false;
+
+    const Vec3 inverse = 1.0f / ray.direction;
+    const float miss   = std::numeric_limits<float>::max();
+    float best = maxDistance;
+    hit = SceneRaycastHit();
+
+    if (RayEntry(nodes_[0].min, nodes_[0].max, ray.origin, inverse, best) == miss) return false;
+
+    // Nearer child first, so most far subtrees are skipped once something closer was hit
+    struct Entry { uint32 node; float distance; };
+    std::vector<Entry> stack;
+    stack.reserve(s_stackSize);
+    stack.push_back({ 0, 0.0f });
+
+    while (!stack.empty())
+    {
+        const Entry entry = stack.back();
+        stack.pop_back();
+        if (entry.distance > best) continue;
+        const BVHNode& node = nodes_[entry.node];
+
+        if (node.IsLeaf())
+        {
+            for (uint32 i = 0; i < node.count; ++i)
+            {
+                const uint32 item = order_[node.leftFirst + i];
+                const float  t    = RayEntry(bounds_[item].min, bounds_[item].max, ray.origin, inverse, best);
+                if (t != miss && (!hit.entity || t < best))
+                {
+                    best         = t;
+                    hit.entity   = entities_[item];
+                    hit.distance = t;
+                }
+            }
+            continue;
+        }
+
+        uint32 closer = node.leftFirst, further = node.leftFirst + 1;
+        float  tCloser  = RayEntry(nodes_[closer].min, nodes_[closer].max, ray.origin, inverse, best);
+        float  tFurther = RayEntry(nodes_[further].min, nodes_[further].max, ray.origin, inverse, best);
+        if (tFurther < tCloser)
+        {
+            std::swap(closer, further);
+            std::swap(tCloser, tFurther);
+        }
+        if (tFurther != miss) stack.push_back({ further, tFurther });
+        if (tCloser != miss)  stack.push_back({ closer, tCloser });
+    }
+    return hit.entity != nullptr;
+}
+
+void SceneBVH::QueryFrustum(const Frustum& frustum, std::vector<Entity*>& results) const
+{
+    if (nodes_.empty()) return;
+
+    std::vector<uint32> stack;
+    stack.reserve(s_stackSize);
+    stack.push_back(0);
+
+    while (!stack.empty())
+    {
+        const uint32   index = stack.back();
+        const BVHNode& node  = nodes_[index];
+        stack.pop_back();
+        const BoundingBox bounds = node.GetBounds();
+        if (!frustum.Intersects(bounds)) continue;
+
+        // Fully inside: everything below is visible without further plane tests
+        if (frustum.Contains(bounds))
+        {
+            CollectSubtree(index, results);
+            continue;
+        }
+
+        if (node.IsLeaf())
+        {
+            for (uint32 i = 0; i < node.count; ++i)
+            {
+                const uint32 item = order_[node.leftFirst + i];
+                if (frustum.Intersects(bounds_[item]))
+                    results.push_back(entities_[item]);
+            }
+            continue;
+        }
+        stack.push_back(node.leftFirst + 1);
+        stack.push_back(node.leftFirst);
+    }
+}
+
+void SceneBVH::QueryOverlap(const BoundingBox& box, std::vector<Entity*>& results) const
+{
+    if (nodes_.empty()) return;
+
+    std::vector<uint32> stack;
+    stack.reserve(s_stackSize);
+    stack.push_back(0);
+
+    while (!stack.empty())
+    {
+        const BVHNode& node = nodes_[stack.back()];
+        stack.pop_back();
+        if (!Overlaps(node, box)) continue;
+
+        if (node.IsLeaf())
+        {
+            for (uint32 i = 0; i < node.count; ++i)
+            {
+                const uint32 item = order_[node.leftFirst + i];
+                if (Overlaps(bounds_[item], box))
+                    results.push_back(entities_[item]);
+            }
+            continue;
+        }
+        stack.push_back(node.leftFirst + 1);
+        stack.push_back(node.leftFirst);
+    }
+}
+
+void SceneBVH::CollectSubtree(uint32 index, std::vector<Entity*>& results) const
+{
+    // Leaves of a subtree cover one contiguous run of order_, found at its outermost leaves
+    uint32 first = index, last = index;
+    while (!nodes_[first].IsLeaf()) first = nodes_[first].leftFirst;
+    while (!nodes_[last].IsLeaf())  last  = nodes_[last].leftFirst + 1;
+
+    const uint32 begin = nodes_[first].leftFirst;
+    const uint32 end   = nodes_[last].leftFirst + nodes_[last].count;
+    for (uint32 i = begin; i < end; ++i)
+        results.push_back(entities_[order_[i]]);
+}
+
+} // namespace TLETC
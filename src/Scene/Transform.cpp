@@ -0,0 +1,102 @@
+#include "TLETC/Scene/Transform.h"
+
+#include <iostream>
+
+namespace TLETC {
+
+Transform::Transform(TransformSystem& system)
+    : system_(&system)
+    , id_(system.Create(this))
+{
+}
+
+Transform::Transform(const Transform& other)
+    : system_(other.system_)
+    , id_(other.system_->Create(this))
+{
+    SetPosition(other.GetPosition());
+    SetRotation(other.GetRotation());
+    SetScale(other.GetScale());
+    system_->SetParent(id_, system_->GetParent(other.id_));
+}
+
+Transform::Transform(Transform&& other) noexcept
+    : system_(other.system_)
+    , id_(other.id_)
+{
+    other.id_ = TransformSystem::NoNode;
+    if (id_ != TransformSystem::NoNode)
+        system_->SetOwner(id_, this);
+}
+
+Transform& Transform::operator=(const Transform& other)
+{
+    if (this == &other)
+        return *this;
+
+    if (system_ != other.system_ || id_ == TransformSystem::NoNode)
+    {
+        system_->Destroy(id_);
+        system_ = other.system_;
+        id_     = system_->Create(this);
+    }
+
+    SetPosition(other.GetPosition());
+    SetRotation(other.GetRotation());
+    SetScale(other.GetScale());
+    system_->SetParent(id_, system_->GetParent(other.id_));
+    return *this;
+}
+
+Transform& Transform::operator=(Transform&& other) noexcept
+{
+    if (this == &other)
+        return *this;
+
+    system_->Destroy(id_);
+    system_   = other.system_;
+    id_       = other.id_;
+    other.id_ = TransformSystem::NoNode;
+    if (id_ != TransformSystem::NoNode)
+        system_->SetOwner(id_, this);
+    return *this;
+}
+
+Transform::~Transform()
+{
+    system_->Destroy(id_);
+}
+
+void Transform::Rotate(const Vec3& axis, float angleDegrees)
+{
+    SetRotation(normalize(QuatFromAxisAngle(axis, Radians(angleDegrees)) * GetRotation()));
+}
+
+void Transform::Translate(const Vec3& delta)
+{
+    SetPosition(GetPosition() + delta);
+}
+
+void Transform::LookAt(const Vec3& target, const Vec3& up)
+{
+    Mat4 lookMatrix = glm::lookAt(GetPosition(), target, up);
+    SetRotation(glm::quat_cast(glm::inverse(lookMatrix)));
+}
+
+bool Transform::SetParent(Transform* newParent)
+{
+    if (newParent && newParent->system_ != system_)
+    {
+        std::cerr << "Transform::SetParent: parent belongs to another TransformSystem" << std::endl;
+        return false;
+    }
+    return system_->SetParent(id_, newParent ? newParent->id_ : TransformSystem::NoNode);
+}
+
+Transform* Transform::GetParent() const
+{
+    const uint32 parent = system_->GetParent(id_);
+    return parent == TransformSystem::NoNode ? nullptr : system_->GetOwner(parent);
+}
+
+} // namespace TLETC
@@ -0,0 +1,423 @@
+#include "TLETC/Scene/TransformSystem.h"
+#include "TLETC/Core/JobSystem.h"
+
+#include "Core/SIMD.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <type_traits>
+
+namespace TLETC
+{
+
+namespace
+{
+
+// Below this many nodes per job, handing work to another thread costs more than the sweep itself
+constexpr size_t s_minNodesPerJob = 2048;
+
+// Holes left by destroyed leaves are dropped once they make up this share of the slots
+constexpr size_t s_maxHoleShare = 4;  // 1 in 4
+
+// parent * local, four columns of multiply-adds
+inline void MultiplyMatrix(const Mat4& parent, const Mat4& local, Mat4& out)
+{
+#if defined(TLETC_SIMD_SSE)
+    const float* a = &parent[0][0];
+    const float* b = &local[0][0];
+    float*       o = &out[0][0];
+
+    const __m128 column0 = _mm_loadu_ps(a);
+    const __m128 column1 = _mm_loadu_ps(a + 4);
+    const __m128 column2 = _mm_loadu_ps(a + 8);
+    const __m128 column3 = _mm_loadu_ps(a + 12);
+    for (int c = 0; c < 4; ++c)
+    {
+        __m128 r = _mm_mul_ps(column0, _mm_set1_ps(b[c * 4]));
+        r = _mm_add_ps(r, _mm_mul_ps(column1, _mm_set1_ps(b[c * 4 + 1])));
+        r = _mm_add_ps(r, _mm_mul_ps(column2, _mm_set1_ps(b[c * 4 + 2])));
+        r = _mm_add_ps(r, _mm_mul_ps(column3, _mm_set1_ps(b[c * 4 + 3])));
+        _mm_storeu_ps(o + c * 4, r);
+    }
+#else
+    out = parent * local;
+#endif
+}
+
+// values[i] = values[order[i]], through a byte buffer shared by every field
+template<typename T>
+void Permute(std::vector<T>& values, const std::vector<uint32>& order, std::vector<uint8>& scratch)
+{
+    static_assert(std::is_trivially_copyable_v<T>, "Permute copies bytes");
+    scratch.resize(order.size() * sizeof(T));
+    for (size_t i = 0; i < order.size(); ++i)
+        std::memcpy(scratch.data() + i * sizeof(T), &values[order[i]], sizeof(T));
+    values.resize(order.size());
+    if (!values.empty())
+        std::memcpy(values.data(), scratch.data(), scratch.size());
+}
+
+} // namespace
+
+TransformSystem::TransformSystem()
+    : destroyedCount_(0)
+    , sortNeeded_(false)
+    , changedSinceUpdate_(false)
+{
+}
+
+uint32 TransformSystem::Create(Transform* owner)
+{
+    uint32 id;
+    if (!freeIds_.empty())
+    {
+        id = freeIds_.back();
+        freeIds_.pop_back();
+    }
+    else
+    {
+        id = static_cast<uint32>(slots_.size());
+        slots_.push_back(NoNode);
+    }
+
+    slots_[id] = static_cast<uint32>(ids_.size());
+    positions_.push_back(Vec3(0.0f));
+    rotations_.push_back(Quat(1.0f, 0.0f, 0.0f, 0.0f));
+    scales_.push_back(Vec3(1.0f));
+    parents_.push_back(NoNode);
+    worlds_.push_back(Mat4(1.0f));
+    versions_.push_back(0);
+    parentVersions_.push_back(0);
+    changed_.push_back(0);
+    childCounts_.push_back(0);
+    owners_.push_back(owner);
+    ids_.push_back(id);
+
+    // A root depends on nothing, it can follow the last depth until the next sort
+    return id;
+}
+
+void TransformSystem::Destroy(uint32 id)
+{
+    if (!IsValid(id))
+        return;
+
+    // The slot stays until the next sort, so children can still tell they lost their parent.
+    // A leaf leaves a hole nobody depends on, the order holds without a sort
+    const uint32 slot   = slots_[id];
+    const uint32 parent = ParentSlot(slot);
+    if (parent != NoNode)
+        --childCounts_[parent];
+    if (childCounts_[slot] > 0)
+        sortNeeded_ = true;
+
+    ids_[slot]    = NoNode;
+    owners_[slot] = nullptr;
+    slots_[id]    = NoNode;
+    freeIds_.push_back(id);
+
+    ++destroyedCount_;
+    NoteChange();
+}
+
+void TransformSystem::SetPosition(uint32 id, const Vec3& position)
+{
+    const uint32 slot = SlotOf(id);
+    positions_[slot]    = position;
+    changed_[slot]      = 1;
+    NoteChange();
+}
+
+void TransformSystem::SetRotation(uint32 id, const Quat& rotation)
+{
+    const uint32 slot = SlotOf(id);
+    rotations_[slot]    = rotation;
+    changed_[slot]      = 1;
+    NoteChange();
+}
+
+void TransformSystem::SetScale(uint32 id, const Vec3& scale)
+{
+    const uint32 slot = SlotOf(id);
+    scales_[slot]       = scale;
+    changed_[slot]      = 1;
+    NoteChange();
+}
+
+bool TransformSystem::SetParent(uint32 id, uint32 parent)
+{
+    const uint32 slot = SlotOf(id);
+    uint32 parentSlot = NoNode;
+    if (parent != NoNode)
+    {
+        if (!IsValid(parent))
+        {
+            std::cerr << "TransformSystem::SetParent: invalid parent node " << parent << std::endl;
+            return false;
+        }
+
+        parentSlot = slots_[parent];
+        for (uint32 ancestor = parentSlot; ancestor != NoNode; ancestor = ParentSlot(ancestor))
+        {
+            if (ancestor == slot)
+            {
+                std::cerr << "TransformSystem::SetParent: parent would create a cycle in the hierarchy" << std::endl;
+                return false;
+            }
+        }
+    }
+
+    const uint32 oldParentSlot = ParentSlot(slot);
+    if (oldParentSlot == parentSlot)
+        return true;
+
+    if (oldParentSlot != NoNode)
+        --childCounts_[oldParentSlot];
+    if (parentSlot != NoNode)
+        ++childCounts_[parentSlot];
+    parents_[slot]      = parentSlot;
+    changed_[slot]      = 1;
+    NoteChange();
+    sortNeeded_         = true;
+    return true;
+}
+
+uint32 TransformSystem::GetParent(uint32 id) const
+{
+    const uint32 parentSlot = ParentSlot(SlotOf(id));
+    return parentSlot == NoNode ? NoNode : ids_[parentSlot];
+}
+
+const Mat4& TransformSystem::GetWorldMatrix(uint32 id)
+{
+    const uint32 slot = SlotOf(id);
+    if (changedSinceUpdate_.load(std::memory_order_relaxed))
+        Resolve(slot);
+    return worlds_[slot];
+}
+
+bool TransformSystem::IsDirty(uint32 id) const
+{
+    for (uint32 slot = SlotOf(id); slot != NoNode; slot = ParentSlot(slot))
+    {
+        const uint32 parent = ParentSlot(slot);
+        if (changed_[slot] || parent != parents_[slot] || (parent != NoNode && parentVersions_[slot] != versions_[parent]))
+            return true;
+    }
+    return false;
+}
+
+void TransformSystem::Update(JobSystem* jobs)
+{
+    if (sortNeeded_ || destroyedCount_ * s_maxHoleShare > ids_.size())
+        Sort();
+
+    const size_t count = ids_.size();
+    if (!jobs || !jobs->IsInitialized() || count < 2 * s_minNodesPerJob)
+    {
+        Sweep(0, count);
+    }
+    else
+    {
+        // One depth at a time: ParallelFor returns once the whole level is done.
+        // Roots created since the sort follow the last depth, as one more level
+        auto sweepLevel = [this, jobs](size_t begin, size_t end) {
+            jobs->ParallelFor(end - begin, s_minNodesPerJob, [this, begin](size_t first, size_t last) {
+                Sweep(begin + first, begin + last);
+            });
+        };
+        for (size_t level = 0; level + 1 < levels_.size(); ++level)
+            sweepLevel(levels_[level], levels_[level + 1]);
+
+        const size_t sorted = levels_.empty() ? 0 : levels_.back();
+        if (sorted < count)
+            sweepLevel(sorted, count);
+    }
+
+    changedSinceUpdate_.store(false, std::memory_order_relaxed);
+}
+
+void TransformSystem::Reserve(size_t count)
+{
+    positions_.reserve(count);
+    rotations_.reserve(count);
+    scales_.reserve(count);
+    parents_.reserve(count);
+    worlds_.reserve(count);
+    versions_.reserve(count);
+    parentVersions_.reserve(count);
+    changed_.reserve(count);
+    childCounts_.reserve(count);
+    owners_.reserve(count);
+    ids_.reserve(count);
+    slots_.reserve(count);
+}
+
+size_t TransformSystem::GetCount() const
+{
+    return ids_.size() - destroyedCount_;
+}
+
+uint32 TransformSystem::GetDepthCount() const
+{
+    // Roots created since the last sort are depth 0, which may not have been there
+    if (levels_.empty())
+        return GetCount() > 0 ? 1 : 0;
+    return static_cast<uint32>(levels_.size() - 1);
+}
+
+Mat4 TransformSystem::ComposeMatrix(const Vec3& position, const Quat& rotation, const Vec3& scale)
+{
+    const float xx = rotation.x * rotation.x, yy = rotation.y * rotation.y, zz = rotation.z * rotation.z;
+    const float xy = rotation.x * rotation.y, xz = rotation.x * rotation.z, yz = rotation.y * rotation.z;
+    const float wx = rotation.w * rotation.x, wy = rotation.w * rotation.y, wz = rotation.w * rotation.z;
+
+    Mat4 m;
+    m[0] = Vec4((1.0f - 2.0f * (yy + zz)) * scale.x, 2.0f * (xy + wz) * scale.x, 2.0f * (xz - wy) * scale.x, 0.0f);
+    m[1] = Vec4(2.0f * (xy - wz) * scale.y, (1.0f - 2.0f * (xx + zz)) * scale.y, 2.0f * (yz + wx) * scale.y, 0.0f);
+    m[2] = Vec4(2.0f * (xz + wy) * scale.z, 2.0f * (yz - wx) * scale.z, (1.0f - 2.0f * (xx + yy)) * scale.z, 0.0f);
+    m[3] = Vec4(position.x, position.y, position.z, 1.0f);
+    return m;
+}
+
+uint32 TransformSystem::ParentSlot(uint32 slot) const
+{
+    const uint32 parent = parents_[slot];
+    return parent != NoNode && ids_[parent] != NoNode ? parent : NoNode;
+}
+
+void TransformSystem::Sweep(size_t begin, size_t end)
+{
+    // Parents come first, so theirs is final (and its version moved on) by the time a child is reached
+    for (size_t slot = begin; slot < end; ++slot)
+    {
+        if (ids_[slot] == NoNode)
+            continue;  // Hole of a destroyed leaf
+        const uint32 parent = parents_[slot];
+        if (changed_[slot] || (parent != NoNode && parentVersions_[slot] != versions_[parent]))
+            Recompute(static_cast<uint32>(slot), parent);
+    }
+}
+
+void TransformSystem::Resolve(uint32 slot)
+{
+    // From the root down, so only what changed since the last read or Update is recomputed
+    const uint32 parent = ParentSlot(slot);
+    if (parent != parents_[slot])
+    {
+        // The parent was destroyed, this is a root from now on
+        parents_[slot] = NoNode;
+        changed_[slot] = 1;
+    }
+    if (parent != NoNode)
+        Resolve(parent);
+
+    if (changed_[slot] || (parent != NoNode && parentVersions_[slot] != versions_[parent]))
+        Recompute(slot, parent);
+}
+
+void TransformSystem::Recompute(uint32 slot, uint32 parent)
+{
+    const Mat4 local = ComposeMatrix(positions_[slot], rotations_[slot], scales_[slot]);
+    if (parent != NoNode)
+    {
+        MultiplyMatrix(worlds_[parent], local, worlds_[slot]);
+        parentVersions_[slot] = versions_[parent];
+    }
+    else
+    {
+        worlds_[slot] = local;
+    }
+    ++versions_[slot];
+    changed_[slot] = 0;
+}
+
+void TransformSystem::Sort()
+{
+    const size_t count = ids_.size();
+
+    // Depth of every live node, walking up only as far as the first one already known
+    std::vector<uint32>& depths = sortScratch_.depths;
+    std::vector<uint32>& path   = sortScratch_.path;
+    depths.assign(count, NoNode);
+    uint32 maxDepth = 0;
+    for (uint32 slot = 0; slot < count; ++slot)
+    {
+        if (ids_[slot] == NoNode)
+            continue;
+
+        path.clear();
+        uint32 current = slot;
+        while (current != NoNode && depths[current] == NoNode)
+        {
+            path.push_back(current);
+            current = ParentSlot(current);
+        }
+
+        uint32 depth = current == NoNode ? 0 : depths[current] + 1;
+        for (size_t i = path.size(); i-- > 0; ++depth)
+            depths[path[i]] = depth;
+        maxDepth = std::max(maxDepth, depths[slot]);
+    }
+
+    // Stable counting sort by depth, destroyed slots dropped
+    std::vector<uint32>& offsets = sortScratch_.offsets;
+    offsets.assign(maxDepth + 2, 0);
+    for (uint32 slot = 0; slot < count; ++slot)
+    {
+        if (ids_[slot] != NoNode)
+            ++offsets[depths[slot] + 1];
+    }
+    for (size_t d = 1; d < offsets.size(); ++d)
+        offsets[d] += offsets[d - 1];
+    levels_ = offsets;
+
+    const size_t liveCount = count - destroyedCount_;
+    std::vector<uint32>& order    = sortScratch_.order;     // New slot to old slot
+    std::vector<uint32>& newSlots = sortScratch_.newSlots;
+    order.resize(liveCount);
+    newSlots.assign(count, NoNode);
+    for (uint32 slot = 0; slot < count; ++slot)
+    {
+        if (ids_[slot] == NoNode)
+            continue;
+        const uint32 newSlot = offsets[depths[slot]]++;
+        order[newSlot]  = slot;
+        newSlots[slot]  = newSlot;
+    }
+
+    // Orphans of destroyed parents are roots from now on, and have to say so in the next sweep
+    for (uint32 slot = 0; slot < count; ++slot)
+    {
+        if (ids_[slot] == NoNode)
+            continue;
+        const uint32 parent = ParentSlot(slot);
+        if (parent != parents_[slot])
+            changed_[slot] = 1;
+        parents_[slot] = parent == NoNode ? NoNode : newSlots[parent];
+    }
+
+    std::vector<uint8>& scratch = sortScratch_.values;
+    Permute(positions_, order, scratch);
+    Permute(rotations_, order, scratch);
+    Permute(scales_, order, scratch);
+    Permute(parents_, order, scratch);
+    Permute(worlds_, order, scratch);
+    Permute(versions_, order, scratch);
+    Permute(parentVersions_, order, scratch);
+    Permute(changed_, order, scratch);
+    Permute(childCounts_, order, scratch);
+    Permute(owners_, order, scratch);
+    Permute(ids_, order, scratch);
+
+    for (uint32 slot = 0; slot < liveCount; ++slot)
+        slots_[ids_[slot]] = slot;
+
+    if (liveCount == 0)
+        levels_.clear();
+    destroyedCount_ = 0;
+    sortNeeded_     = false;
+}
+
+} // namespace TLETC
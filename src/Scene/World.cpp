@@ -0,0 +1,320 @@
+#include "TLETC/Scene/World.h"
+
+#include <algorithm>
+#include <atomic>
+#include <iostream>
+
+namespace TLETC
+{
+
+namespace
+{
+
+constexpr std::align_val_t s_chunkAlignment{ 64 };
+
+size_t AlignUp(size_t value, size_t alignment)
+{
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+} // namespace
+
+// ============================================================================
+// Archetype
+// ============================================================================
+
+int World::Archetype::ColumnOf(uint32 type) const
+{
+    const auto it = std::lower_bound(types.begin(), types.end(), type);
+    return it != types.end() && *it == type ? static_cast<int>(it - types.begin()) : -1;
+}
+
+void* World::Archetype::At(size_t column, uint32 row) const
+{
+    const Column& c = columns[column];
+    return chunks[row / capacity].memory + c.offset + static_cast<size_t>(row % capacity) * c.info.size;
+}
+
+EntityID& World::Archetype::IdAt(uint32 row) const
+{
+    return reinterpret_cast<EntityID*>(chunks[row / capacity].memory)[row % capacity];
+}
+
+// ============================================================================
+// World
+// ============================================================================
+
+World::World()
+    : aliveCount_(0)
+{
+    FindOrCreateArchetype({});
+}
+
+World::~World()
+{
+    Clear();
+}
+
+uint32 World::NextType()
+{
+    static std::atomic<uint32> s_nextType{ 0 };
+    return s_nextType.fetch_add(1);
+}
+
+void World::ReportDeadEntity(const char* operation)
+{
+    std::cerr << "World::" << operation << ": entity is not alive" << std::endl;
+}
+
+EntityID World::Create()
+{
+    const EntityID entity = NewEntity();
+    AllocateRow(0, entity);
+    return entity;
+}
+
+void World::Destroy(EntityID entity)
+{
+    if (!IsAlive(entity))
+        return;
+
+    Location& location = locations_[entity.index];
+    FreeRow(location.archetype, location.row, true);
+
+    location.archetype = NoArchetype;
+    ++location.generation;
+    freeIndices_.push_back(entity.index);
+    --aliveCount_;
+}
+
+bool World::IsAlive(EntityID entity) const
+{
+    return entity.index < locations_.size()
+        && locations_[entity.index].archetype != NoArchetype
+        && locations_[entity.index].generation == entity.generation;
+}
+
+void World::Clear()
+{
+    for (Archetype& archetype : archetypes_)
+    {
+        for (uint32 row = 0; row < archetype.count; ++row)
+        {
+            for (size_t c = 0; c < archetype.columns.size(); ++c)
+                archetype.columns[c].info.destroy(archetype.At(c, row));
+        }
+        for (Chunk& chunk : archetype.chunks)
+            ::operator delete(chunk.memory, s_chunkAlignment);
+        archetype.chunks.clear();
+        archetype.count = 0;
+    }
+
+    for (uint32 index = 0; index < locations_.size(); ++index)
+    {
+        Location& location = locations_[index];
+        if (location.archetype == NoArchetype)
+            continue;
+
+        location.archetype = NoArchetype;
+        ++location.generation;
+        freeIndices_.push_back(index);
+    }
+    aliveCount_ = 0;
+}
+
+size_t World::GetChunkCount() const
+{
+    size_t count = 0;
+    for (const Archetype& archetype : archetypes_)
+        count += archetype.chunks.size();
+    return count;
+}
+
+EntityID World::NewEntity()
+{
+    EntityID entity;
+    if (freeIndices_.empty())
+    {
+        entity.index = static_cast<uint32>(locations_.size());
+        locations_.push_back({ NoArchetype, 0, 0 });
+    }
+    else
+    {
+        entity.index = freeIndices_.back();
+        freeIndices_.pop_back();
+    }
+    entity.generation = locations_[entity.index].generation;
+    ++aliveCount_;
+    return entity;
+}
+
+uint32 World::FindOrCreateArchetype(std::vector<ComponentInfo> infos)
+{
+    std::sort(infos.begin(), infos.end(), [](const ComponentInfo& a, const ComponentInfo& b) { return a.type < b.type; });
+    infos.erase(std::unique(infos.begin(), infos.end(), [](const ComponentInfo& a, const ComponentInfo& b) { return a.type == b.type; }), infos.end());
+
+    std::vector<uint32> types;
+    types.reserve(infos.size());
+    for (const ComponentInfo& info : infos)
+        types.push_back(info.type);
+
+    const auto found = archetypeLookup_.find(types);
+    if (found != archetypeLookup_.end())
+        return found->second;
+
+    Archetype archetype;
+    archetype.types = types;
+    archetype.count = 0;
+    for (const ComponentInfo& info : infos)
+        archetype.columns.push_back({ info, 0 });
+
+    // As many rows as fit in a chunk: the ids, then each column's array at its alignment
+    auto layout = [&](uint32 capacity) {
+        size_t offset = sizeof(EntityID) * capacity;
+        for (Column& column : archetype.columns)
+        {
+            offset        = AlignUp(offset, column.info.align);
+            column.offset = offset;
+            offset       += static_cast<size_t>(column.info.size) * capacity;
+        }
+        return offset;
+    };
+
+    size_t rowBytes = sizeof(EntityID);
+    for (const ComponentInfo& info : infos)
+        rowBytes += info.size;
+
+    archetype.capacity = std::max<uint32>(1, static_cast<uint32>(ChunkSize / rowBytes));
+    while (archetype.capacity > 1 && layout(archetype.capacity) > ChunkSize)
+        --archetype.capacity;
+    archetype.chunkBytes = AlignUp(std::max(ChunkSize, layout(archetype.capacity)), 64);
+
+    const uint32 index = static_cast<uint32>(archetypes_.size());
+    archetypes_.push_back(std::move(archetype));
+    archetypeLookup_.emplace(std::move(types), index);
+    return index;
+}
+
+uint32 World::AddType(uint32 archetype, const ComponentInfo& info)
+{
+    const auto edge = archetypes_[archetype].addEdges.find(info.type);
+    if (edge != archetypes_[archetype].addEdges.end())
+        return edge->second;
+
+    std::vector<ComponentInfo> infos;
+    for (const Column& column : archetypes_[archetype].columns)
+        infos.push_back(column.info);
+    infos.push_back(info);
+
+    const uint32 target = FindOrCreateArchetype(std::move(infos));
+    archetypes_[archetype].addEdges[info.type] = target;
+    archetypes_[target].removeEdges[info.type] = archetype;
+    return target;
+}
+
+uint32 World::RemoveType(uint32 archetype, uint32 type)
+{
+    const auto edge = archetypes_[archetype].removeEdges.find(type);
+    if (edge != archetypes_[archetype].removeEdges.end())
+        return edge->second;
+
+    std::vector<ComponentInfo> infos;
+    for (const Column& column : archetypes_[archetype].columns)
+    {
+        if (column.info.type != type)
+            infos.push_back(column.info);
+    }
+
+    const uint32 target = FindOrCreateArchetype(std::move(infos));
+    archetypes_[archetype].removeEdges[type] = target;
+    archetypes_[target].addEdges[type]       = archetype;
+    return target;
+}
+
+void World::AllocateRow(uint32 archetype, EntityID entity)
+{
+    Archetype& target = archetypes_[archetype];
+    if (target.chunks.empty() || target.chunks.back().count == target.capacity)
+        target.chunks.push_back({ static_cast<unsigned char*>(::operator new(target.chunkBytes, s_chunkAlignment)), 0 });
+
+    const uint32 row = target.count++;
+    ++target.chunks.back().count;
+    new (&target.IdAt(row)) EntityID(entity);
+
+    locations_[entity.index] = { archetype, row, entity.generation };
+}
+
+void World::FreeRow(uint32 archetype, uint32 row, bool destroyComponents)
+{
+    Archetype& source = archetypes_[archetype];
+    if (destroyComponents)
+    {
+        for (size_t c = 0; c < source.columns.size(); ++c)
+            source.columns[c].info.destroy(source.At(c, row));
+    }
+
+    // Swap and pop: the last row fills the gap
+    const uint32 last = source.count - 1;
+    if (row != last)
+    {
+        for (size_t c = 0; c < source.columns.size(); ++c)
+            source.columns[c].info.relocate(source.At(c, row), source.At(c, last));
+
+        const EntityID moved = source.IdAt(last);
+        source.IdAt(row) = moved;
+        locations_[moved.index].row = row;
+    }
+
+    --source.count;
+    if (--source.chunks.back().count == 0)
+    {
+        ::operator delete(source.chunks.back().memory, s_chunkAlignment);
+        source.chunks.pop_back();
+    }
+}
+
+void World::Move(EntityID entity, uint32 archetype)
+{
+    const Location from = locations_[entity.index];
+    if (from.archetype == archetype)
+        return;
+
+    AllocateRow(archetype, entity);
+    const Archetype& source = archetypes_[from.archetype];
+    const Archetype& target = archetypes_[archetype];
+    const uint32     row    = locations_[entity.index].row;
+
+    // Carry over what the new set keeps, drop the rest
+    for (size_t c = 0; c < source.columns.size(); ++c)
+    {
+        const int column = target.ColumnOf(source.types[c]);
+        if (column >= 0)
+            source.columns[c].info.relocate(target.At(column, row), source.At(c, from.row));
+        else
+            source.columns[c].info.destroy(source.At(c, from.row));
+    }
+    FreeRow(from.archetype, from.row, false);
+}
+
+void* World::Locate(EntityID entity, uint32 type) const
+{
+    if (!IsAlive(entity))
+        return nullptr;
+
+    const Location&  location  = locations_[entity.index];
+    const Archetype& archetype = archetypes_[location.archetype];
+    const int        column    = archetype.ColumnOf(type);
+    return column >= 0 ? archetype.At(column, location.row) : nullptr;
+}
+
+bool World::Matches(const Archetype& archetype, const uint32* types, size_t count) const
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (archetype.ColumnOf(types[i]) < 0)
+            return false;
+    }
+    return true;
+}
+
+} // namespace TLETC
@@ -0,0 +1,322 @@
+#include <catch2/catch_test_macros.hpp>
+#include "TLETC/Core/Application.h"
+
+#include <algorithm>
+#include <functional>
+#include <utility>
+#include <vector>
+
+using namespace TLETC;
+
+// Runs the frame's phases by hand, no window needed
+class TestApp : public Application {
+public:
+    TestApp() { SetParallelUpdatesEnabled(false); }
+
+    using Application::ProcessDestroyQueue;
+    using Application::EarlyUpdate;
+    using Application::Update;
+    using Application::LateUpdate;
+    using Application::PreRender;
+    using Application::PostRender;
+    using Application::RunBehaviourEvent;
+    using Application::SyncSceneBVH;
+};
+
+class Ticker : public Behaviour {
+public:
+    Ticker(int& ticks, uint16 order = 0) : ticks_(ticks) {
+        SetActiveEvents(EventFlag::Update | EventFlag::PostRender);
+        SetExecutionOrder(order);
+    }
+
+    void OnUpdate(float) override { ++ticks_; order.push_back(GetExecutionOrder()); }
+
+    static inline std::vector<uint16> order;
+
+private:
+    int& ticks_;
+};
+
+// Logs every callback it gets as the event and its own id
+class Recorder : public Behaviour {
+public:
+    using Log = std::vector<std::pair<uint32, int>>;
+
+    Recorder(Log& log, int id, uint16 order) : log_(log), id_(id) {
+        SetActiveEvents(AllUpdate | AllRender | AllInput);
+        SetExecutionOrder(order);
+    }
+
+    void OnEarlyUpdate(float) override                   { log_.emplace_back(EarlyUpdate, id_); }
+    void OnUpdate(float) override                        { log_.emplace_back(Update, id_); }
+    void OnLateUpdate(float) override                    { log_.emplace_back(LateUpdate, id_); }
+    void OnPreRender() override                          { log_.emplace_back(PreRender, id_); }
+    void OnRender() override                             { log_.emplace_back(Render, id_); }
+    void OnPostRender() override                         { log_.emplace_back(PostRender, id_); }
+    void OnKeyPressed(KeyCode) override                  { log_.emplace_back(KeyEvents, id_); }
+    void OnMouseButtonPressed(MouseButton) override      { log_.emplace_back(MouseButtonEvents, id_); }
+    void OnMouseMoved(const Vec2&, const Vec2&) override { log_.emplace_back(MouseMoveEvents, id_); }
+    void OnMouseScrolled(const Vec2&) override           { log_.emplace_back(MouseScrollEvents, id_); }
+
+private:
+    Log& log_;
+    int  id_;
+};
+
+// Takes every Remover off its entity, itself included, from inside its update
+class Remover : public Behaviour {
+public:
+    Remover() { ++alive; SetActiveEvents(EventFlag::Update); }
+    ~Remover() override { --alive; }
+
+    void OnUpdate(float) override {
+        ++updates;
+        for (Remover* remover : GetEntity()->GetBehaviours<Remover>())
+            GetEntity()->RemoveBehaviour(remover);
+    }
+
+    static inline int alive   = 0;
+    static inline int updates = 0;
+};
+
+TEST_CASE("Application entity handles", "[core][application]") {
+    TestApp app;
+
+    Entity* first = app.CreateEntity("First");
+    const EntityHandle handle = first->GetHandle();
+    REQUIRE(handle.IsValid());
+    REQUIRE(app.GetEntity(handle) == first);
+
+    SECTION("Destruction waits for the end of the frame") {
+        app.DestroyEntity(handle);
+        REQUIRE(app.IsAlive(handle));
+        app.ProcessDestroyQueue();
+        REQUIRE_FALSE(app.IsAlive(handle));
+        REQUIRE(app.GetEntities().empty());
+    }
+
+    SECTION("A reused slot doesn't bring old handles back") {
+        app.DestroyEntity(first);
+        app.DestroyEntity(handle);  // Queued twice, destroyed once
+        app.ProcessDestroyQueue();
+
+        Entity* second = app.CreateEntity("Second");
+        REQUIRE(second->GetHandle().index == handle.index);
+        REQUIRE(app.GetEntity(handle) == nullptr);
+        REQUIRE(app.GetEntity(second->GetHandle()) == second);
+
+        app.DestroyEntity(handle);  // Stale, no-op
+        app.ProcessDestroyQueue();
+        REQUIRE(app.GetEntities().size() == 1);
+    }
+
+    SECTION("Entities of others are refused") {
+        Entity loose(app.GetTransformSystem());
+        app.DestroyEntity(&loose);
+        app.DestroyEntity(EntityHandle());
+        app.ProcessDestroyQueue();
+        REQUIRE(app.GetEntities().size() == 1);
+    }
+}
+
+TEST_CASE("Application destroys entities in bulk", "[core][application]") {
+    constexpr int EntityCount = 10000;
+    TestApp app;
+    int ticks = 0;
+
+    std::vector<EntityHandle> handles;
+    for (int i = 0; i < EntityCount; ++i) {
+        Entity* entity = app.CreateEntity();
+        entity->AddBehaviour<Ticker>(ticks, static_cast<uint16>(i % 3));
+        handles.push_back(entity->GetHandle());
+    }
+
+    // Every other one goes, the survivors keep their handles and their updates
+    for (int i = 0; i < EntityCount; i += 2)
+        app.DestroyEntity(handles[i]);
+    app.ProcessDestroyQueue();
+    REQUIRE(app.GetEntities().size() == EntityCount / 2);
+
+    size_t wrong = 0;
+    for (int i = 0; i < EntityCount; ++i) {
+        Entity* entity = app.GetEntity(handles[i]);
+        wrong += i % 2 == 0 ? entity != nullptr : entity == nullptr || entity->GetHandle() != handles[i];
+    }
+    REQUIRE(wrong == 0);
+
+    Ticker::order.clear();
+    app.Update();
+    app.PostRender();
+    REQUIRE(ticks == EntityCount / 2);
+    REQUIRE(std::is_sorted(Ticker::order.begin(), Ticker::order.end()));
+
+    SECTION("Removing a behaviour takes it out of the updates") {
+        Entity* entity = app.GetEntity(handles[1]);
+        entity->RemoveBehaviour(entity->GetBehaviour<Ticker>());
+        app.Update();
+        REQUIRE(ticks == EntityCount - 1);
+    }
+
+    SECTION("Everything can go") {
+        for (EntityHandle handle : handles)
+            app.DestroyEntity(handle);
+        app.ProcessDestroyQueue();
+        REQUIRE(app.GetEntities().empty());
+        app.Update();
+        REQUIRE(ticks == EntityCount / 2);
+    }
+}
+
+TEST_CASE("Application frees removed behaviours at the end of the frame", "[core][application]") {
+    TestApp app;
+    Remover::alive   = 0;
+    Remover::updates = 0;
+
+    Entity* entity = app.CreateEntity();
+    for (int i = 0; i < 3; ++i)
+        entity->AddBehaviour<Remover>();
+    app.Update();
+
+    // The first one ran and removed them all, the rest of the update skipped them
+    REQUIRE(Remover::updates == 1);
+    REQUIRE(entity->GetBehaviour<Remover>() == nullptr);
+    REQUIRE(Remover::alive == 3);
+
+    app.ProcessDestroyQueue();
+    REQUIRE(Remover::alive == 0);
+    app.Update();
+    REQUIRE(Remover::updates == 1);
+}
+
+TEST_CASE("Application runs every event in execution order", "[core][application]") {
+    TestApp app;
+    Recorder::Log log;
+
+    // Render and input have no device or window to come from here, so those go straight
+    // through the dispatch, the rest through their phase
+    const std::pair<Behaviour::EventFlag, std::function<void()>> events[] = {
+        { Behaviour::EarlyUpdate,       [&] { app.EarlyUpdate(); } },
+        { Behaviour::Update,            [&] { app.Update(); } },
+        { Behaviour::LateUpdate,        [&] { app.LateUpdate(); } },
+        { Behaviour::PreRender,         [&] { app.PreRender(); } },
+        { Behaviour::Render,            [&] { app.RunBehaviourEvent<Behaviour::Render>([](Behaviour* b) { b->OnRender(); }); } },
+        { Behaviour::PostRender,        [&] { app.PostRender(); } },
+        { Behaviour::KeyEvents,         [&] { app.RunBehaviourEvent<Behaviour::KeyEvents>([](Behaviour* b) { b->OnKeyPressed(KeyCode::A); }); } },
+        { Behaviour::MouseButtonEvents, [&] { app.RunBehaviourEvent<Behaviour::MouseButtonEvents>([](Behaviour* b) { b->OnMouseButtonPressed(MouseButton::Left); }); } },
+        { Behaviour::MouseMoveEvents,   [&] { app.RunBehaviourEvent<Behaviour::MouseMoveEvents>([](Behaviour* b) { b->OnMouseMoved(Vec2(1.0f), Vec2(1.0f)); }); } },
+        { Behaviour::MouseScrollEvents, [&] { app.RunBehaviourEvent<Behaviour::MouseScrollEvents>([](Behaviour* b) { b->OnMouseScrolled(Vec2(1.0f)); }); } },
+    };
+
+    const uint16 orders[] = { 2, 0, 1, 0, 1 };
+    std::vector<Recorder*> recorders;
+    for (int id = 0; id < 5; ++id)
+        recorders.push_back(app.CreateEntity()->AddBehaviour<Recorder>(log, id, orders[id]));
+    recorders[4]->SetEnabled(false);
+
+    // Lowest order first, ties in the order they were added, the disabled one left out
+    const std::vector<int> expected = { 1, 3, 2, 0 };
+    auto ran = [&](Behaviour::EventFlag event) {
+        std::vector<int> ids;
+        for (const auto& [logged, id] : log) {
+            REQUIRE(logged == event);
+            ids.push_back(id);
+        }
+        log.clear();
+        return ids;
+    };
+
+    SECTION("Every event runs its behaviours in order") {
+        for (const auto& [event, run] : events) {
+            run();
+            REQUIRE(ran(event) == expected);
+        }
+    }
+
+    SECTION("Pausing stops updates and input, rendering goes on") {
+        app.SetEventsEnabled(false);
+        for (const auto& [event, run] : events) {
+            run();
+            const bool pausable = (event & (Behaviour::AllUpdate | Behaviour::AllInput)) != 0;
+            REQUIRE(ran(event) == (pausable ? std::vector<int>() : expected));
+        }
+
+        app.SetEventsEnabled(true);
+        for (const auto& [event, run] : events) {
+            run();
+            REQUIRE(ran(event) == expected);
+        }
+    }
+
+    SECTION("Enabling again puts a behaviour back in its place") {
+        recorders[4]->SetEnabled(true);
+        recorders[1]->SetEnabled(false);
+        for (const auto& [event, run] : events) {
+            run();
+            REQUIRE(ran(event) == std::vector<int>{ 3, 2, 4, 0 });
+        }
+    }
+}
+
+TEST_CASE("Application keeps the scene BVH in step with transforms and meshes", "[core][application]") {
+    TestApp app;
+    Mesh mesh;
+    mesh.AddVertex(Vec3(-1.0f));
+    mesh.AddVertex(Vec3(1.0f));
+
+    // Only the child has a mesh, it moves with its parent
+    Entity* parent = app.CreateEntity("Parent");
+    Entity* child  = app.CreateEntity("Child");
+    child->mesh = &mesh;
+    REQUIRE(child->transform.SetParent(&parent->transform));
+
+    auto found = [&](const Vec3& at) {
+        app.SyncSceneBVH();
+        std::vector<Entity*> results;
+        app.GetSceneBVH().QueryOverlap(BoundingBox(at - Vec3(0.1f), at + Vec3(0.1f)), results);
+        return results.size() == 1 && results[0] == child;
+    };
+    REQUIRE(found(Vec3(0.0f)));
+    REQUIRE(app.GetSceneBVH().GetEntityCount() == 1);
+
+    SECTION("Moving a parent moves the child's bounds, updated or not") {
+        parent->transform.SetPosition(Vec3(10.0f, 0.0f, 0.0f));
+        app.GetTransformSystem().Update();
+        REQUIRE_FALSE(found(Vec3(0.0f)));
+        REQUIRE(found(Vec3(10.0f, 0.0f, 0.0f)));
+
+        parent->transform.SetPosition(Vec3(20.0f, 0.0f, 0.0f));
+        REQUIRE(found(Vec3(20.0f, 0.0f, 0.0f)));
+    }
+
+    SECTION("Editing the mesh or swapping it changes the bounds") {
+        mesh.SetVertexPosition(1, Vec3(5.0f));
+        REQUIRE(found(Vec3(4.0f)));
+
+        Mesh small;
+        small.AddVertex(Vec3(-0.5f));
+        small.AddVertex(Vec3(0.5f));
+        child->mesh = &small;
+        REQUIRE_FALSE(found(Vec3(4.0f)));
+        REQUIRE(found(Vec3(0.0f)));
+        child->mesh = &mesh;
+    }
+
+    SECTION("Disabled and destroyed entities leave the tree") {
+        child->SetEnabled(false);
+        REQUIRE_FALSE(found(Vec3(0.0f)));
+        child->SetEnabled(true);
+        REQUIRE(found(Vec3(0.0f)));
+
+        app.DestroyEntity(child);
+        app.ProcessDestroyQueue();
+        app.SyncSceneBVH();
+        REQUIRE(app.GetSceneBVH().GetEntityCount() == 0);
+
+        // A new entity in the freed slot goes in afresh
+        Entity* again = app.CreateEntity("Again");
+        again->mesh = &mesh;
+        app.SyncSceneBVH();
+        REQUIRE(app.GetSceneBVH().GetEntityCount() == 1);
+    }
+}
@@ -0,0 +1,130 @@
+#include <catch2/catch_test_macros.hpp>
+#include "TLETC/Core/JobSystem.h"
+
+#include <array>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace TLETC;
+
+TEST_CASE("JobSystem without workers", "[core][jobs]") {
+    JobSystem jobs;
+    REQUIRE_FALSE(jobs.IsInitialized());
+    REQUIRE(jobs.GetThreadCount() == 1);
+
+    SECTION("Jobs run on the caller right away") {
+        int value = 0;
+        JobCounter done;
+        jobs.Run([&]() { value = 1; }, &done);
+        REQUIRE(value == 1);
+        REQUIRE(done.IsDone());
+    }
+
+    SECTION("ParallelFor covers the range once") {
+        std::vector<int> visits(1000, 0);
+        jobs.ParallelFor(visits.size(), 1, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i)
+                ++visits[i];
+        });
+        for (int v : visits)
+            REQUIRE(v == 1);
+    }
+}
+
+TEST_CASE("JobSystem with workers", "[core][jobs]") {
+    JobSystem jobs;
+    REQUIRE(jobs.Initialize(3));
+    REQUIRE(jobs.GetWorkerCount() == 3);
+
+    SECTION("Every job runs exactly once") {
+        std::atomic<int> runs{0};
+        JobCounter done;
+        for (int i = 0; i < 20000; ++i)  // More than one deque holds
+            jobs.Run([&]() { runs.fetch_add(1); }, &done);
+        jobs.Wait(done);
+        REQUIRE(runs.load() == 20000);
+        REQUIRE(done.GetPending() == 0);
+    }
+
+    SECTION("ParallelFor covers the range once, whatever the grain") {
+        for (size_t grain : { size_t(1), size_t(7), size_t(1000), size_t(100000) }) {
+            std::vector<std::atomic<int>> visits(50000);
+            std::atomic<int> smallChunks{0};
+            jobs.ParallelFor(visits.size(), grain, [&](size_t begin, size_t end) {
+                if (end - begin < grain && end != visits.size())
+                    smallChunks.fetch_add(1);
+                for (size_t i = begin; i < end; ++i)
+                    visits[i].fetch_add(1, std::memory_order_relaxed);
+            });
+            size_t wrong = 0;
+            for (auto& v : visits)
+                wrong += v.load() != 1;
+            REQUIRE(wrong == 0);
+            REQUIRE(smallChunks.load() == 0);
+        }
+    }
+
+    SECTION("Dependent jobs start after everything they depend on") {
+        for (int round = 0; round < 50; ++round) {
+            std::atomic<int> first{0};
+            std::atomic<int> seenBySecond{-1};
+            std::atomic<int> seenByThird{-1};
+            JobCounter stageOne, stageTwo, stageThree;
+
+            for (int i = 0; i < 16; ++i) {
+                jobs.Run([&]() {
+                    std::this_thread::yield();
+                    first.fetch_add(1);
+                }, &stageOne);
+            }
+            jobs.Run([&]() { seenBySecond = first.load(); }, &stageTwo, &stageOne);
+            jobs.Run([&]() { seenByThird = seenBySecond.load(); }, &stageThree, &stageTwo);
+
+            jobs.Wait(stageThree);
+            REQUIRE(seenBySecond.load() == 16);
+            REQUIRE(seenByThird.load() == 16);
+        }
+    }
+
+    SECTION("Jobs can start and wait for jobs of their own") {
+        std::atomic<int> leaves{0};
+        JobCounter done;
+        for (int i = 0; i < 8; ++i) {
+            jobs.Run([&]() {
+                JobCounter inner;
+                for (int j = 0; j < 64; ++j)
+                    jobs.Run([&]() { leaves.fetch_add(1); }, &inner);
+                jobs.Wait(inner);
+            }, &done);
+        }
+        jobs.Wait(done);
+        REQUIRE(leaves.load() == 8 * 64);
+    }
+
+    SECTION("Other threads and large captures work too") {
+        std::array<int, 64> payload{};
+        payload[63] = 5;
+        std::atomic<int> sum{0};
+        JobCounter done;
+
+        std::thread outsider([&]() {
+            for (int i = 0; i < 100; ++i)
+                jobs.Run([&sum, payload]() { sum.fetch_add(payload[63]); }, &done);
+        });
+        outsider.join();
+        jobs.Wait(done);
+        REQUIRE(sum.load() == 500);
+    }
+
+    SECTION("Shutdown finishes what was queued") {
+        std::atomic<int> runs{0};
+        JobCounter done;
+        for (int i = 0; i < 1000; ++i)
+            jobs.Run([&]() { runs.fetch_add(1); }, &done);
+        jobs.Shutdown();
+        REQUIRE_FALSE(jobs.IsInitialized());
+        REQUIRE(runs.load() == 1000);
+        REQUIRE(done.IsDone());
+    }
+}
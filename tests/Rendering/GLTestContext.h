@@ -0,0 +1,41 @@
+#pragma once
+
+#include <glad/gl.h>
+#include <GLFW/glfw3.h>
+
+namespace TLETC
+{
+
+// An OpenGL 4.5 context on a hidden window, so the GL tests also run headless on a virtual
+// display (xvfb-run, llvmpipe). Tests skip when window is null, no context could be made
+struct GLTestContext
+{
+    GLFWwindow* window = nullptr;
+
+    GLTestContext()
+    {
+        if (!glfwInit()) return;
+        glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+        glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
+        glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 5);
+        glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+        window = glfwCreateWindow(64, 64, "TLETC tests", nullptr, nullptr);
+        if (!window) return;
+        glfwMakeContextCurrent(window);
+        if (!gladLoadGL(glfwGetProcAddress))
+        {
+            glfwDestroyWindow(window);
+            window = nullptr;
+        }
+    }
+    ~GLTestContext()
+    {
+        if (window) glfwDestroyWindow(window);
+        glfwTerminate();
+    }
+
+    GLTestContext(const GLTestContext&) = delete;
+    GLTestContext& operator=(const GLTestContext&) = delete;
+};
+
+} // namespace TLETC
@@ -0,0 +1,35 @@
+#include <catch2/catch_test_macros.hpp>
+#include "../../src/Platform/OpenGL/GLGeometryPool.h"
+#include "GLTestContext.h"
+
+#include <vector>
+
+using namespace TLETC;
+
+TEST_CASE("GLGeometryPool leaves other GL errors alone", "[rendering][geometrypool]") {
+    GLTestContext context;
+    if (!context.window)
+        SKIP("No OpenGL 4.5 context available");
+    while (glGetError() != GL_NO_ERROR) {}
+
+    // An unrelated error is pending through every buffer the pool makes
+    glEnable(GL_TRUE);
+    GLGeometryPool pool;
+    REQUIRE(pool.Create(12, sizeof(uint32), 4, 6));
+
+    std::vector<GLGeometryPool::Range> ranges(3);
+    for (GLGeometryPool::Range& range : ranges)
+        REQUIRE(pool.Allocate(64, 96, range));
+    REQUIRE(pool.GetVertexCapacity() >= 3 * 64);
+    REQUIRE(pool.GetIndexCapacity() >= 3 * 96);
+
+    pool.Free(ranges[0]);
+    pool.Free(ranges[1]);
+    GLGeometryPool::Range* live[] = { &ranges[2] };
+    REQUIRE(pool.Repack(live));
+    REQUIRE(ranges[2].firstVertex == 0);
+
+    REQUIRE(glGetError() == GL_INVALID_ENUM);
+    REQUIRE(glGetError() == GL_NO_ERROR);
+    pool.Destroy();
+}
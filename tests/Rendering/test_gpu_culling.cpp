@@ -0,0 +1,141 @@
+#include <catch2/catch_test_macros.hpp>
+#include "../../src/Platform/OpenGL/GLRenderDevice.h"
+#include "TLETC/Resources/Mesh.h"
+#include "GLTestContext.h"
+
+#include <cmath>
+#include <vector>
+
+using namespace TLETC;
+
+// Needs an OpenGL 4.5 context, skipped when none can be made
+namespace {
+
+// Every instance that reaches the vertex stage writes the ID hidden in its model matrix
+// (the bottom row, which culling ignores) at its instance index, so the order survives
+const char* s_recordVertexSource = R"(#version 450 core
+layout(location = 0) in vec3 a_position;
+layout(location = 8) in uint a_objectIndex;
+
+struct ObjectData { mat4 model; mat4 normal; };
+layout(std430, binding = 0) readonly buffer Objects { ObjectData u_objects[]; };
+layout(std430, binding = 7) buffer Drawn { uint u_count; uint u_ids[]; };
+
+void main() {
+    if (gl_VertexID == 0) {
+        atomicAdd(u_count, 1u);
+        u_ids[gl_InstanceID] = uint(u_objects[a_objectIndex].model[0][3]);
+    }
+    gl_Position = vec4(a_position, 1.0);
+}
+)";
+
+const char* s_recordFragmentSource = R"(#version 450 core
+out vec4 o_color;
+void main() { o_color = vec4(1.0); }
+)";
+
+constexpr uint32 s_drawnBinding = 7;
+constexpr uint32 s_objectCount  = 150;  // More than one work group of the cull shader
+
+// Inside the frustum unless the ID is a multiple of 3 - those go off to the side,
+// behind the camera or past the far plane
+Mat4 MakeObject(uint32 id)
+{
+    Vec3 position(static_cast<float>(id % 10) * 0.5f - 2.5f, static_cast<float>(id % 7) * 0.5f - 1.5f, 0.0f);
+    if (id % 3 == 0)
+        position = id % 9 == 0 ? Vec3(100.0f, 0.0f, 0.0f) : id % 9 == 3 ? Vec3(0.0f, 0.0f, 50.0f) : Vec3(0.0f, 0.0f, -500.0f);
+
+    Mat4 model = glm::translate(Mat4(1.0f), position);
+    model[0][3] = static_cast<float>(id);
+    return model;
+}
+
+std::vector<uint32> DrawAndRecord(GLRenderDevice& device, const Mesh& mesh, const std::vector<Mat4>& transforms, uint32 drawnBuffer)
+{
+    const std::vector<uint32> zeros(transforms.size() + 1, 0);
+    glNamedBufferSubData(drawnBuffer, 0, zeros.size() * sizeof(uint32), zeros.data());
+
+    device.BeginFrame();
+    device.SetFrameData(glm::lookAt(Vec3(0.0f, 0.0f, 10.0f), Vec3(0.0f), Vec3(0.0f, 1.0f, 0.0f)),
+                        glm::perspective(glm::radians(60.0f), 1.0f, 0.1f, 100.0f), 0.0f);
+    const MeshBatch batch = { &mesh, transforms };
+    device.DrawMeshBatch(std::span<const MeshBatch>(&batch, 1), PrimitiveType::Points);
+    device.EndFrame();
+
+    std::vector<uint32> drawn(zeros.size());
+    glMemoryBarrier(GL_BUFFER_UPDATE_BARRIER_BIT);
+    glGetNamedBufferSubData(drawnBuffer, 0, drawn.size() * sizeof(uint32), drawn.data());
+    drawn.resize(drawn[0] + 1);
+    drawn.erase(drawn.begin());
+    return drawn;
+}
+
+} // namespace
+
+TEST_CASE("GPU culling draws exactly the visible instances, in order", "[rendering][gpuculling]") {
+    GLTestContext context;
+    if (!context.window)
+        SKIP("No OpenGL 4.5 context available");
+
+    GLRenderDevice device;
+    REQUIRE(device.Initialize());
+
+    // Two points one unit either side of the origin - a bounding sphere of radius 1
+    Mesh mesh;
+    mesh.AddVertex(Vec3(-1.0f, 0.0f, 0.0f));
+    mesh.AddVertex(Vec3(1.0f, 0.0f, 0.0f));
+
+    const ShaderHandle shader = device.CreateShaderProgram(device.CreateShader(ShaderType::Vertex, s_recordVertexSource),
+                                                           device.CreateShader(ShaderType::Fragment, s_recordFragmentSource));
+    REQUIRE(shader.IsValid());
+    device.UseShader(shader);
+    glEnable(GL_RASTERIZER_DISCARD);
+
+    uint32 drawnBuffer = 0;
+    glCreateBuffers(1, &drawnBuffer);
+    glNamedBufferStorage(drawnBuffer, (s_objectCount + 1) * sizeof(uint32), nullptr, GL_DYNAMIC_STORAGE_BIT);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, s_drawnBinding, drawnBuffer);
+
+    std::vector<Mat4> transforms;
+    std::vector<uint32> visible;
+    for (uint32 id = 0; id < s_objectCount; ++id)
+    {
+        transforms.push_back(MakeObject(id));
+        if (id % 3 != 0) visible.push_back(id);
+    }
+
+    SECTION("Without culling every instance is drawn") {
+        device.EnableGpuCulling(false);
+        const std::vector<uint32> drawn = DrawAndRecord(device, mesh, transforms, drawnBuffer);
+        REQUIRE(drawn.size() == s_objectCount);
+        for (uint32 id = 0; id < s_objectCount; ++id)
+            REQUIRE(drawn[id] == id);
+    }
+
+    SECTION("With culling the survivors keep their order") {
+        device.EnableGpuCulling(true);
+        REQUIRE(DrawAndRecord(device, mesh, transforms, drawnBuffer) == visible);
+
+        // Same again the next frame, from the next stream region
+        REQUIRE(DrawAndRecord(device, mesh, transforms, drawnBuffer) == visible);
+    }
+
+    SECTION("Spheres touching a plane are kept") {
+        device.EnableGpuCulling(true);
+
+        // Centers just outside the far plane (z = -90) and the right side, radius reaching in
+        const float halfWidth = 10.0f * std::tan(glm::radians(30.0f));
+        std::vector<Mat4> edges = { glm::translate(Mat4(1.0f), Vec3(0.0f, 0.0f, -90.5f)),
+                                    glm::translate(Mat4(1.0f), Vec3(halfWidth + 0.5f, 0.0f, 0.0f)),
+                                    glm::translate(Mat4(1.0f), Vec3(halfWidth + 2.0f, 0.0f, 0.0f)) };
+        for (uint32 id = 0; id < edges.size(); ++id)
+            edges[id][0][3] = static_cast<float>(id);
+        REQUIRE(DrawAndRecord(device, mesh, edges, drawnBuffer) == std::vector<uint32>{ 0, 1 });
+    }
+
+    glDeleteBuffers(1, &drawnBuffer);
+    glDisable(GL_RASTERIZER_DISCARD);
+    device.DestroyShader(shader);
+    device.Shutdown();
+}
@@ -0,0 +1,89 @@
+#include <catch2/catch_test_macros.hpp>
+#include "../../src/Platform/OpenGL/GLRenderDevice.h"
+#include "TLETC/Resources/Mesh.h"
+#include "GLTestContext.h"
+
+using namespace TLETC;
+
+namespace {
+
+// Decodes quantized positions the way assets/shaders/basic_compact.vert does
+const char* s_decodeVertexSource = R"(#version 450 core
+layout(location = 0) in vec3 a_position;
+uniform vec3 u_positionScale;
+uniform vec3 u_positionOffset;
+void main() { gl_Position = vec4(u_positionOffset + a_position * u_positionScale, 1.0); }
+)";
+
+const char* s_plainVertexSource = R"(#version 450 core
+layout(location = 0) in vec3 a_position;
+void main() { gl_Position = vec4(a_position, 1.0); }
+)";
+
+const char* s_fragmentSource = R"(#version 450 core
+out vec4 o_color;
+void main() { o_color = vec4(1.0); }
+)";
+
+Vec3 ReadVec3(ShaderHandle shader, const char* name)
+{
+    Vec3 value(-1.0f);
+    glGetUniformfv(shader.GetID(), glGetUniformLocation(shader.GetID(), name), &value.x);
+    return value;
+}
+
+} // namespace
+
+TEST_CASE("Dequantization uniforms follow the mesh drawn", "[rendering][meshuniforms]") {
+    GLTestContext context;
+    if (!context.window)
+        SKIP("No OpenGL 4.5 context available");
+
+    GLRenderDevice device;
+    REQUIRE(device.Initialize());
+    glEnable(GL_RASTERIZER_DISCARD);
+
+    Mesh floats, quantized;
+    for (Mesh* mesh : { &floats, &quantized }) {
+        mesh->AddVertex(Vec3(-1.0f, 2.0f, 0.0f));
+        mesh->AddVertex(Vec3(3.0f, 4.0f, 6.0f));
+    }
+    quantized.SetVertexCompression(VertexCompression::QuantizedPositions);
+
+    const ShaderHandle decode = device.CreateShaderProgram(device.CreateShader(ShaderType::Vertex, s_decodeVertexSource),
+                                                           device.CreateShader(ShaderType::Fragment, s_fragmentSource));
+    const ShaderHandle plain  = device.CreateShaderProgram(device.CreateShader(ShaderType::Vertex, s_plainVertexSource),
+                                                           device.CreateShader(ShaderType::Fragment, s_fragmentSource));
+    REQUIRE(decode.IsValid());
+    REQUIRE(plain.IsValid());
+
+    device.BeginFrame();
+    device.UseShader(decode);
+    device.DrawMesh(quantized, Mat4(1.0f), PrimitiveType::Points);
+    REQUIRE(ReadVec3(decode, "u_positionScale") == Vec3(4.0f, 2.0f, 6.0f));
+    REQUIRE(ReadVec3(decode, "u_positionOffset") == Vec3(-1.0f, 2.0f, 0.0f));
+
+    // Back to identity for float positions, and it stays there
+    device.DrawMesh(floats, Mat4(1.0f), PrimitiveType::Points);
+    device.DrawMesh(floats, Mat4(1.0f), PrimitiveType::Points);
+    REQUIRE(ReadVec3(decode, "u_positionScale") == Vec3(1.0f));
+    REQUIRE(ReadVec3(decode, "u_positionOffset") == Vec3(0.0f));
+
+    // Shaders without them draw either mesh without errors
+    while (glGetError() != GL_NO_ERROR) {}
+    device.UseShader(plain);
+    device.DrawMesh(quantized, Mat4(1.0f), PrimitiveType::Points);
+    device.DrawMesh(floats, Mat4(1.0f), PrimitiveType::Points);
+    REQUIRE(glGetError() == GL_NO_ERROR);
+
+    // The decoding program kept its values across the switch
+    device.UseShader(decode);
+    device.DrawMesh(quantized, Mat4(1.0f), PrimitiveType::Points);
+    REQUIRE(ReadVec3(decode, "u_positionScale") == Vec3(4.0f, 2.0f, 6.0f));
+    device.EndFrame();
+
+    glDisable(GL_RASTERIZER_DISCARD);
+    device.DestroyShader(decode);
+    device.DestroyShader(plain);
+    device.Shutdown();
+}
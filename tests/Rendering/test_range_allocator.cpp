@@ -0,0 +1,80 @@
+#include <catch2/catch_test_macros.hpp>
+#include "TLETC/Rendering/RangeAllocator.h"
+
+using TLETC::RangeAllocator;
+
+TEST_CASE("RangeAllocator allocation", "[rendering][rangeallocator]") {
+    RangeAllocator allocator(100);
+    size_t a = 0, b = 0, c = 0;
+
+    SECTION("Allocations are packed from the start") {
+        REQUIRE(allocator.Allocate(10, a));
+        REQUIRE(allocator.Allocate(20, b));
+        REQUIRE(a == 0);
+        REQUIRE(b == 10);
+        REQUIRE(allocator.GetUsed() == 30);
+        REQUIRE(allocator.GetLargestFree() == 70);
+    }
+
+    SECTION("Requests larger than any free range fail") {
+        REQUIRE(allocator.Allocate(60, a));
+        REQUIRE_FALSE(allocator.Allocate(50, b));
+        REQUIRE(allocator.GetUsed() == 60);
+    }
+
+    SECTION("Zero-sized allocations always succeed") {
+        RangeAllocator empty;
+        REQUIRE(empty.Allocate(0, a));
+        REQUIRE(a == 0);
+        REQUIRE(empty.GetUsed() == 0);
+    }
+
+    SECTION("Freed ranges are reused first fit") {
+        REQUIRE(allocator.Allocate(10, a));
+        REQUIRE(allocator.Allocate(10, b));
+        REQUIRE(allocator.Allocate(10, c));
+        allocator.Free(b, 10);
+
+        size_t d = 0;
+        REQUIRE(allocator.Allocate(5, d));
+        REQUIRE(d == b);
+    }
+}
+
+TEST_CASE("RangeAllocator coalescing and growth", "[rendering][rangeallocator]") {
+    RangeAllocator allocator(30);
+    size_t a = 0, b = 0, c = 0;
+    REQUIRE(allocator.Allocate(10, a));
+    REQUIRE(allocator.Allocate(10, b));
+    REQUIRE(allocator.Allocate(10, c));
+
+    SECTION("Neighbouring free ranges merge") {
+        allocator.Free(a, 10);
+        allocator.Free(c, 10);
+        REQUIRE(allocator.GetFreeRangeCount() == 2);
+
+        allocator.Free(b, 10);
+        REQUIRE(allocator.GetFreeRangeCount() == 1);
+        REQUIRE(allocator.GetLargestFree() == 30);
+        REQUIRE(allocator.GetUsed() == 0);
+    }
+
+    SECTION("Growing extends the free tail and keeps allocations") {
+        allocator.Free(c, 10);
+        allocator.Grow(60);
+
+        REQUIRE(allocator.GetCapacity() == 60);
+        REQUIRE(allocator.GetFreeRangeCount() == 1);
+        REQUIRE(allocator.GetLargestFree() == 40);
+        REQUIRE(allocator.GetUsed() == 20);
+
+        size_t d = 0;
+        REQUIRE(allocator.Allocate(40, d));
+        REQUIRE(d == 20);
+    }
+
+    SECTION("Shrinking is ignored") {
+        allocator.Grow(10);
+        REQUIRE(allocator.GetCapacity() == 30);
+    }
+}
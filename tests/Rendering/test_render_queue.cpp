@@ -0,0 +1,187 @@
+#include <catch2/catch_test_macros.hpp>
+#include "TLETC/Rendering/RenderQueue.h"
+#include "TLETC/Resources/GeometryFactory.h"
+#include "../../src/Platform/OpenGL/GLRenderDevice.h"
+
+#include <vector>
+
+using TLETC::RenderQueue;
+using TLETC::RenderPass;
+
+TEST_CASE("RenderQueue sort keys", "[rendering][renderqueue]") {
+    SECTION("Passes are ordered before anything else") {
+        auto opaque      = RenderQueue::MakeSortKey(RenderPass::Opaque,      0xFFFF, 0xFFFF, 1000.0f);
+        auto transparent = RenderQueue::MakeSortKey(RenderPass::Transparent, 0,      0,      0.0f);
+        auto overlay     = RenderQueue::MakeSortKey(RenderPass::Overlay,     0,      0,      0.0f);
+
+        REQUIRE(opaque < transparent);
+        REQUIRE(transparent < overlay);
+    }
+
+    SECTION("Opaque groups by shader, then mesh, then front to back") {
+        auto nearA = RenderQueue::MakeSortKey(RenderPass::Opaque, 1, 1, 1.0f);
+        auto farA  = RenderQueue::MakeSortKey(RenderPass::Opaque, 1, 1, 50.0f);
+        auto meshB = RenderQueue::MakeSortKey(RenderPass::Opaque, 1, 2, 0.5f);
+        auto shdB  = RenderQueue::MakeSortKey(RenderPass::Opaque, 2, 0, 0.0f);
+
+        REQUIRE(nearA < farA);
+        REQUIRE(farA < meshB);
+        REQUIRE(meshB < shdB);
+    }
+
+    SECTION("Transparent sorts back to front regardless of state") {
+        auto nearKey = RenderQueue::MakeSortKey(RenderPass::Transparent, 1, 1, 2.0f);
+        auto farKey  = RenderQueue::MakeSortKey(RenderPass::Transparent, 9, 9, 20.0f);
+
+        REQUIRE(farKey < nearKey);
+    }
+
+    SECTION("Negative and zero depth share the nearest slot") {
+        REQUIRE(RenderQueue::MakeSortKey(RenderPass::Opaque, 1, 1, -3.0f) ==
+                RenderQueue::MakeSortKey(RenderPass::Opaque, 1, 1, 0.0f));
+    }
+}
+
+TEST_CASE("RenderQueue submission", "[rendering][renderqueue]") {
+    RenderQueue queue;
+    TLETC::Mesh cube = TLETC::GeometryFactory::CreateCube(1.0f);
+    TLETC::Mesh empty;
+    TLETC::ShaderHandle shader(3);
+
+    SECTION("Valid draws are queued") {
+        queue.Submit(cube, shader, TLETC::Mat4(1.0f));
+        queue.Submit(cube, shader, TLETC::Mat4(1.0f), RenderPass::Transparent);
+
+        REQUIRE(queue.GetCommandCount() == 2);
+    }
+
+    SECTION("Empty meshes and invalid shaders are ignored") {
+        queue.Submit(empty, shader, TLETC::Mat4(1.0f));
+        queue.Submit(cube, TLETC::ShaderHandle(), TLETC::Mat4(1.0f));
+
+        REQUIRE(queue.GetCommandCount() == 0);
+    }
+
+    SECTION("Clear drops queued draws") {
+        queue.Submit(cube, shader, TLETC::Mat4(1.0f));
+        queue.Clear();
+
+        REQUIRE(queue.GetCommandCount() == 0);
+    }
+}
+
+namespace {
+
+// Records what the queue issues instead of drawing - never initialized, so no GL is touched
+class RecordingDevice : public TLETC::GLRenderDevice {
+public:
+    struct Batch {
+        const TLETC::Mesh* mesh;
+        std::vector<int>   ids;  // Hidden in each transform's bottom row
+    };
+    struct Draw {
+        TLETC::ShaderHandle  shader;
+        TLETC::PrimitiveType primitiveType;
+        std::vector<Batch>   batches;
+    };
+
+    void UseShader(TLETC::ShaderHandle shader) override { current_ = shader; ++shaderChanges; }
+
+    void DrawMeshBatch(std::span<const TLETC::MeshBatch> batches, TLETC::PrimitiveType primitiveType) override {
+        Draw draw = { current_, primitiveType, {} };
+        for (const TLETC::MeshBatch& batch : batches) {
+            draw.batches.push_back({ batch.mesh, {} });
+            for (const TLETC::Mat4& transform : batch.transforms)
+                draw.batches.back().ids.push_back(static_cast<int>(transform[0][3]));
+        }
+        draws.push_back(draw);
+    }
+
+    std::vector<Draw> draws;
+    int               shaderChanges = 0;
+
+private:
+    TLETC::ShaderHandle current_;
+};
+
+TLETC::Mat4 At(float z, int id) {
+    TLETC::Mat4 transform = glm::translate(TLETC::Mat4(1.0f), TLETC::Vec3(0.0f, 0.0f, z));
+    transform[0][3] = static_cast<float>(id);
+    return transform;
+}
+
+} // namespace
+
+TEST_CASE("RenderQueue flush", "[rendering][renderqueue]") {
+    RenderQueue queue;
+    RecordingDevice device;
+    TLETC::Mesh a = TLETC::GeometryFactory::CreateCube(1.0f);
+    TLETC::Mesh b = TLETC::GeometryFactory::CreateCube(2.0f);
+    TLETC::ShaderHandle first(1), second(2);
+
+    SECTION("Sorted, merged into instanced runs, one draw per shader run") {
+        queue.Submit(a, second, At(-5.0f, 0));
+        queue.Submit(b, first,  At(-3.0f, 1));
+        queue.Submit(a, first,  At(-10.0f, 2));
+        queue.Submit(a, first,  At(-1.0f, 3));
+        queue.Submit(a, first,  At(-8.0f, 4), RenderPass::Transparent);
+        queue.Submit(a, first,  At(-20.0f, 5), RenderPass::Transparent);
+        queue.Submit(b, second, At(-1.0f, 6), RenderPass::Overlay);
+        queue.Flush(device);
+
+        // Opaque by shader, mesh, front to back; transparent back to front; overlay last
+        REQUIRE(device.draws.size() == 4);
+        REQUIRE(device.draws[0].shader == first);
+        REQUIRE(device.draws[0].batches.size() == 2);
+        REQUIRE(device.draws[0].batches[0].mesh == &a);
+        REQUIRE(device.draws[0].batches[0].ids == std::vector<int>{ 3, 2 });
+        REQUIRE(device.draws[0].batches[1].mesh == &b);
+        REQUIRE(device.draws[0].batches[1].ids == std::vector<int>{ 1 });
+
+        REQUIRE(device.draws[1].shader == second);
+        REQUIRE(device.draws[1].batches.size() == 1);
+        REQUIRE(device.draws[1].batches[0].ids == std::vector<int>{ 0 });
+
+        REQUIRE(device.draws[2].shader == first);
+        REQUIRE(device.draws[2].batches.size() == 1);
+        REQUIRE(device.draws[2].batches[0].ids == std::vector<int>{ 5, 4 });
+
+        REQUIRE(device.draws[3].shader == second);
+        REQUIRE(device.draws[3].batches[0].mesh == &b);
+        REQUIRE(device.draws[3].batches[0].ids == std::vector<int>{ 6 });
+
+        const RenderQueue::Stats& stats = queue.GetStats();
+        REQUIRE(stats.commands == 7);
+        REQUIRE(stats.drawCalls == 4);
+        REQUIRE(stats.meshBatches == 5);
+        REQUIRE(stats.shaderChanges == 4);
+        REQUIRE(device.shaderChanges == 4);
+    }
+
+    SECTION("Topology splits a run, the shader stays bound across it") {
+        queue.Submit(a, first, At(-1.0f, 0));
+        queue.Submit(a, first, At(-2.0f, 1), RenderPass::Opaque, TLETC::PrimitiveType::Lines);
+        queue.Submit(a, first, At(-3.0f, 2), RenderPass::Transparent);
+        queue.Flush(device);
+
+        REQUIRE(device.draws.size() == 3);
+        REQUIRE(device.draws[0].primitiveType == TLETC::PrimitiveType::Triangles);
+        REQUIRE(device.draws[1].primitiveType == TLETC::PrimitiveType::Lines);
+        REQUIRE(device.draws[1].batches[0].ids == std::vector<int>{ 1 });
+        REQUIRE(queue.GetStats().drawCalls == 3);
+        REQUIRE(queue.GetStats().shaderChanges == 1);
+        REQUIRE(device.shaderChanges == 1);
+    }
+
+    SECTION("A flush empties the queue") {
+        queue.Submit(a, first, At(-1.0f, 0));
+        queue.Flush(device);
+        REQUIRE(queue.GetCommandCount() == 0);
+
+        device.draws.clear();
+        queue.Flush(device);
+        REQUIRE(device.draws.empty());
+        REQUIRE(queue.GetStats().commands == 0);
+        REQUIRE(queue.GetStats().drawCalls == 0);
+    }
+}
@@ -0,0 +1,47 @@
+#include <catch2/catch_test_macros.hpp>
+#include "../../src/Platform/OpenGL/GLStreamBuffer.h"
+#include "GLTestContext.h"
+
+using namespace TLETC;
+
+TEST_CASE("GLStreamBuffer regions stay aligned as it grows", "[rendering][streambuffer]") {
+    GLTestContext context;
+    if (!context.window)
+        SKIP("No OpenGL 4.5 context available");
+
+    // A frame size no alignment divides, rounded up on creation
+    GLStreamBuffer stream;
+    REQUIRE(stream.Create(1000, 256));
+    REQUIRE(stream.GetFrameSize() % 256 == 0);
+
+    auto requireAlignedFrames = [&](size_t alignment) {
+        for (uint32 frame = 0; frame < GLStreamBuffer::FrameCount; ++frame) {
+            stream.EndFrame();
+            stream.BeginFrame();
+            REQUIRE(stream.GetFrameOffset() % alignment == 0);
+            const GLStreamBuffer::Allocation allocation = stream.Allocate(100, alignment);
+            REQUIRE(allocation.IsValid());
+            REQUIRE(allocation.offset % alignment == 0);
+        }
+    };
+    requireAlignedFrames(256);
+
+    SECTION("A request past twice the frame size grows to it, rounded") {
+        // Doubling isn't enough, so the new frame size comes from the request itself
+        const size_t size = stream.GetFrameSize() * 2 + 4 + 1;
+        const GLStreamBuffer::Allocation big = stream.Allocate(size, 4);
+        REQUIRE(big.IsValid());
+        REQUIRE(stream.GetFrameSize() >= size);
+        REQUIRE(stream.GetFrameSize() % 256 == 0);
+        requireAlignedFrames(256);
+    }
+
+    SECTION("Alignments beyond the frame alignment are honoured too") {
+        const GLStreamBuffer::Allocation big = stream.Allocate(stream.GetFrameSize() * 3, 1024);
+        REQUIRE(big.IsValid());
+        REQUIRE(big.offset % 1024 == 0);
+        requireAlignedFrames(1024);
+    }
+
+    stream.Destroy();
+}
@@ -0,0 +1,44 @@
+#include <catch2/catch_test_macros.hpp>
+#include "TLETC/Rendering/UniformID.h"
+
+#include <string>
+
+TEST_CASE("UniformID hashing", "[rendering][uniforms]") {
+    SECTION("Default ID is invalid") {
+        TLETC::UniformID id;
+        
+        REQUIRE_FALSE(id.IsValid());
+    }
+    
+    SECTION("Same name gives same ID") {
+        TLETC::UniformID a("u_model");
+        TLETC::UniformID b("u_model");
+        
+        REQUIRE(a.IsValid());
+        REQUIRE(a == b);
+    }
+    
+    SECTION("Different names give different IDs") {
+        TLETC::UniformID model("u_model");
+        TLETC::UniformID view("u_view");
+        TLETC::UniformID projection("u_projection");
+        
+        REQUIRE(model != view);
+        REQUIRE(model != projection);
+        REQUIRE(view != projection);
+    }
+    
+    SECTION("Runtime strings match compile-time IDs") {
+        static constexpr TLETC::UniformID compileTime("u_lightPos");
+        std::string runtimeName = "u_light";
+        runtimeName += "Pos";
+        
+        REQUIRE(TLETC::UniformID(runtimeName) == compileTime);
+        REQUIRE(TLETC::UniformID::Hash(runtimeName) == compileTime.GetHash());
+    }
+    
+    SECTION("Array element names are distinct") {
+        REQUIRE(TLETC::UniformID("u_lights[0]") != TLETC::UniformID("u_lights"));
+        REQUIRE(TLETC::UniformID("u_lights[0]") != TLETC::UniformID("u_lights[1]"));
+    }
+}
@@ -338,4 +338,136 @@ TEST_CASE("Mesh normal recalculation", "[mesh][resources]") {
             REQUIRE(length == Approx(1.0f).margin(0.01f));
         }
     }
-}
\ No newline at end of file
+}
+TEST_CASE("Mesh identity and change tracking", "[mesh][resources]") {
+    using TLETC::VertexStream;
+    
+    SECTION("Every mesh gets its own ID") {
+        TLETC::Mesh a;
+        TLETC::Mesh b;
+        TLETC::Mesh copy(a);
+        
+        REQUIRE(a.GetID() != 0);
+        REQUIRE(a.GetID() != b.GetID());
+        REQUIRE(copy.GetID() != a.GetID());
+    }
+    
+    SECTION("Assignment keeps the ID and marks everything changed") {
+        TLETC::Mesh a = TLETC::GeometryFactory::CreateQuad(1.0f, 1.0f);
+        TLETC::Mesh b;
+        const TLETC::uint32 id = b.GetID();
+        const TLETC::uint32 indexGeneration = b.GetIndexGeneration();
+        
+        b = a;
+        
+        REQUIRE(b.GetID() == id);
+        REQUIRE(b.GetIndexGeneration() != indexGeneration);
+        REQUIRE(b.GetVertexCount() == 4);
+    }
+    
+    SECTION("Setters only touch their own stream") {
+        TLETC::Mesh mesh = TLETC::GeometryFactory::CreateQuad(1.0f, 1.0f);
+        const TLETC::uint32 generation = mesh.GetGeneration();
+        const TLETC::uint32 positions  = mesh.GetStreamGeneration(VertexStream::Position);
+        const TLETC::uint32 normals    = mesh.GetStreamGeneration(VertexStream::Normal);
+        const TLETC::uint32 indices    = mesh.GetIndexGeneration();
+        
+        mesh.SetVertexPosition(0, TLETC::Vec3(5.0f));
+        
+        REQUIRE(mesh.GetGeneration() != generation);
+        REQUIRE(mesh.GetStreamGeneration(VertexStream::Position) != positions);
+        REQUIRE(mesh.GetStreamGeneration(VertexStream::Normal) == normals);
+        REQUIRE(mesh.GetIndexGeneration() == indices);
+    }
+    
+    SECTION("Edits mark the stream, reads do not") {
+        TLETC::Mesh mesh = TLETC::GeometryFactory::CreateQuad(1.0f, 1.0f);
+        const TLETC::uint32 uvs        = mesh.GetStreamGeneration(VertexStream::UV);
+        const TLETC::uint32 generation = mesh.GetGeneration();
+        
+        (void)mesh.GetVertexUVs();
+        (void)mesh.GetIndices();
+        REQUIRE(mesh.GetStreamGeneration(VertexStream::UV) == uvs);
+        REQUIRE(mesh.GetGeneration() == generation);
+        
+        mesh.EditVertexUVs()[0] = TLETC::Vec2(0.5f);
+        REQUIRE(mesh.GetStreamGeneration(VertexStream::UV) != uvs);
+    }
+    
+    SECTION("Format changes are tracked separately") {
+        TLETC::Mesh mesh;
+        const TLETC::uint32 format = mesh.GetFormatGeneration();
+        
+        mesh.SetVertexCompression(TLETC::VertexCompression::Compact);
+        
+        REQUIRE(mesh.GetFormatGeneration() != format);
+    }
+    
+    SECTION("Only resident meshes report their destruction") {
+        std::vector<TLETC::uint32> destroyed;
+        TLETC::Mesh::CollectDestroyed(destroyed);
+        destroyed.clear();
+        
+        TLETC::uint32 residentID = 0;
+        {
+            TLETC::Mesh resident;
+            TLETC::Mesh unused;
+            resident.MarkResident();
+            residentID = resident.GetID();
+        }
+        
+        TLETC::Mesh::CollectDestroyed(destroyed);
+        REQUIRE(destroyed.size() == 1);
+        REQUIRE(destroyed[0] == residentID);
+        
+        destroyed.clear();
+        TLETC::Mesh::CollectDestroyed(destroyed);
+        REQUIRE(destroyed.empty());
+    }
+}
+
+TEST_CASE("Mesh dirty ranges", "[mesh][resources]") {
+    using TLETC::VertexStream;
+    
+    TLETC::Mesh mesh = TLETC::GeometryFactory::CreatePlane(1.0f, 1.0f, 10, 10);
+    mesh.ClearDirtyRanges();
+    
+    SECTION("Single vertex edits widen a min/max range") {
+        mesh.SetVertexPosition(7, TLETC::Vec3(1.0f));
+        mesh.SetVertexPosition(3, TLETC::Vec3(2.0f));
+        
+        const TLETC::DirtyRange& range = mesh.GetDirtyRange(VertexStream::Position);
+        REQUIRE(range.begin == 3);
+        REQUIRE(range.end == 8);
+        REQUIRE(mesh.GetDirtyRange(VertexStream::Normal).IsEmpty());
+    }
+    
+    SECTION("Edit spans mark exactly their window") {
+        auto colors = mesh.EditVertexColors(10, 4);
+        colors[0] = TLETC::Vec4(0.0f);
+        
+        REQUIRE(colors.size() == 4);
+        REQUIRE(mesh.GetDirtyRange(VertexStream::Color).begin == 10);
+        REQUIRE(mesh.GetDirtyRange(VertexStream::Color).end == 14);
+        REQUIRE(mesh.GetVertexColors()[10] == TLETC::Vec4(0.0f));
+    }
+    
+    SECTION("Unbounded edits mark the whole stream") {
+        mesh.EditVertexNormals()[0] = TLETC::Vec3(0.0f, 0.0f, 1.0f);
+        REQUIRE(mesh.EditVertexNormals().size() == mesh.GetVertexCount());
+        
+        const TLETC::DirtyRange& range = mesh.GetDirtyRange(VertexStream::Normal);
+        REQUIRE(range.begin == 0);
+        REQUIRE(range.end >= mesh.GetVertexCount());
+    }
+    
+    SECTION("Clearing resets every range") {
+        mesh.SetVertexUV(0, TLETC::Vec2(0.5f));
+        mesh.EditIndices(0, 3);
+        REQUIRE(mesh.GetIndexDirtyRange().end == 3);
+        mesh.ClearDirtyRanges();
+        
+        REQUIRE(mesh.GetDirtyRange(VertexStream::UV).IsEmpty());
+        REQUIRE(mesh.GetIndexDirtyRange().IsEmpty());
+    }
+}
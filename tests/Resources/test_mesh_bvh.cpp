@@ -0,0 +1,144 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+#include "TLETC/Resources/MeshBVH.h"
+#include "TLETC/Resources/Mesh.h"
+#include "TLETC/Resources/GeometryFactory.h"
+#include "TLETC/Core/JobSystem.h"
+
+#include <random>
+
+using namespace TLETC;
+using Catch::Approx;
+
+// Reference: every triangle, one at a time
+static bool BruteForceRaycast(const Mesh& mesh, const Ray& ray, float maxDistance, float& distance, uint32& triangle) {
+    const auto& positions = mesh.GetVertexPositions();
+    const auto& indices   = mesh.GetIndices();
+    bool found = false;
+    distance = maxDistance;
+    for (uint32 t = 0; t < indices.size() / 3; ++t) {
+        const Vec3& v0 = positions[indices[t * 3]];
+        const Vec3  e1 = positions[indices[t * 3 + 1]] - v0;
+        const Vec3  e2 = positions[indices[t * 3 + 2]] - v0;
+        const Vec3  p  = cross(ray.direction, e2);
+        const float det = dot(e1, p);
+        if (det == 0.0f) continue;
+        const Vec3  s = ray.origin - v0;
+        const float u = dot(s, p) / det;
+        const Vec3  q = cross(s, e1);
+        const float v = dot(ray.direction, q) / det;
+        const float d = dot(e2, q) / det;
+        if (u < 0.0f || v < 0.0f || u + v > 1.0f || d < 0.0f || d > distance) continue;
+        distance = d;
+        triangle = t;
+        found    = true;
+    }
+    return found;
+}
+
+TEST_CASE("MeshBVH build", "[resources][meshbvh]") {
+    Mesh sphere = GeometryFactory::CreateSphere(1.0f, 32, 16);
+    MeshBVH bvh;
+
+    SECTION("Empty meshes do not build") {
+        REQUIRE_FALSE(bvh.Build(Mesh()));
+        REQUIRE_FALSE(bvh.IsBuilt());
+    }
+
+    SECTION("Covers every triangle and tracks the mesh") {
+        REQUIRE(bvh.Build(sphere));
+        REQUIRE(bvh.GetTriangleCount() == sphere.GetTriangleCount());
+        REQUIRE(bvh.IsCurrent(sphere));
+        REQUIRE(bvh.GetMemoryUsage() > 0);
+
+        sphere.Translate(Vec3(1.0f, 0.0f, 0.0f));
+        REQUIRE_FALSE(bvh.IsCurrent(sphere));
+        REQUIRE_FALSE(bvh.IsCurrent(GeometryFactory::CreateSphere(1.0f, 32, 16)));
+    }
+}
+
+TEST_CASE("MeshBVH raycasts", "[resources][meshbvh]") {
+    const Mesh mesh = GeometryFactory::CreateTorus(1.0f, 0.35f, 48, 24);
+    const MeshBVH bvh(mesh);
+
+    std::mt19937 rng(99);
+    std::uniform_real_distribution<float> spread(-1.6f, 1.6f);
+    std::vector<Ray> rays;
+    for (int i = 0; i < 600; ++i) {
+        const Vec3 origin(spread(rng), spread(rng), 4.0f);
+        const Vec3 target(spread(rng), spread(rng), spread(rng));
+        rays.emplace_back(origin, target - origin);  // Not normalized on purpose
+    }
+
+    SECTION("Straight down onto a quad reports distance, triangle and barycentrics") {
+        const Mesh quad = GeometryFactory::CreatePlane(2.0f, 2.0f);
+        const MeshBVH quadBVH(quad);
+        MeshRaycastHit hit;
+        REQUIRE(quadBVH.Raycast(Ray(Vec3(0.25f, 3.0f, 0.1f), Vec3(0.0f, -1.0f, 0.0f)), 10.0f, hit));
+        REQUIRE(hit.distance == Approx(3.0f));
+        REQUIRE(hit.IsHit());
+
+        const auto& positions = quad.GetVertexPositions();
+        const auto& indices   = quad.GetIndices();
+        const Vec3 a = positions[indices[hit.triangle * 3]];
+        const Vec3 b = positions[indices[hit.triangle * 3 + 1]];
+        const Vec3 c = positions[indices[hit.triangle * 3 + 2]];
+        const Vec3 point = a + (b - a) * hit.barycentric.x + (c - a) * hit.barycentric.y;
+        REQUIRE(point.x == Approx(0.25f));
+        REQUIRE(point.z == Approx(0.1f));
+
+        REQUIRE_FALSE(quadBVH.Raycast(Ray(Vec3(0.25f, 3.0f, 0.1f), Vec3(0.0f, -1.0f, 0.0f)), 2.0f, hit));
+        REQUIRE_FALSE(quadBVH.Raycast(Ray(Vec3(0.25f, 3.0f, 0.1f), Vec3(0.0f, 1.0f, 0.0f)), 10.0f, hit));
+        REQUIRE(quadBVH.Raycast(Ray(Vec3(0.25f, -3.0f, 0.1f), Vec3(0.0f, 1.0f, 0.0f)), 10.0f, hit));  // Back face
+    }
+
+    SECTION("Closest hits match a brute-force pass") {
+        int hits = 0;
+        for (const Ray& ray : rays) {
+            float  distance = 0.0f;
+            uint32 triangle = 0;
+            const bool expected = BruteForceRaycast(mesh, ray, 100.0f, distance, triangle);
+
+            MeshRaycastHit hit;
+            REQUIRE(bvh.Raycast(ray, 100.0f, hit) == expected);
+            REQUIRE(bvh.Occluded(ray, 100.0f) == expected);
+            if (expected) {
+                REQUIRE(hit.distance == Approx(distance));
+                ++hits;
+            }
+        }
+        REQUIRE(hits > 50);
+    }
+
+    SECTION("Batched queries match single ones on any thread count") {
+        JobSystem jobs;
+        jobs.Initialize(3);
+        for (JobSystem* system : { static_cast<JobSystem*>(nullptr), &jobs }) {
+            std::vector<MeshRaycastHit> hits(rays.size());
+            std::vector<uint8>          occluded(rays.size());
+            bvh.Raycast(rays, 100.0f, hits, system);
+            bvh.Occluded(rays, 0.5f, occluded, system);
+
+            for (size_t i = 0; i < rays.size(); ++i) {
+                MeshRaycastHit single;
+                const bool expected = bvh.Raycast(rays[i], 100.0f, single);
+                REQUIRE(hits[i].IsHit() == expected);
+                if (expected) {
+                    REQUIRE(hits[i].triangle == single.triangle);
+                    REQUIRE(hits[i].distance == single.distance);
+                }
+                REQUIRE((occluded[i] != 0) == bvh.Occluded(rays[i], 0.5f));
+            }
+        }
+    }
+
+    SECTION("World rays moved into mesh space keep their distances") {
+        const MeshBVH sphereBVH(GeometryFactory::CreateSphere(1.0f, 64, 32));
+        const Mat4 world = translate(Mat4(1.0f), Vec3(10.0f, 0.0f, 0.0f)) * glm::scale(Mat4(1.0f), Vec3(2.0f));
+        const Ray  worldRay(Vec3(10.0f, 0.0f, 20.0f), Vec3(0.0f, 0.0f, -1.0f));
+
+        MeshRaycastHit hit;
+        REQUIRE(sphereBVH.Raycast(worldRay.Transformed(glm::inverse(world)), 100.0f, hit));
+        REQUIRE(hit.distance == Approx(18.0f).margin(0.05f));  // Surface of the radius 2 sphere
+    }
+}
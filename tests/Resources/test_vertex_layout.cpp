@@ -0,0 +1,162 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+
+#include "TLETC/Resources/Mesh.h"
+#include "TLETC/Resources/VertexLayout.h"
+#include "TLETC/Resources/GeometryFactory.h"
+
+#include <cstring>
+
+using Catch::Approx;
+
+static float ReadFloat(const std::vector<TLETC::uint8>& data, size_t offset)
+{
+    float value;
+    std::memcpy(&value, data.data() + offset, sizeof(float));
+    return value;
+}
+
+TEST_CASE("Vertex format description", "[resources][vertexlayout]") {
+    SECTION("Standard format is 48 bytes of float") {
+        TLETC::VertexFormat format = TLETC::VertexFormat::Standard();
+        const auto& attributes = format.GetAttributes();
+
+        REQUIRE(format.GetStride() == 48);
+        REQUIRE(attributes.size() == 4);
+        REQUIRE(attributes[0].offset == 0);
+        REQUIRE(attributes[1].offset == 12);
+        REQUIRE(attributes[2].offset == 24);
+        REQUIRE(attributes[3].offset == 32);
+        REQUIRE(attributes[3].location == 3);
+    }
+
+    SECTION("Extracted attribute starts at offset zero") {
+        TLETC::VertexFormat uv = TLETC::VertexFormat::Standard().Extract(2);
+
+        REQUIRE(uv.GetAttributes().size() == 1);
+        REQUIRE(uv.GetAttributes()[0].offset == 0);
+        REQUIRE(uv.GetAttributes()[0].location == 2);
+        REQUIRE(uv.GetStride() == 8);
+    }
+
+    SECTION("Meshes default to the interleaved layout") {
+        TLETC::Mesh mesh;
+        REQUIRE(mesh.GetVertexLayout() == TLETC::VertexLayout::Interleaved);
+
+        mesh.SetVertexLayout(TLETC::VertexLayout::Separate);
+        REQUIRE(mesh.GetVertexLayout() == TLETC::VertexLayout::Separate);
+    }
+}
+
+TEST_CASE("Vertex packing", "[resources][vertexlayout]") {
+    TLETC::Mesh mesh;
+    mesh.AddVertex(TLETC::Vec3(1.0f, 2.0f, 3.0f), TLETC::Vec3(0.0f, 1.0f, 0.0f), TLETC::Vec2(0.25f, 0.75f), TLETC::Vec4(0.1f, 0.2f, 0.3f, 0.4f));
+    mesh.AddVertex(TLETC::Vec3(4.0f, 5.0f, 6.0f), TLETC::Vec3(1.0f, 0.0f, 0.0f), TLETC::Vec2(0.5f, 0.5f),   TLETC::Vec4(1.0f));
+
+    SECTION("Interleaved packing keeps every attribute of a vertex together") {
+        TLETC::VertexFormat format = TLETC::VertexFormat::Standard();
+        auto data = TLETC::PackVertices(mesh, format);
+
+        REQUIRE(data.size() == 2 * 48);
+        REQUIRE(ReadFloat(data, 0)  == Approx(1.0f));   // v0 position.x
+        REQUIRE(ReadFloat(data, 16) == Approx(1.0f));   // v0 normal.y
+        REQUIRE(ReadFloat(data, 28) == Approx(0.75f));  // v0 uv.y
+        REQUIRE(ReadFloat(data, 44) == Approx(0.4f));   // v0 color.a
+        REQUIRE(ReadFloat(data, 48) == Approx(4.0f));   // v1 position.x
+        REQUIRE(ReadFloat(data, 60) == Approx(1.0f));   // v1 normal.x
+    }
+
+    SECTION("Single stream packing matches the source vector") {
+        auto data = TLETC::PackVertices(mesh, TLETC::VertexFormat::Standard().Extract(0));
+
+        REQUIRE(data.size() == 2 * sizeof(TLETC::Vec3));
+        REQUIRE(std::memcmp(data.data(), mesh.GetVertexPositions().data(), data.size()) == 0);
+    }
+
+    SECTION("Factory meshes pack to vertex count times stride") {
+        TLETC::Mesh sphere = TLETC::GeometryFactory::CreateSphere(0.5f, 16, 8);
+        auto data = TLETC::PackVertices(sphere, TLETC::VertexFormat::Standard());
+
+        REQUIRE(data.size() == sphere.GetVertexCount() * 48);
+    }
+
+    SECTION("Range packing matches the same slice of a full pack") {
+        TLETC::Mesh sphere = TLETC::GeometryFactory::CreateSphere(0.5f, 16, 8);
+        TLETC::VertexFormat format = TLETC::VertexFormat::Standard();
+        auto full  = TLETC::PackVertices(sphere, format);
+        auto slice = TLETC::PackVertices(sphere, format, TLETC::BoundingBox(), 10, 5);
+
+        REQUIRE(slice.size() == 5 * 48);
+        REQUIRE(std::memcmp(slice.data(), full.data() + 10 * 48, slice.size()) == 0);
+    }
+}
+
+TEST_CASE("Compressed vertex formats", "[resources][vertexlayout]") {
+    SECTION("Compression flags shrink the stride") {
+        REQUIRE(TLETC::VertexFormat::Create(TLETC::VertexCompression::None).GetStride() == 48);
+        REQUIRE(TLETC::VertexFormat::Create(TLETC::VertexCompression::Compact).GetStride() == 24);
+        REQUIRE(TLETC::VertexFormat::Create(TLETC::VertexCompression::Smallest).GetStride() == 20);
+        REQUIRE(TLETC::VertexFormat::Create(TLETC::VertexCompression::Unorm16UVs).GetStride() == 44);
+    }
+
+    SECTION("Octahedral encoding round-trips unit vectors") {
+        for (int i = 0; i < 64; ++i) {
+            float theta = TLETC::TWO_PI * static_cast<float>(i) / 64.0f;
+            float phi   = TLETC::PI * (static_cast<float>(i % 16) + 0.5f) / 16.0f;
+            TLETC::Vec3 n(std::sin(phi) * std::cos(theta), std::cos(phi), std::sin(phi) * std::sin(theta));
+
+            TLETC::Vec3 decoded = TLETC::DecodeOctahedral(TLETC::EncodeOctahedral(n));
+            REQUIRE(TLETC::dot(decoded, n) == Approx(1.0f).margin(1e-5f));
+        }
+    }
+
+    SECTION("Packed compact vertex decodes close to the source") {
+        TLETC::Mesh mesh = TLETC::GeometryFactory::CreateSphere(2.0f, 16, 8);
+        TLETC::VertexFormat format = TLETC::VertexFormat::Create(TLETC::VertexCompression::Smallest);
+        TLETC::BoundingBox bounds = mesh.CalculateBoundingBox();
+        auto data = TLETC::PackVertices(mesh, format, bounds);
+
+        REQUIRE(data.size() == mesh.GetVertexCount() * 20);
+
+        for (size_t v = 0; v < mesh.GetVertexCount(); v += 7) {
+            const TLETC::uint8* vertex = data.data() + v * 20;
+
+            TLETC::uint16 q[3];
+            std::memcpy(q, vertex, sizeof(q));
+            for (int c = 0; c < 3; ++c) {
+                float decoded = bounds.min[c] + (q[c] / 65535.0f) * bounds.GetSize()[c];
+                REQUIRE(decoded == Approx(mesh.GetVertexPosition(v)[c]).margin(1e-4f));
+            }
+
+            TLETC::int16 oct[2];
+            std::memcpy(oct, vertex + 8, sizeof(oct));
+            TLETC::Vec3 normal = TLETC::DecodeOctahedral(TLETC::Vec2(oct[0] / 32767.0f, oct[1] / 32767.0f));
+            REQUIRE(TLETC::dot(normal, mesh.GetVertexNormal(v)) == Approx(1.0f).margin(1e-4f));
+
+            const TLETC::uint8* rgba = vertex + 16;
+            REQUIRE(rgba[3] == 255);
+        }
+    }
+}
+
+TEST_CASE("Index narrowing", "[resources][vertexlayout]") {
+    SECTION("16-bit indices up to 65536 vertices") {
+        REQUIRE(TLETC::SelectIndexType(0) == TLETC::IndexType::UInt16);
+        REQUIRE(TLETC::SelectIndexType(65536) == TLETC::IndexType::UInt16);
+        REQUIRE(TLETC::SelectIndexType(65537) == TLETC::IndexType::UInt32);
+    }
+
+    SECTION("Factory primitives fit in 16 bits") {
+        TLETC::Mesh sphere = TLETC::GeometryFactory::CreateSphere();
+        REQUIRE(TLETC::SelectIndexType(sphere.GetVertexCount()) == TLETC::IndexType::UInt16);
+    }
+
+    SECTION("Narrowed indices keep their values") {
+        std::vector<TLETC::uint32> indices = { 0, 1, 2, 65535, 300, 7 };
+        auto narrowed = TLETC::NarrowIndices(indices);
+
+        REQUIRE(narrowed.size() == indices.size());
+        for (size_t i = 0; i < indices.size(); ++i)
+            REQUIRE(narrowed[i] == indices[i]);
+    }
+}
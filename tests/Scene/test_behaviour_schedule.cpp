@@ -0,0 +1,180 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+#include "TLETC/Scene/BehaviourSchedule.h"
+#include "TLETC/Scene/Entity.h"
+
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <vector>
+
+using namespace TLETC;
+using Catch::Approx;
+
+// Stamps when it ran and moves its entity along x
+class Probe : public Behaviour {
+public:
+    enum Mode { Serial, Declared, ThreadSafe };
+
+    Probe(std::atomic<int>& clock, uint16 order, Mode mode, uint32 reads = TransformData, uint32 writes = TransformData)
+        : clock_(clock) {
+        SetActiveEvents(EventFlag::Update);
+        SetExecutionOrder(order);
+        if (mode == Declared)
+            DeclareAccess(reads, writes);
+        SetThreadSafe(mode == ThreadSafe);
+    }
+
+    void OnUpdate(float deltaTime) override {
+        stamp = clock_.fetch_add(1);
+        if (HasDeclaredAccess())
+            GetEntity()->transform.Translate(Vec3(deltaTime, 0.0f, 0.0f));
+    }
+
+    int stamp = -1;
+
+private:
+    std::atomic<int>& clock_;
+};
+
+static std::vector<Behaviour*> SortedList(const std::vector<Probe*>& probes) {
+    std::vector<Behaviour*> list(probes.begin(), probes.end());
+    std::stable_sort(list.begin(), list.end(), [](Behaviour* a, Behaviour* b) { return a->GetExecutionOrder() < b->GetExecutionOrder(); });
+    return list;
+}
+
+TEST_CASE("BehaviourSchedule splits serial and parallel work", "[scene][behaviour]") {
+    std::atomic<int> clock(0);
+    TransformSystem transforms;
+    Entity a(transforms, "A"), b(transforms, "B");
+    std::vector<Probe*> probes = {
+        a.AddBehaviour<Probe>(clock, 0, Probe::Serial),
+        a.AddBehaviour<Probe>(clock, 0, Probe::ThreadSafe),
+        a.AddBehaviour<Probe>(clock, 0, Probe::Declared, Behaviour::NoData, Behaviour::TransformData),
+        a.AddBehaviour<Probe>(clock, 0, Probe::Declared, Behaviour::TransformData, Behaviour::NoData),  // Reads what the one before writes
+        a.AddBehaviour<Probe>(clock, 0, Probe::Declared, Behaviour::MeshData, Behaviour::MeshData),     // Unrelated
+        b.AddBehaviour<Probe>(clock, 0, Probe::Declared),
+        b.AddBehaviour<Probe>(clock, 5, Probe::Serial),
+    };
+
+    BehaviourSchedule schedule;
+    schedule.Build(SortedList(probes));
+
+    REQUIRE(schedule.GetBatchCount() == 2);
+    REQUIRE(schedule.GetSerialCount() == 2);
+    REQUIRE(schedule.GetParallelCount() == 5);
+    REQUIRE(schedule.GetTaskCount() == 4);  // Thread-safe, A's transform pair, A's mesh one, B's
+
+    SECTION("Without a job system everything runs on the caller, batch by batch") {
+        schedule.Run(nullptr, [](Behaviour* behaviour) { behaviour->OnUpdate(1.0f); });
+        for (Probe* probe : probes)
+            REQUIRE(probe->stamp >= 0);
+        REQUIRE(probes[0]->stamp == 0);  // Serial first within the batch
+        REQUIRE(probes[2]->stamp < probes[3]->stamp);
+        REQUIRE(probes[6]->stamp == 6);
+    }
+
+    SECTION("Disabled behaviours are skipped") {
+        probes[3]->SetEnabled(false);
+        probes[6]->SetEnabled(false);
+        schedule.Run(nullptr, [](Behaviour* behaviour) { behaviour->OnUpdate(1.0f); });
+        REQUIRE(probes[3]->stamp == -1);
+        REQUIRE(probes[6]->stamp == -1);
+        REQUIRE(clock.load() == 5);
+    }
+
+    SECTION("An empty list has nothing to run") {
+        schedule.Build({});
+        REQUIRE(schedule.GetBatchCount() == 0);
+        REQUIRE(schedule.GetTaskCount() == 0);
+        schedule.Run(nullptr, [](Behaviour* behaviour) { behaviour->OnUpdate(1.0f); });
+        REQUIRE(clock.load() == 0);
+    }
+}
+
+TEST_CASE("BehaviourSchedule runs shared mesh data as one task", "[scene][behaviour]") {
+    std::atomic<int> clock(0);
+    TransformSystem transforms;
+    Entity a(transforms, "A"), b(transforms, "B"), c(transforms, "C");
+    std::vector<Probe*> probes = {
+        a.AddBehaviour<Probe>(clock, 0, Probe::Declared, Behaviour::MeshData, Behaviour::NoData),
+        b.AddBehaviour<Probe>(clock, 0, Probe::Declared, Behaviour::NoData, Behaviour::MeshData),
+        c.AddBehaviour<Probe>(clock, 0, Probe::Declared, Behaviour::MeshData, Behaviour::NoData),
+        c.AddBehaviour<Probe>(clock, 0, Probe::Declared, Behaviour::TransformData, Behaviour::TransformData),
+        a.AddBehaviour<Probe>(clock, 0, Probe::Declared, Behaviour::MeshData, Behaviour::TransformData),  // Joins both
+        a.AddBehaviour<Probe>(clock, 0, Probe::Declared, Behaviour::TransformData, Behaviour::NoData),
+    };
+
+    // Different entities may hold the same mesh, so every mesh toucher and what conflicts
+    // with them on their own entity is one task - c's transform one stays apart
+    BehaviourSchedule schedule;
+    schedule.Build(SortedList(probes));
+    REQUIRE(schedule.GetTaskCount() == 2);
+    REQUIRE(schedule.GetParallelCount() == 6);
+
+    JobSystem jobs;
+    jobs.Initialize(3);
+    schedule.Run(&jobs, [](Behaviour* behaviour) { behaviour->OnUpdate(1.0f); });
+    REQUIRE(clock.load() == 6);
+    REQUIRE(probes[4]->stamp < probes[5]->stamp);
+}
+
+TEST_CASE("BehaviourSchedule keeps execution order across threads", "[scene][behaviour]") {
+    constexpr int EntityCount = 300;
+    std::atomic<int> clock(0);
+    TransformSystem transforms;
+    std::deque<Entity> entities;
+    std::vector<Probe*> probes;
+    for (int i = 0; i < EntityCount; ++i) {
+        entities.emplace_back(transforms);
+        for (uint16 order = 0; order < 3; ++order) {
+            probes.push_back(entities[i].AddBehaviour<Probe>(clock, order, Probe::Declared, Behaviour::NoData, Behaviour::TransformData));
+            probes.push_back(entities[i].AddBehaviour<Probe>(clock, order, Probe::Declared, Behaviour::TransformData, Behaviour::NoData));
+            if (i % 10 == 0)
+                probes.push_back(entities[i].AddBehaviour<Probe>(clock, order, i % 20 == 0 ? Probe::Serial : Probe::ThreadSafe));
+        }
+    }
+
+    BehaviourSchedule schedule;
+    schedule.Build(SortedList(probes));
+    REQUIRE(schedule.GetBatchCount() == 3);
+
+    JobSystem jobs;
+    jobs.Initialize(3);
+    schedule.Run(&jobs, [](Behaviour* behaviour) { behaviour->OnUpdate(1.0f); });
+    REQUIRE(clock.load() == static_cast<int>(probes.size()));
+
+    // Every stamp of one order comes before every stamp of the next, and serial ones lead their order
+    for (uint16 order = 0; order < 2; ++order) {
+        int last = -1, first = static_cast<int>(probes.size());
+        for (Probe* probe : probes) {
+            if (probe->GetExecutionOrder() == order)
+                last = std::max(last, probe->stamp);
+            else if (probe->GetExecutionOrder() == order + 1)
+                first = std::min(first, probe->stamp);
+        }
+        REQUIRE(last < first);
+    }
+    int lastSerial = -1, firstParallel = static_cast<int>(probes.size());
+    for (Probe* probe : probes) {
+        if (probe->GetExecutionOrder() != 1)
+            continue;
+        if (probe->RunsInParallel())
+            firstParallel = std::min(firstParallel, probe->stamp);
+        else
+            lastSerial = std::max(lastSerial, probe->stamp);
+    }
+    REQUIRE(lastSerial < firstParallel);
+
+    // Writer before reader on each entity, and every declared update landed on the transform
+    size_t outOfOrder = 0, wrongPositions = 0;
+    for (size_t i = 0; i + 1 < probes.size(); ++i) {
+        if (probes[i]->HasDeclaredAccess() && probes[i + 1]->HasDeclaredAccess() && probes[i]->GetEntity() == probes[i + 1]->GetEntity() &&
+            probes[i]->GetWrites() != 0 && probes[i]->stamp > probes[i + 1]->stamp)
+            ++outOfOrder;
+    }
+    for (Entity& entity : entities)
+        wrongPositions += entity.transform.GetPosition().x != Approx(6.0f);
+    REQUIRE(outOfOrder == 0);
+    REQUIRE(wrongPositions == 0);
+}
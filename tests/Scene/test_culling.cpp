@@ -0,0 +1,142 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+#include "TLETC/Scene/CullingSystem.h"
+#include "TLETC/Resources/GeometryFactory.h"
+
+#include <random>
+
+using namespace TLETC;
+using Catch::Approx;
+
+// Camera at the origin looking down -Z, 90 degree fov, near 1, far 100
+static Frustum MakeFrustum() {
+    const Mat4 projection = perspective(Radians(90.0f), 1.0f, 1.0f, 100.0f);
+    const Mat4 view       = lookAt(Vec3(0.0f), Vec3(0.0f, 0.0f, -1.0f), Vec3(0.0f, 1.0f, 0.0f));
+    return Frustum::FromMatrix(projection * view);
+}
+
+static BoundingBox UnitBoxAt(const Vec3& center) {
+    return BoundingBox(center - Vec3(0.5f), center + Vec3(0.5f));
+}
+
+TEST_CASE("Frustum plane tests", "[scene][culling]") {
+    const Frustum frustum = MakeFrustum();
+
+    SECTION("Planes are normalized") {
+        for (const Vec4& plane : frustum.planes)
+            REQUIRE(length(Vec3(plane)) == Approx(1.0f));
+    }
+
+    SECTION("Boxes inside, outside and straddling a plane") {
+        REQUIRE(frustum.Intersects(UnitBoxAt(Vec3(0.0f, 0.0f, -10.0f))));
+        REQUIRE_FALSE(frustum.Intersects(UnitBoxAt(Vec3(0.0f, 0.0f, 10.0f))));    // Behind
+        REQUIRE_FALSE(frustum.Intersects(UnitBoxAt(Vec3(0.0f, 0.0f, -200.0f))));  // Past far
+        REQUIRE_FALSE(frustum.Intersects(UnitBoxAt(Vec3(20.0f, 0.0f, -10.0f))));  // Right of view
+        REQUIRE(frustum.Intersects(UnitBoxAt(Vec3(10.3f, 0.0f, -10.0f))));        // Pokes in past the right plane
+    }
+
+    SECTION("A default frustum accepts everything") {
+        REQUIRE(Frustum().Intersects(UnitBoxAt(Vec3(1000.0f))));
+    }
+
+    SECTION("Transformed bounds enclose the transformed corners") {
+        const BoundingBox box(Vec3(-1.0f, -2.0f, -3.0f), Vec3(1.0f, 2.0f, 3.0f));
+        const Mat4 m = translate(Mat4(1.0f), Vec3(5.0f, 0.0f, 0.0f)) * glm::mat4_cast(angleAxis(Radians(90.0f), Vec3(0.0f, 1.0f, 0.0f)));
+        const BoundingBox world = box.Transformed(m);
+
+        REQUIRE(world.min.x == Approx(2.0f));
+        REQUIRE(world.max.x == Approx(8.0f));
+        REQUIRE(world.min.y == Approx(-2.0f));
+        REQUIRE(world.max.z == Approx(1.0f));
+    }
+}
+
+TEST_CASE("CullingSystem", "[scene][culling]") {
+    const Frustum frustum = MakeFrustum();
+    CullingSystem culling;
+    std::vector<uint32> visible = { 42 };
+
+    SECTION("Empty system culls to an empty list") {
+        REQUIRE(culling.Cull(frustum, visible) == 0);
+        REQUIRE(visible.empty());
+    }
+
+    SECTION("Visible slots come back compact and in order") {
+        culling.Add(UnitBoxAt(Vec3(0.0f, 0.0f, -5.0f)));   // 0 in
+        culling.Add(UnitBoxAt(Vec3(0.0f, 0.0f, 5.0f)));    // 1 out
+        culling.Add(UnitBoxAt(Vec3(2.0f, 1.0f, -20.0f)));  // 2 in
+        culling.Add(UnitBoxAt(Vec3(-50.0f, 0.0f, -5.0f))); // 3 out
+        culling.Add(UnitBoxAt(Vec3(0.0f, 0.0f, -99.0f)));  // 4 in
+
+        REQUIRE(culling.GetCount() == 5);
+        REQUIRE(culling.Cull(frustum, visible) == 3);
+        REQUIRE(visible == std::vector<uint32>{ 0, 2, 4 });
+
+        culling.Set(1, UnitBoxAt(Vec3(0.0f, 0.0f, -3.0f)));
+        culling.Cull(frustum, visible);
+        REQUIRE(visible == std::vector<uint32>{ 0, 1, 2, 4 });
+    }
+
+    SECTION("Lane padding is never reported") {
+        // Unused lanes hold empty boxes at the origin, which this camera sees
+        const Frustum backedUp = Frustum::FromMatrix(perspective(Radians(90.0f), 1.0f, 1.0f, 100.0f)
+                                                   * lookAt(Vec3(0.0f, 0.0f, 10.0f), Vec3(0.0f), Vec3(0.0f, 1.0f, 0.0f)));
+        for (int i = 0; i < 3; ++i)
+            culling.Add(UnitBoxAt(Vec3(0.0f)));
+        REQUIRE(culling.Cull(backedUp, visible) == 3);
+        REQUIRE(visible == std::vector<uint32>{ 0, 1, 2 });
+    }
+
+    SECTION("Bounds round-trip through the arrays") {
+        const BoundingBox box(Vec3(-1.0f, 2.0f, -3.0f), Vec3(4.0f, 5.0f, 6.0f));
+        const uint32 slot = culling.Add(box);
+        const BoundingBox back = culling.Get(slot);
+
+        REQUIRE(back.min.x == Approx(box.min.x));
+        REQUIRE(back.min.z == Approx(box.min.z));
+        REQUIRE(back.max.y == Approx(box.max.y));
+    }
+
+    SECTION("Matches the scalar test on random boxes") {
+        std::mt19937 rng(1234);
+        std::uniform_real_distribution<float> position(-150.0f, 150.0f);
+        std::uniform_real_distribution<float> size(0.1f, 8.0f);
+
+        std::vector<BoundingBox> boxes;
+        for (int i = 0; i < 10007; ++i) {
+            const Vec3 center(position(rng), position(rng), position(rng));
+            const Vec3 half(size(rng), size(rng), size(rng));
+            boxes.emplace_back(center - half, center + half);
+            culling.Add(boxes.back());
+        }
+
+        const Frustum rotated = Frustum::FromMatrix(perspective(Radians(60.0f), 1.6f, 0.5f, 120.0f)
+                                                  * lookAt(Vec3(3.0f, 10.0f, 4.0f), Vec3(-20.0f, 0.0f, -40.0f), Vec3(0.0f, 1.0f, 0.0f)));
+
+        std::vector<uint32> expected;
+        for (uint32 i = 0; i < boxes.size(); ++i) {
+            if (rotated.Intersects(culling.Get(i)))
+                expected.push_back(i);
+        }
+
+        culling.Cull(rotated, visible);
+        REQUIRE_FALSE(expected.empty());
+        REQUIRE(visible == expected);
+    }
+
+    SECTION("Clear drops every slot") {
+        culling.Add(UnitBoxAt(Vec3(0.0f, 0.0f, -5.0f)));
+        culling.Clear();
+        REQUIRE(culling.GetCount() == 0);
+        REQUIRE(culling.Cull(frustum, visible) == 0);
+    }
+}
+
+TEST_CASE("Mesh bounding box cache", "[scene][culling]") {
+    Mesh cube = GeometryFactory::CreateCube(2.0f);
+    const BoundingBox& bounds = cube.GetBoundingBox();
+    REQUIRE(bounds.max.x == Approx(1.0f));
+
+    cube.Scale(Vec3(3.0f));
+    REQUIRE(cube.GetBoundingBox().max.x == Approx(3.0f));
+}
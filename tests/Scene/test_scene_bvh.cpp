@@ -0,0 +1,191 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+#include "TLETC/Scene/SceneBVH.h"
+#include "TLETC/Scene/Entity.h"
+
+#include <algorithm>
+#include <random>
+
+using namespace TLETC;
+using Catch::Approx;
+
+static bool BoxesOverlap(const BoundingBox& a, const BoundingBox& b) {
+    return a.min.x <= b.max.x && a.max.x >= b.min.x &&
+           a.min.y <= b.max.y && a.max.y >= b.min.y &&
+           a.min.z <= b.max.z && a.max.z >= b.min.z;
+}
+
+static std::vector<Entity*> Sorted(std::vector<Entity*> entities) {
+    std::sort(entities.begin(), entities.end());
+    return entities;
+}
+
+TEST_CASE("BVH build", "[scene][bvh]") {
+    std::vector<BoundingBox> boxes;
+    for (int i = 0; i < 100; ++i)
+        boxes.emplace_back(Vec3(float(i), 0.0f, 0.0f), Vec3(float(i) + 0.5f, 1.0f, 1.0f));
+
+    std::vector<BVHNode> nodes;
+    std::vector<uint32>  order;
+    BuildBVH(boxes, 4, nodes, order);
+
+    SECTION("Root covers everything and every primitive sits in exactly one leaf") {
+        REQUIRE(nodes[0].min.x == 0.0f);
+        REQUIRE(nodes[0].max.x == 99.5f);
+
+        std::vector<int> seen(boxes.size(), 0);
+        for (const BVHNode& node : nodes) {
+            if (!node.IsLeaf()) continue;
+            REQUIRE(node.count <= 4);
+            for (uint32 i = 0; i < node.count; ++i)
+                ++seen[order[node.leftFirst + i]];
+        }
+        REQUIRE(std::all_of(seen.begin(), seen.end(), [](int n) { return n == 1; }));
+    }
+
+    SECTION("Children come after their parent") {
+        for (uint32 i = 0; i < nodes.size(); ++i) {
+            if (!nodes[i].IsLeaf())
+                REQUIRE(nodes[i].leftFirst > i);
+        }
+    }
+
+    SECTION("Refit follows moved primitives") {
+        boxes[0] = BoundingBox(Vec3(-10.0f), Vec3(-9.0f));
+        RefitBVH(boxes, order, nodes);
+        REQUIRE(nodes[0].min.x == -10.0f);
+        REQUIRE(nodes[0].min.y == -10.0f);
+    }
+
+    SECTION("Identical boxes still split into small leaves") {
+        std::vector<BoundingBox> same(50, BoundingBox(Vec3(0.0f), Vec3(1.0f)));
+        BuildBVH(same, 4, nodes, order);
+        for (const BVHNode& node : nodes)
+            REQUIRE(node.count <= 4);
+    }
+
+    SECTION("Empty input gives an empty tree") {
+        BuildBVH({}, 4, nodes, order);
+        REQUIRE(nodes.empty());
+        REQUIRE(GetBVHCost(nodes) == 0.0f);
+    }
+}
+
+TEST_CASE("SceneBVH queries", "[scene][bvh]") {
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> position(-100.0f, 100.0f);
+    std::uniform_real_distribution<float> size(0.2f, 3.0f);
+
+    TransformSystem transforms;
+    std::vector<UniquePtr<Entity>> entities;
+    std::vector<BoundingBox>       bounds;
+    SceneBVH bvh;
+    for (int i = 0; i < 500; ++i) {
+        const Vec3 center(position(rng), position(rng), position(rng));
+        entities.push_back(MakeUnique<Entity>(transforms));
+        bounds.emplace_back(center - Vec3(size(rng)), center + Vec3(size(rng)));
+        bvh.Insert(entities.back().get(), bounds.back());
+    }
+    bvh.Update();
+    REQUIRE(bvh.GetEntityCount() == 500);
+    REQUIRE(bvh.GetRebuildCount() == 1);
+
+    auto linearOverlap = [&](const BoundingBox& box) {
+        std::vector<Entity*> result;
+        for (size_t i = 0; i < entities.size(); ++i) {
+            if (bvh.Contains(entities[i].get()) && BoxesOverlap(bounds[i], box))
+                result.push_back(entities[i].get());
+        }
+        return result;
+    };
+
+    SECTION("Overlap query matches a linear scan") {
+        const BoundingBox query(Vec3(-30.0f), Vec3(20.0f));
+        std::vector<Entity*> found;
+        bvh.QueryOverlap(query, found);
+        REQUIRE_FALSE(found.empty());
+        REQUIRE(Sorted(found) == Sorted(linearOverlap(query)));
+    }
+
+    SECTION("Frustum query matches a linear scan") {
+        const Frustum frustum = Frustum::FromMatrix(perspective(Radians(70.0f), 1.5f, 0.5f, 150.0f)
+                                                  * lookAt(Vec3(0.0f, 0.0f, 120.0f), Vec3(10.0f, 0.0f, 0.0f), Vec3(0.0f, 1.0f, 0.0f)));
+        std::vector<Entity*> found, expected;
+        bvh.QueryFrustum(frustum, found);
+        for (size_t i = 0; i < entities.size(); ++i) {
+            if (frustum.Intersects(bounds[i]))
+                expected.push_back(entities[i].get());
+        }
+        REQUIRE_FALSE(found.empty());
+        REQUIRE(Sorted(found) == Sorted(expected));
+    }
+
+    SECTION("Raycast returns the nearest box") {
+        for (int r = 0; r < 50; ++r) {
+            const Ray ray(Vec3(position(rng), position(rng), -150.0f), normalize(Vec3(position(rng) * 0.002f, position(rng) * 0.002f, 1.0f)));
+
+            float   nearest = 1000.0f;
+            Entity* expected = nullptr;
+            for (size_t i = 0; i < entities.size(); ++i) {
+                float t = 0.0f;
+                if (ray.Intersects(bounds[i], 1000.0f, t) && t < nearest) {
+                    nearest  = t;
+                    expected = entities[i].get();
+                }
+            }
+
+            SceneRaycastHit hit;
+            REQUIRE(bvh.Raycast(ray, 1000.0f, hit) == (expected != nullptr));
+            if (expected) {
+                REQUIRE(hit.distance == Approx(nearest));
+                REQUIRE(hit.entity == expected);
+            }
+        }
+    }
+
+    SECTION("Moved entities are refit without a rebuild") {
+        for (size_t i = 0; i < 20; ++i) {
+            bounds[i] = BoundingBox(bounds[i].min + Vec3(0.5f), bounds[i].max + Vec3(0.5f));
+            bvh.SetBounds(entities[i].get(), bounds[i]);
+        }
+        bvh.Update();
+        REQUIRE(bvh.GetRebuildCount() == 1);
+
+        const BoundingBox query(Vec3(-50.0f), Vec3(0.0f));
+        std::vector<Entity*> found;
+        bvh.QueryOverlap(query, found);
+        REQUIRE(Sorted(found) == Sorted(linearOverlap(query)));
+    }
+
+    SECTION("Scattering entities wears the tree out and triggers a rebuild") {
+        for (size_t i = 0; i < entities.size(); i += 2) {
+            bounds[i] = BoundingBox(bounds[i].min * 3.0f, bounds[i].max * 3.0f + Vec3(40.0f));
+            bvh.SetBounds(entities[i].get(), bounds[i]);
+        }
+        bvh.Update();
+        REQUIRE(bvh.GetRebuildCount() == 2);
+        REQUIRE(bvh.GetCost() <= bvh.GetRebuildThreshold() * bvh.GetCost());
+    }
+
+    SECTION("Removed entities no longer show up") {
+        bvh.Remove(entities[3].get());
+        bvh.Remove(entities[499].get());
+        bvh.Update();
+        REQUIRE(bvh.GetEntityCount() == 498);
+        REQUIRE_FALSE(bvh.Contains(entities[3].get()));
+
+        std::vector<Entity*> found;
+        bvh.QueryOverlap(BoundingBox(Vec3(-200.0f), Vec3(200.0f)), found);
+        REQUIRE(found.size() == 498);
+        REQUIRE(std::find(found.begin(), found.end(), entities[3].get()) == found.end());
+    }
+
+    SECTION("Empty tree answers nothing") {
+        bvh.Clear();
+        std::vector<Entity*> found;
+        SceneRaycastHit hit;
+        bvh.QueryOverlap(BoundingBox(Vec3(-200.0f), Vec3(200.0f)), found);
+        REQUIRE(found.empty());
+        REQUIRE_FALSE(bvh.Raycast(Ray(), 100.0f, hit));
+    }
+}
@@ -1,26 +1,31 @@
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/catch_approx.hpp>
 #include <TLETC/Scene/Transform.h>
+#include <TLETC/Scene/TransformSystem.h>
+
+#include <vector>
 
 using Catch::Approx;
 
 TEST_CASE("Transform component", "[scene][transform]") {
+    TLETC::TransformSystem system;
+
     SECTION("Default construction") {
-        TLETC::Transform transform;
+        TLETC::Transform transform(system);
         
-        REQUIRE(transform.position.x == 0.0f);
-        REQUIRE(transform.position.y == 0.0f);
-        REQUIRE(transform.position.z == 0.0f);
+        REQUIRE(transform.GetPosition().x == 0.0f);
+        REQUIRE(transform.GetPosition().y == 0.0f);
+        REQUIRE(transform.GetPosition().z == 0.0f);
         
-        REQUIRE(transform.scale.x == 1.0f);
-        REQUIRE(transform.scale.y == 1.0f);
-        REQUIRE(transform.scale.z == 1.0f);
+        REQUIRE(transform.GetScale().x == 1.0f);
+        REQUIRE(transform.GetScale().y == 1.0f);
+        REQUIRE(transform.GetScale().z == 1.0f);
     }
     
     SECTION("Get model matrix") {
-        TLETC::Transform transform;
-        transform.position = {1.0f, 2.0f, 3.0f};
-        transform.scale = {2.0f, 2.0f, 2.0f};
+        TLETC::Transform transform(system);
+        transform.SetPosition({1.0f, 2.0f, 3.0f});
+        transform.SetScale({2.0f, 2.0f, 2.0f});
         
         TLETC::Mat4 model = transform.GetModelMatrix();
         
@@ -34,7 +39,7 @@ TEST_CASE("Transform component", "[scene][transform]") {
     }
     
     SECTION("Get forward vector") {
-        TLETC::Transform transform;
+        TLETC::Transform transform(system);
         
         TLETC::Vec3 forward = transform.GetForward();
         
@@ -45,7 +50,7 @@ TEST_CASE("Transform component", "[scene][transform]") {
     }
     
     SECTION("Rotate around axis") {
-        TLETC::Transform transform;
+        TLETC::Transform transform(system);
         transform.Rotate(TLETC::Vec3(0.0f, 1.0f, 0.0f), 90.0f);
         
         TLETC::Vec3 forward = transform.GetForward();
@@ -57,8 +62,8 @@ TEST_CASE("Transform component", "[scene][transform]") {
     }
     
     SECTION("LookAt") {
-        TLETC::Transform transform;
-        transform.position = {0.0f, 0.0f, 0.0f};
+        TLETC::Transform transform(system);
+        transform.SetPosition({0.0f, 0.0f, 0.0f});
         
         TLETC::Vec3 target(1.0f, 0.0f, 0.0f);
         TLETC::Vec3 up(0.0f, 1.0f, 0.0f);
@@ -75,12 +80,14 @@ TEST_CASE("Transform component", "[scene][transform]") {
 }
 
 TEST_CASE("Transform hierarchy", "[scene][transform]") {
+    TLETC::TransformSystem system;
+
     SECTION("Parent-child relationship") {
-        TLETC::Transform parent;
-        TLETC::Transform child;
+        TLETC::Transform parent(system);
+        TLETC::Transform child(system);
         
-        parent.position = {1.0f, 0.0f, 0.0f};
-        child.position = {1.0f, 0.0f, 0.0f};
+        parent.SetPosition({1.0f, 0.0f, 0.0f});
+        child.SetPosition({1.0f, 0.0f, 0.0f});
         
         child.SetParent(&parent);
         
@@ -93,11 +100,11 @@ TEST_CASE("Transform hierarchy", "[scene][transform]") {
     }
     
     SECTION("World matrix with parent") {
-        TLETC::Transform parent;
-        TLETC::Transform child;
+        TLETC::Transform parent(system);
+        TLETC::Transform child(system);
         
-        parent.scale = {2.0f, 2.0f, 2.0f};
-        child.position = {1.0f, 0.0f, 0.0f};
+        parent.SetScale({2.0f, 2.0f, 2.0f});
+        child.SetPosition({1.0f, 0.0f, 0.0f});
         child.SetParent(&parent);
         
         TLETC::Mat4 worldMatrix = child.GetWorldMatrix();
@@ -108,4 +115,113 @@ TEST_CASE("Transform hierarchy", "[scene][transform]") {
         // Child at (1,0,0) with parent scale (2,2,2) -> world pos (2,0,0)
         REQUIRE(transformed.x == Approx(2.0f));
     }
-}
\ No newline at end of file
+}
+
+TEST_CASE("Transform world matrix cache", "[scene][transform]") {
+    TLETC::TransformSystem system;
+    TLETC::Transform root(system);
+    TLETC::Transform middle(system);
+    TLETC::Transform leaf(system);
+    middle.SetParent(&root);
+    leaf.SetParent(&middle);
+    leaf.SetPosition({0.0f, 0.0f, 1.0f});
+
+    SECTION("The system update clears the dirty flags") {
+        REQUIRE(leaf.IsDirty());
+        system.Update();
+        REQUIRE_FALSE(root.IsDirty());
+        REQUIRE_FALSE(middle.IsDirty());
+        REQUIRE_FALSE(leaf.IsDirty());
+    }
+
+    SECTION("Changing a parent dirties its subtree only") {
+        TLETC::Transform sibling(system);
+        sibling.SetParent(&root);
+        system.Update();
+
+        middle.SetPosition({5.0f, 0.0f, 0.0f});
+        REQUIRE_FALSE(root.IsDirty());
+        REQUIRE_FALSE(sibling.IsDirty());
+        REQUIRE(middle.IsDirty());
+        REQUIRE(leaf.IsDirty());
+        REQUIRE(leaf.GetWorldPosition().x == Approx(5.0f));
+
+        system.Update();
+        REQUIRE(leaf.GetWorldPosition().x == Approx(5.0f));
+    }
+
+    SECTION("World values follow every kind of change, with or without an update") {
+        for (bool update : { false, true }) {
+            root.SetScale({1.0f, 1.0f, 1.0f});
+            root.SetRotation(TLETC::Quat(1.0f, 0.0f, 0.0f, 0.0f));
+            root.SetPosition({0.0f, 0.0f, 0.0f});
+            leaf.SetParent(&middle);
+            if (update) system.Update();
+            REQUIRE(leaf.GetWorldPosition().z == Approx(1.0f));
+
+            root.SetScale({2.0f, 2.0f, 2.0f});
+            if (update) system.Update();
+            REQUIRE(leaf.GetWorldPosition().z == Approx(2.0f));
+
+            root.Rotate(TLETC::Vec3(0.0f, 1.0f, 0.0f), 90.0f);
+            if (update) system.Update();
+            REQUIRE(leaf.GetWorldPosition().x == Approx(2.0f));
+            REQUIRE(leaf.GetWorldPosition().z == Approx(0.0f).margin(0.001f));
+
+            root.SetRotation(TLETC::Quat(1.0f, 0.0f, 0.0f, 0.0f));
+            root.Translate({0.0f, 3.0f, 0.0f});
+            if (update) system.Update();
+            REQUIRE(leaf.GetWorldPosition().y == Approx(3.0f));
+
+            leaf.SetParent(nullptr);
+            if (update) system.Update();
+            REQUIRE(leaf.GetWorldPosition().y == Approx(0.0f));
+            REQUIRE(leaf.GetParent() == nullptr);
+        }
+    }
+
+    SECTION("Cycles are refused") {
+        REQUIRE_FALSE(root.SetParent(&leaf));
+        REQUIRE_FALSE(root.SetParent(&root));
+        REQUIRE(root.GetParent() == nullptr);
+
+        TLETC::TransformSystem other;
+        TLETC::Transform elsewhere(other);
+        REQUIRE_FALSE(elsewhere.SetParent(&root));
+    }
+
+    SECTION("Destroyed parents leave their children as roots") {
+        TLETC::Transform child(system);
+        {
+            TLETC::Transform temporary(system);
+            temporary.SetPosition({4.0f, 0.0f, 0.0f});
+            child.SetParent(&temporary);
+            system.Update();
+            REQUIRE(child.GetWorldPosition().x == Approx(4.0f));
+        }
+        REQUIRE(child.GetParent() == nullptr);
+        REQUIRE(child.GetWorldPosition().x == Approx(0.0f));
+        system.Update();
+        REQUIRE(child.GetWorldPosition().x == Approx(0.0f));
+    }
+
+    SECTION("Copies and moves keep the hierarchy linked") {
+        std::vector<TLETC::Transform> children(3, TLETC::Transform(system));
+        for (auto& child : children)
+            child.SetParent(&leaf);
+        children.reserve(64);  // Moves every element
+        for (const auto& child : children)
+            REQUIRE(child.GetParent() == &leaf);
+
+        TLETC::Transform moved(std::move(middle));
+        REQUIRE(leaf.GetParent() == &moved);
+
+        TLETC::Transform copy(leaf);
+        REQUIRE(copy.GetParent() == &moved);
+        REQUIRE(copy.GetPosition().z == 1.0f);
+
+        moved.SetPosition({0.0f, 7.0f, 0.0f});
+        REQUIRE(children[0].GetWorldPosition().y == Approx(7.0f));
+        REQUIRE(system.GetCount() == 7);
+    }
+}
@@ -0,0 +1,233 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+#include "TLETC/Scene/TransformSystem.h"
+#include "TLETC/Core/JobSystem.h"
+
+#include <random>
+#include <vector>
+
+using namespace TLETC;
+using Catch::Approx;
+
+// Reference: the chain of local matrices multiplied out, glm all the way
+static Mat4 NaiveWorld(const TransformSystem& system, uint32 id) {
+    const Mat4 local = glm::translate(Mat4(1.0f), system.GetPosition(id))
+                     * glm::mat4_cast(system.GetRotation(id))
+                     * glm::scale(Mat4(1.0f), system.GetScale(id));
+    const uint32 parent = system.GetParent(id);
+    return parent == TransformSystem::NoNode ? local : NaiveWorld(system, parent) * local;
+}
+
+static bool Matches(const Mat4& a, const Mat4& b) {
+    for (int c = 0; c < 4; ++c)
+        for (int r = 0; r < 4; ++r)
+            if (a[c][r] != Approx(b[c][r]).margin(1e-3f))
+                return false;
+    return true;
+}
+
+TEST_CASE("TransformSystem local matrices", "[scene][transformsystem]") {
+    const Vec3 position(1.0f, -2.0f, 3.0f);
+    const Quat rotation = normalize(Quat(0.8f, 0.1f, -0.4f, 0.3f));
+    const Vec3 scale(0.5f, 2.0f, 1.5f);
+
+    const Mat4 expected = glm::translate(Mat4(1.0f), position) * glm::mat4_cast(rotation) * glm::scale(Mat4(1.0f), scale);
+    REQUIRE(Matches(TransformSystem::ComposeMatrix(position, rotation, scale), expected));
+}
+
+TEST_CASE("TransformSystem sweep", "[scene][transformsystem]") {
+    TransformSystem system;
+    std::mt19937 rng(17);
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+
+    // Parents are picked among existing nodes, so a good share lands deep in the tree
+    std::vector<uint32> ids;
+    for (int i = 0; i < 2000; ++i) {
+        const uint32 id = system.Create();
+        system.SetPosition(id, Vec3(unit(rng), unit(rng), unit(rng)) * 2.0f);
+        system.SetRotation(id, normalize(Quat(unit(rng), unit(rng), unit(rng), unit(rng) + 2.0f)));
+        system.SetScale(id, Vec3(1.0f + unit(rng) * 0.2f));
+        if (!ids.empty() && i % 10 != 0)
+            system.SetParent(id, ids[rng() % ids.size()]);
+        ids.push_back(id);
+    }
+
+    auto requireAllMatch = [&]() {
+        for (uint32 id : ids)
+            if (system.IsValid(id))
+                REQUIRE(Matches(system.GetWorldMatrix(id), NaiveWorld(system, id)));
+    };
+
+    SECTION("Every world matrix matches the chain multiplied out") {
+        system.Update();
+        REQUIRE(system.GetDepthCount() > 5);
+        for (uint32 id : ids)
+            REQUIRE_FALSE(system.IsDirty(id));
+        requireAllMatch();
+    }
+
+    SECTION("Reads before the update are current too") {
+        requireAllMatch();
+        system.Update();
+        system.SetPosition(ids[0], Vec3(5.0f, 0.0f, 0.0f));
+        requireAllMatch();
+    }
+
+    SECTION("Only changed nodes and their subtrees are flagged") {
+        system.Update();
+        system.SetScale(ids[1], Vec3(3.0f));
+        size_t dirty = 0;
+        for (uint32 id : ids) {
+            bool inSubtree = false;
+            for (uint32 node = id; node != TransformSystem::NoNode; node = system.GetParent(node))
+                inSubtree |= node == ids[1];
+            REQUIRE(system.IsDirty(id) == inSubtree);
+            dirty += inSubtree;
+        }
+        REQUIRE(dirty < ids.size());
+        system.Update();
+        requireAllMatch();
+    }
+
+    SECTION("Reads recompute a node once per change above it") {
+        system.Update();
+        uint32 child = TransformSystem::NoNode;
+        for (uint32 id : ids)
+            if (system.GetParent(id) != TransformSystem::NoNode && system.GetParent(system.GetParent(id)) != TransformSystem::NoNode)
+                child = id;
+        REQUIRE(child != TransformSystem::NoNode);
+        const uint32 parent      = system.GetParent(child);
+        const uint32 grandparent = system.GetParent(parent);
+        const uint32 childVersion  = system.GetVersion(child);
+        const uint32 parentVersion = system.GetVersion(parent);
+
+        system.SetPosition(grandparent, Vec3(4.0f, 0.0f, 0.0f));
+        REQUIRE(system.IsDirty(child));
+        REQUIRE(Matches(system.GetWorldMatrix(child), NaiveWorld(system, child)));
+        REQUIRE(system.GetVersion(child) == childVersion + 1);
+        REQUIRE(system.GetVersion(parent) == parentVersion + 1);
+        REQUIRE_FALSE(system.IsDirty(child));
+
+        // Nothing changed since, the chain is left alone
+        system.GetWorldMatrix(child);
+        system.GetWorldMatrix(parent);
+        REQUIRE(system.GetVersion(child) == childVersion + 1);
+        REQUIRE(system.GetVersion(parent) == parentVersion + 1);
+
+        // Nor does the update redo what the read already did, the rest of the subtree it does
+        system.Update();
+        REQUIRE(system.GetVersion(child) == childVersion + 1);
+        requireAllMatch();
+    }
+
+    SECTION("Reparenting and destroying keep ids and results straight") {
+        system.Update();
+        for (int i = 0; i < 300; ++i) {
+            const uint32 id     = ids[rng() % ids.size()];
+            const uint32 parent = ids[rng() % ids.size()];
+            if (system.IsValid(id) && system.IsValid(parent))
+                system.SetParent(id, parent);  // Refused when it would make a cycle
+        }
+        for (int i = 0; i < 200; ++i)
+            system.Destroy(ids[rng() % ids.size()]);
+
+        requireAllMatch();
+        system.Update();
+        requireAllMatch();
+
+        size_t live = 0;
+        for (uint32 id : ids)
+            live += system.IsValid(id);
+        REQUIRE(system.GetCount() == live);
+
+        // Freed ids come back as fresh roots
+        const uint32 id = system.Create();
+        REQUIRE(system.GetParent(id) == TransformSystem::NoNode);
+        REQUIRE(Matches(system.GetWorldMatrix(id), Mat4(1.0f)));
+    }
+}
+
+TEST_CASE("TransformSystem threaded sweep", "[scene][transformsystem]") {
+    // Same hierarchy twice, swept on one thread and on several
+    TransformSystem serial, threaded;
+    std::mt19937 rng(23);
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+    std::vector<uint32> ids;
+    for (int i = 0; i < 40000; ++i) {
+        const Vec3 position(unit(rng), unit(rng), unit(rng));
+        const Quat rotation = normalize(Quat(unit(rng) + 2.0f, unit(rng), unit(rng), unit(rng)));
+        const uint32 parent = ids.empty() || i % 50 == 0 ? TransformSystem::NoNode : ids[ids.size() - 1 - rng() % std::min<size_t>(ids.size(), 200)];
+        for (TransformSystem* system : { &serial, &threaded }) {
+            const uint32 id = system->Create();
+            system->SetPosition(id, position);
+            system->SetRotation(id, rotation);
+            system->SetParent(id, parent);
+        }
+        ids.push_back(static_cast<uint32>(i));
+    }
+
+    auto requireIdentical = [&]() {
+        size_t mismatches = 0;
+        for (uint32 id : ids)
+            mismatches += serial.GetWorldMatrix(id) != threaded.GetWorldMatrix(id);
+        REQUIRE(mismatches == 0);
+    };
+
+    JobSystem jobs;
+    jobs.Initialize(3);
+
+    serial.Update();
+    threaded.Update(&jobs);
+    REQUIRE(threaded.GetDepthCount() > 10);
+    requireIdentical();
+
+    for (int i = 0; i < 500; ++i) {
+        const uint32 id = ids[rng() % ids.size()];
+        const Vec3 position(unit(rng), unit(rng), unit(rng));
+        serial.SetPosition(id, position);
+        threaded.SetPosition(id, position);
+    }
+    serial.Update();
+    threaded.Update(&jobs);
+    requireIdentical();
+
+    // New roots and destroyed leaves go in and out without re-sorting, the sweep takes them as they are
+    std::vector<uint8> hasChildren(ids.size(), 0);
+    for (uint32 id : ids)
+        if (serial.GetParent(id) != TransformSystem::NoNode)
+            hasChildren[serial.GetParent(id)] = 1;
+    for (int i = 0; i < 5000; ++i) {
+        const Vec3 position(unit(rng), unit(rng), unit(rng));
+        for (TransformSystem* system : { &serial, &threaded })
+            system->SetPosition(system->Create(), position);
+        ids.push_back(static_cast<uint32>(ids.size()));
+        hasChildren.push_back(0);
+    }
+    for (int i = 0; i < 3000; ++i) {
+        const uint32 id = ids[rng() % ids.size()];
+        if (hasChildren[id] || !serial.IsValid(id))
+            continue;
+        serial.Destroy(id);
+        threaded.Destroy(id);
+    }
+    for (int i = 0; i < 500; ++i) {
+        const uint32 id = ids[rng() % ids.size()];
+        if (!serial.IsValid(id))
+            continue;
+        serial.SetPosition(id, Vec3(unit(rng), unit(rng), unit(rng)));
+        threaded.SetPosition(id, serial.GetPosition(id));
+    }
+    serial.Update();
+    threaded.Update(&jobs);
+
+    size_t mismatches = 0, wrong = 0;
+    for (uint32 id : ids) {
+        if (!serial.IsValid(id))
+            continue;
+        mismatches += serial.GetWorldMatrix(id) != threaded.GetWorldMatrix(id);
+        wrong      += !Matches(threaded.GetWorldMatrix(id), NaiveWorld(threaded, id));
+    }
+    REQUIRE(mismatches == 0);
+    REQUIRE(wrong == 0);
+    REQUIRE(threaded.GetCount() == serial.GetCount());
+}
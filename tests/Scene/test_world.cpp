@@ -0,0 +1,188 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+#include "TLETC/Scene/World.h"
+#include "TLETC/Scene/Components.h"
+#include "TLETC/Scene/Transform.h"
+
+#include <atomic>
+#include <string>
+#include <vector>
+
+using namespace TLETC;
+using Catch::Approx;
+
+struct Health {
+    int value = 100;
+};
+
+// Counts live instances, to catch components that are leaked or destroyed twice
+struct Tracked {
+    static inline int alive = 0;
+    std::string name;
+
+    explicit Tracked(std::string n = "") : name(std::move(n)) { ++alive; }
+    Tracked(const Tracked& other) : name(other.name) { ++alive; }
+    Tracked(Tracked&& other) noexcept : name(std::move(other.name)) { ++alive; }
+    Tracked& operator=(const Tracked&) = default;
+    Tracked& operator=(Tracked&&) noexcept = default;
+    ~Tracked() { --alive; }
+};
+
+TEST_CASE("World entity lifetime", "[scene][world]") {
+    World world;
+
+    SECTION("Destroyed ids stay dead when their slot is reused") {
+        const EntityID first = world.Create();
+        REQUIRE(world.IsAlive(first));
+        world.Destroy(first);
+        REQUIRE_FALSE(world.IsAlive(first));
+
+        const EntityID second = world.Create();
+        REQUIRE(second.index == first.index);
+        REQUIRE(second.generation != first.generation);
+        REQUIRE(world.IsAlive(second));
+        REQUIRE_FALSE(world.IsAlive(first));
+        REQUIRE(world.GetCount() == 1);
+
+        world.Destroy(first);  // Stale, no-op
+        REQUIRE(world.IsAlive(second));
+        REQUIRE_FALSE(world.IsAlive(EntityID()));
+    }
+
+    SECTION("Components of dead entities are out of reach") {
+        const EntityID entity = world.Create(Health{ 5 });
+        world.Destroy(entity);
+        REQUIRE(world.Get<Health>(entity) == nullptr);
+        REQUIRE(world.Add<Health>(entity) == nullptr);
+        REQUIRE_FALSE(world.Remove<Health>(entity));
+    }
+
+    SECTION("Component destructors run exactly once") {
+        {
+            World scoped;
+            std::vector<EntityID> ids;
+            for (int i = 0; i < 1000; ++i)
+                ids.push_back(scoped.Create(Tracked("entity " + std::to_string(i)), Health{ i }));
+            REQUIRE(Tracked::alive == 1000);
+
+            for (int i = 0; i < 1000; i += 3)
+                scoped.Destroy(ids[i]);
+            for (int i = 1; i < 1000; i += 3)
+                scoped.Remove<Tracked>(ids[i]);
+            REQUIRE(Tracked::alive == 333);
+
+            for (int i = 2; i < 1000; i += 3)
+                REQUIRE(scoped.Get<Tracked>(ids[i])->name == "entity " + std::to_string(i));
+        }
+        REQUIRE(Tracked::alive == 0);
+    }
+}
+
+TEST_CASE("World components move between archetypes", "[scene][world]") {
+    World world;
+    const EntityID a = world.Create(Health{ 1 });
+    const EntityID b = world.Create(Health{ 2 }, Velocity{ Vec3(1, 0, 0) });
+    const EntityID c = world.Create(Health{ 3 });
+
+    REQUIRE(world.Has<Health>(b));
+    REQUIRE(world.Has<Velocity>(b));
+    REQUIRE_FALSE(world.Has<Velocity>(a));
+
+    // a gains a velocity, c fills the hole it left
+    REQUIRE(world.Add<Velocity>(a, Vec3(0, 2, 0))->linear.y == 2.0f);
+    REQUIRE(world.Get<Health>(a)->value == 1);
+    REQUIRE(world.Get<Health>(c)->value == 3);
+    REQUIRE(world.Count<Health, Velocity>() == 2);
+
+    // Adding again replaces
+    world.Add<Velocity>(a, Vec3(0, 3, 0));
+    REQUIRE(world.Get<Velocity>(a)->linear.y == 3.0f);
+    REQUIRE(world.Count<Velocity>() == 2);
+
+    REQUIRE(world.Remove<Velocity>(b));
+    REQUIRE_FALSE(world.Remove<Velocity>(b));
+    REQUIRE(world.Get<Health>(b)->value == 2);
+    REQUIRE(world.Count<Health>() == 3);
+    REQUIRE(world.Count<Velocity>() == 1);
+
+    // Each visits exactly the entities that have every type asked for
+    int health = 0, withVelocity = 0;
+    world.Each<Health>([&](Health& h) { health += h.value; });
+    world.Each<Health, Velocity>([&](EntityID id, Health&, Velocity&) { withVelocity += id == a; });
+    REQUIRE(health == 6);
+    REQUIRE(withVelocity == 1);
+}
+
+TEST_CASE("World iteration spans many chunks", "[scene][world]") {
+    World world;
+    constexpr int Count = 50000;
+    std::vector<EntityID> ids;
+    for (int i = 0; i < Count; ++i)
+        ids.push_back(i % 2 ? world.Create(Health{ i }, Velocity{ Vec3(1, 0, 0) }) : world.Create(Health{ i }));
+    for (int i = 0; i < Count; i += 10)
+        world.Destroy(ids[i]);
+
+    REQUIRE(world.GetChunkCount() > 10);
+    REQUIRE(world.Count<Health>() == Count - Count / 10);
+
+    SECTION("Every surviving entity keeps its own values") {
+        size_t wrong = 0;
+        for (int i = 0; i < Count; ++i) {
+            const Health* h = world.Get<Health>(ids[i]);
+            wrong += i % 10 == 0 ? h != nullptr : h == nullptr || h->value != i;
+        }
+        REQUIRE(wrong == 0);
+    }
+
+    SECTION("ParallelEach sees what Each sees") {
+        JobSystem jobs;
+        jobs.Initialize(3);
+        world.ParallelEach<Health, Velocity>(&jobs, [](Health& h, const Velocity& v) { h.value += static_cast<int>(v.linear.x) * 1000000; });
+
+        std::atomic<size_t> visited(0);
+        world.ParallelEach<const Health>(&jobs, [&](EntityID, const Health&) { visited.fetch_add(1, std::memory_order_relaxed); });
+        REQUIRE(visited.load() == world.Count<Health>());
+
+        size_t wrong = 0;
+        world.Each<Health>([&](EntityID id, Health& h) {
+            const bool moving = world.Has<Velocity>(id);
+            wrong += (h.value >= 1000000) != moving;
+        });
+        REQUIRE(wrong == 0);
+    }
+
+    SECTION("Clear empties every archetype") {
+        world.Clear();
+        REQUIRE(world.GetCount() == 0);
+        REQUIRE(world.GetChunkCount() == 0);
+        REQUIRE_FALSE(world.IsAlive(ids[1]));
+    }
+}
+
+TEST_CASE("Transform as a World component", "[scene][world]") {
+    TransformSystem system;
+    World world;
+
+    const EntityID parent = world.Create(Transform(system));
+    const EntityID child  = world.Create(Transform(system), MeshRef{});
+    world.Get<Transform>(parent)->SetPosition(Vec3(1, 0, 0));
+    REQUIRE(world.Get<Transform>(child)->SetParent(world.Get<Transform>(parent)));
+
+    // Moving chunks keeps the node and tells the system where its owner went
+    world.Add<Velocity>(parent, Vec3(0, 1, 0));
+    world.Create(Transform(system));
+    world.Remove<MeshRef>(child);
+
+    Transform* parentTransform = world.Get<Transform>(parent);
+    Transform* childTransform  = world.Get<Transform>(child);
+    REQUIRE(childTransform->GetParent() == parentTransform);
+    REQUIRE(system.GetCount() == 3);
+
+    world.Each<Transform, Velocity>([](Transform& t, Velocity& v) { t.Translate(v.linear); });
+    system.Update();
+    REQUIRE(childTransform->GetWorldPosition().x == Approx(1.0f));
+    REQUIRE(childTransform->GetWorldPosition().y == Approx(1.0f));
+
+    world.Destroy(parent);
+    REQUIRE(system.GetCount() == 2);
+}